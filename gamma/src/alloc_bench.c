@@ -0,0 +1,152 @@
+/** @file
+ * Pomiar kosztu tworzenia i usuwania gier przy różnych alokatorach.
+ *
+ * Program rozgrywa wiele krótkich gier, każdą w nowej strukturze gry,
+ * najpierw alokując pamięć funkcjami biblioteki standardowej, a potem
+ * z areny czyszczonej po każdej grze. Każda gra dostaje ten sam,
+ * deterministyczny ciąg ruchów, więc oba pomiary wykonują tę samą pracę,
+ * co potwierdza suma kontrolna wyników ruchów.
+ *
+ * Wywołanie: @p gamma_alloc_bench [@p games [@p width @p height
+ * [@p moves]]].
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#define _GNU_SOURCE ///< Makro potrzebne do prawidłowej kompilacji.
+
+#include "arena.h"
+#include "gamma.h"
+#include "int_to_string_util.h"
+#include "memory_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define DEFAULT_GAMES 20000 ///< Domyślna liczba gier.
+#define DEFAULT_SIZE 100 ///< Domyślny wymiar planszy.
+#define DEFAULT_MOVES 200 ///< Domyślna liczba ruchów w grze.
+#define PLAYERS 4 ///< Liczba graczy w grze.
+#define AREAS 8 ///< Maksymalna liczba obszarów gracza.
+#define BLOCK_SIZE (1 << 20) ///< Początkowy rozmiar bloku areny.
+#define SEED 2020 ///< Ziarno generatora ruchów.
+
+/**
+ * @brief Generator liczb pseudolosowych (xorshift64).
+ * @param[in,out] state – stan generatora, różny od @p 0.
+ * @return Kolejna liczba pseudolosowa.
+ */
+static uint64_t next_random(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *state = x;
+}
+
+/**
+ * @brief Zwraca bieżący czas w nanosekundach.
+ * @return Czas zegara monotonicznego w nanosekundach.
+ */
+static uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/**
+ * @brief Rozgrywa kolejne gry i mierzy ich łączny czas.
+ * Co dwudziesty ruch jest złotym ruchem.
+ * @param[in] games     – liczba gier,
+ * @param[in] width     – szerokość planszy,
+ * @param[in] height    – wysokość planszy,
+ * @param[in] moves     – liczba ruchów w grze,
+ * @param[in] a         – arena, z której alokowane są gry, lub @p NULL,
+ * @param[out] checksum – wskaźnik, pod który zostanie zapisana liczba
+ *                        udanych ruchów.
+ * @return Czas w nanosekundach lub @p 0, jeśli nie udało się utworzyć gry.
+ */
+static uint64_t run(uint64_t games, uint32_t width, uint32_t height,
+                    uint64_t moves, arena_t *a, uint64_t *checksum) {
+    const gamma_allocator_t *allocator = a != NULL ? arena_allocator(a) : NULL;
+    uint64_t ok = 0;
+    uint64_t start = now_ns();
+    for (uint64_t i = 0; i < games; i++) {
+        gamma_t *g = gamma_new_with_allocator(width, height, PLAYERS, AREAS,
+                                              allocator);
+        if (g == NULL)
+            return 0;
+        uint64_t state = SEED;
+        for (uint64_t m = 0; m < moves; m++) {
+            uint64_t r = next_random(&state);
+            uint32_t player = r % PLAYERS + 1;
+            uint32_t x = (r >> 8) % width, y = (r >> 40) % height;
+            if ((r >> 4) % 20 == 0)
+                ok += gamma_golden_move(g, player, x, y);
+            else
+                ok += gamma_move(g, player, x, y);
+        }
+        gamma_delete(g);
+        if (a != NULL)
+            arena_clear(a);
+    }
+    *checksum = ok;
+    return now_ns() - start;
+}
+
+/**
+ * @brief Wypisuje wynik pomiaru.
+ * @param[in] name     – nazwa alokatora,
+ * @param[in] ns       – czas w nanosekundach,
+ * @param[in] games    – liczba gier,
+ * @param[in] allocs   – liczba alokacji w czasie pomiaru,
+ * @param[in] checksum – liczba udanych ruchów.
+ */
+static void report(const char *name, uint64_t ns, uint64_t games,
+                   uint64_t allocs, uint64_t checksum) {
+    printf("%-8s %10.1f ns/game %10.1f allocs/game checksum %lu\n", name,
+           (double) ns / games, (double) allocs / games,
+           (unsigned long) checksum);
+}
+
+int main(int argc, char *argv[]) {
+    uint64_t games = DEFAULT_GAMES, width = DEFAULT_SIZE, height = DEFAULT_SIZE;
+    uint64_t moves = DEFAULT_MOVES;
+    bool ok = argc != 3 && argc <= 5;
+    if (ok && argc > 1)
+        ok = parse_number(argv[1], UINT64_MAX, &games);
+    if (ok && argc > 3)
+        ok = parse_number(argv[2], UINT32_MAX, &width)
+             && parse_number(argv[3], UINT32_MAX, &height);
+    if (ok && argc > 4)
+        ok = parse_number(argv[4], UINT64_MAX, &moves);
+    if (!ok || games == 0 || width == 0 || height == 0) {
+        fprintf(stderr, "usage: %s [games [width height [moves]]]\n", argv[0]);
+        return 1;
+    }
+
+    arena_t *a = arena_new(BLOCK_SIZE);
+    if (a == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    for (int with_arena = 0; with_arena <= 1; with_arena++) {
+        mem_stats_t before, after;
+        uint64_t checksum = 0;
+        mem_get_stats(&before);
+        uint64_t ns = run(games, width, height, moves,
+                          with_arena ? a : NULL, &checksum);
+        mem_get_stats(&after);
+        if (ns == 0) {
+            fprintf(stderr, "out of memory\n");
+            arena_delete(a);
+            return 1;
+        }
+        report(with_arena ? "arena" : "malloc", ns, games,
+               after.allocs - before.allocs, checksum);
+    }
+    arena_delete(a);
+    return 0;
+}
@@ -0,0 +1,205 @@
+/** @file
+ * Zawiera implementację interfejsu arena.h
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#include "arena.h"
+#include <stdalign.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ALIGNMENT alignof(max_align_t) ///< Wyrównanie przydzielanej pamięci.
+
+/**
+ * @brief Struktura przechowująca nagłówek bloku areny.
+ * Dane bloku zaczynają się @ref header_size bajtów za jego początkiem.
+ */
+typedef struct block {
+    struct block *prev; ///< Poprzednio zaalokowany blok lub @p NULL.
+    size_t size;        ///< Liczba bajtów danych bloku.
+    size_t used;        ///< Liczba przydzielonych bajtów danych bloku.
+} block_t;
+
+/**
+ * @brief Struktura przechowująca arenę.
+ */
+struct arena {
+    gamma_allocator_t allocator; ///< Alokator korzystający z areny.
+    block_t *current;  ///< Blok, z którego przydzielana jest pamięć, lub @p NULL.
+    size_t block_size; ///< Rozmiar nowych bloków.
+};
+
+/**
+ * @brief Zaokrągla liczbę bajtów w górę do wielokrotności wyrównania.
+ * @param[in] size – liczba bajtów.
+ * @return Zaokrąglona liczba bajtów lub @p 0, jeśli zaokrąglenie się nie
+ * mieści w typie @p size_t.
+ */
+static size_t align_up(size_t size) {
+    if (size > SIZE_MAX - (ALIGNMENT - 1))
+        return 0;
+    return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+/**
+ * @brief Zwraca rozmiar nagłówka bloku wraz z wyrównaniem.
+ * @return Liczba bajtów od początku bloku do jego danych.
+ */
+static size_t header_size() {
+    return align_up(sizeof(block_t));
+}
+
+/**
+ * @brief Zwraca początek danych bloku.
+ * @param[in] b – wskaźnik na blok.
+ * @return Wskaźnik na pierwszy bajt danych bloku.
+ */
+static unsigned char *block_data(block_t *b) {
+    return (unsigned char *) b + header_size();
+}
+
+/**
+ * @brief Sprawdza, czy fragment jest ostatnim przydzielonym fragmentem
+ * bieżącego bloku.
+ * @param[in] a    – wskaźnik na arenę,
+ * @param[in] ptr  – początek fragmentu,
+ * @param[in] size – wyrównany rozmiar fragmentu.
+ * @return Wartość @p true, jeśli fragment kończy się tam, gdzie kończy się
+ * przydzielona część bieżącego bloku, @p false w przeciwnym przypadku.
+ */
+static bool is_last(const arena_t *a, const void *ptr, size_t size) {
+    block_t *b = a->current;
+    return b != NULL && size <= b->used
+           && (const unsigned char *) ptr == block_data(b) + b->used - size;
+}
+
+/**
+ * @brief Przydziela pamięć z areny.
+ * @param[in,out] ctx – wskaźnik na arenę,
+ * @param[in] size    – liczba bajtów.
+ * @return Wskaźnik na pamięć lub @p NULL, jeśli się nie udało.
+ */
+static void *arena_alloc(void *ctx, size_t size) {
+    arena_t *a = ctx;
+    size_t aligned = align_up(size);
+    if (aligned == 0 && size != 0)
+        return NULL;
+    block_t *b = a->current;
+    if (b == NULL || b->size - b->used < aligned) {
+        size_t data = aligned > a->block_size ? aligned : a->block_size;
+        if (data > SIZE_MAX - header_size())
+            return NULL;
+        block_t *fresh = malloc(header_size() + data);
+        if (fresh == NULL)
+            return NULL;
+        fresh->prev = b;
+        fresh->size = data;
+        fresh->used = 0;
+        a->current = b = fresh;
+    }
+    void *ptr = block_data(b) + b->used;
+    b->used += aligned;
+    return ptr;
+}
+
+/**
+ * @brief Zwalnia pamięć przydzieloną z areny.
+ * Pamięć jest odzyskiwana tylko wtedy, gdy to ostatnio przydzielony
+ * fragment; pozostała wraca dopiero po @ref arena_clear.
+ * @param[in,out] ctx – wskaźnik na arenę,
+ * @param[in] ptr     – wskaźnik na pamięć,
+ * @param[in] size    – rozmiar pamięci w bajtach.
+ */
+static void arena_free(void *ctx, void *ptr, size_t size) {
+    arena_t *a = ctx;
+    size_t aligned = align_up(size);
+    if (is_last(a, ptr, aligned))
+        a->current->used -= aligned;
+}
+
+/**
+ * @brief Zmienia rozmiar pamięci przydzielonej z areny.
+ * Ostatnio przydzielony fragment jest powiększany w miejscu, jeśli mieści
+ * się w bloku; w przeciwnym przypadku zawartość jest kopiowana do nowego
+ * fragmentu.
+ * @param[in,out] ctx  – wskaźnik na arenę,
+ * @param[in] ptr      – wskaźnik na pamięć,
+ * @param[in] old_size – dotychczasowy rozmiar w bajtach,
+ * @param[in] new_size – nowy rozmiar w bajtach.
+ * @return Wskaźnik na pamięć lub @p NULL, jeśli się nie udało.
+ */
+static void *arena_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    arena_t *a = ctx;
+    size_t old_aligned = align_up(old_size), new_aligned = align_up(new_size);
+    if (new_aligned == 0 && new_size != 0)
+        return NULL;
+    if (is_last(a, ptr, old_aligned)) {
+        block_t *b = a->current;
+        if (b->size - (b->used - old_aligned) >= new_aligned) {
+            b->used = b->used - old_aligned + new_aligned;
+            return ptr;
+        }
+    }
+    void *data = arena_alloc(ctx, new_size);
+    if (data == NULL)
+        return NULL;
+    memcpy(data, ptr, old_size < new_size ? old_size : new_size);
+    return data;
+}
+
+arena_t *arena_new(size_t block_size) {
+    arena_t *a = malloc(sizeof(arena_t));
+    if (a == NULL)
+        return NULL;
+    a->allocator.alloc = arena_alloc;
+    a->allocator.realloc = arena_realloc;
+    a->allocator.free = arena_free;
+    a->allocator.ctx = a;
+    a->current = NULL;
+    a->block_size = block_size;
+    return a;
+}
+
+/**
+ * @brief Zwalnia wszystkie bloki areny.
+ * @param[in,out] a – wskaźnik na arenę.
+ * @return Łączny rozmiar danych zwolnionych bloków.
+ */
+static size_t free_blocks(arena_t *a) {
+    size_t total = 0;
+    while (a->current != NULL) {
+        block_t *prev = a->current->prev;
+        total += a->current->size;
+        free(a->current);
+        a->current = prev;
+    }
+    return total;
+}
+
+void arena_delete(arena_t *a) {
+    if (a == NULL)
+        return;
+    free_blocks(a);
+    free(a);
+}
+
+void arena_clear(arena_t *a) {
+    if (a->current == NULL)
+        return;
+    if (a->current->prev == NULL) {
+        a->current->used = 0;
+        return;
+    }
+    size_t total = free_blocks(a);
+    if (total > a->block_size)
+        a->block_size = total;
+}
+
+const gamma_allocator_t *arena_allocator(arena_t *a) {
+    return &a->allocator;
+}
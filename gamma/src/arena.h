@@ -0,0 +1,60 @@
+/** @file
+ * Interfejs areny, czyli alokatora przydzielającego pamięć kolejnymi
+ * fragmentami dużych bloków.
+ *
+ * Alokacja przesuwa tylko wskaźnik w bieżącym bloku, a zwolnienie oddaje
+ * pamięć tylko wtedy, gdy dotyczy ostatnio przydzielonego fragmentu.
+ * Całą pamięć areny odzyskuje się naraz funkcją @ref arena_clear, np. po
+ * usunięciu wszystkich gier, które z niej korzystały. Arena nie jest
+ * bezpieczna wątkowo; każdy wątek powinien mieć własną.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#ifndef GAMMA_ARENA_H
+#define GAMMA_ARENA_H
+
+#include "gamma_allocator.h"
+#include <stddef.h>
+
+/**
+ * @brief Struktura przechowująca arenę.
+ */
+typedef struct arena arena_t;
+
+/**
+ * @brief Tworzy pustą arenę.
+ * @param[in] block_size – rozmiar bloków areny w bajtach; większe alokacje
+ *                         dostają własny blok.
+ * @return Wskaźnik na arenę lub @p NULL, jeśli nie udało się zaalokować
+ * pamięci.
+ */
+arena_t *arena_new(size_t block_size);
+
+/**
+ * @brief Usuwa arenę wraz z całą przydzieloną z niej pamięcią.
+ * Nic nie robi, jeśli @p a ma wartość @p NULL.
+ * @param[in,out] a – wskaźnik na arenę.
+ */
+void arena_delete(arena_t *a);
+
+/**
+ * @brief Odzyskuje całą pamięć przydzieloną z areny.
+ * Wcześniej przydzielone wskaźniki przestają być ważne. Jeśli arena
+ * potrzebowała więcej niż jednego bloku, bloki są zastępowane jednym
+ * blokiem o ich łącznym rozmiarze, tak aby ta sama liczba alokacji
+ * zmieściła się potem w jednym bloku.
+ * @param[in,out] a – wskaźnik na arenę.
+ */
+void arena_clear(arena_t *a);
+
+/**
+ * @brief Zwraca alokator przydzielający pamięć z areny.
+ * @param[in] a – wskaźnik na arenę.
+ * @return Wskaźnik na alokator, ważny do usunięcia areny.
+ */
+const gamma_allocator_t *arena_allocator(arena_t *a);
+
+#endif //GAMMA_ARENA_H
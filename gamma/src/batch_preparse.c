@@ -0,0 +1,270 @@
+/** @file
+ * Zawiera implementację interfejsu batch_preparse.h
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#define _GNU_SOURCE ///< Makro potrzebne do prawidłowej kompilacji.
+
+#include "batch_preparse.h"
+#include "trace.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define CHUNK_SIZE (1u << 20) ///< Nominalny rozmiar fragmentu pliku w bajtach.
+#define SLOTS_PER_THREAD 2 /**< Liczba fragmentów na wątek, które mogą
+                            * czekać na wykonanie.
+                            */
+#define DEFAULT_LINES 1024 ///< Początkowy rozmiar tablicy wierszy fragmentu.
+#define EXIT_CODE_MALLOC_FAIL 1 /**< Kod wyjściowy programu,
+                                 * gdy nie uda się zaalokować potrzebnej pamięci.
+                                 */
+
+/**
+ * @brief Miejsce na rozebrany fragment pliku.
+ * Fragment o numerze @p i trafia do miejsca o numerze @p i modulo liczba
+ * miejsc. Miejsce jest zwalniane, gdy wątek główny wykona fragment.
+ */
+typedef struct slot {
+    parsed_chunk_t chunk; ///< Rozebrany fragment.
+    uint64_t capacity;    ///< Rozmiar zaalokowanej tablicy @p chunk.lines.
+    uint64_t expected;    ///< Numer fragmentu, na który czeka to miejsce.
+    bool full;            ///< Równe @p true, jeśli fragment jest gotowy.
+} slot_t;
+
+/**
+ * @brief Struktura przechowująca stan równoległego rozbioru pliku.
+ */
+struct preparse {
+    const char *data;       ///< Początek zmapowanego pliku.
+    uint64_t size;          ///< Rozmiar zmapowanego pliku.
+    uint64_t offset;        ///< Początek rozbieranego obszaru.
+    uint64_t num_of_chunks; ///< Liczba fragmentów.
+    uint64_t next_to_parse; ///< Numer fragmentu, który rozbierze następny wątek.
+    uint64_t next_to_take;  ///< Numer fragmentu, który odbierze wątek główny.
+    bool taken;             /**< Równe @p true, jeśli wątek główny trzyma
+                             * fragment numer @p next_to_take @p - @p 1.
+                             */
+    bool stop;              ///< Równe @p true, jeśli wątki mają się zakończyć.
+    slot_t *slots;          ///< Tablica miejsc na fragmenty.
+    uint32_t num_of_slots;  ///< Długość tablicy @p slots.
+    pthread_t *threads;     ///< Tablica wątków rozbierających.
+    uint32_t num_of_threads; ///< Liczba uruchomionych wątków.
+    pthread_mutex_t lock;   ///< Chroni wszystkie pola poza @p data.
+    pthread_cond_t slot_free;   ///< Sygnalizuje zwolnienie miejsca.
+    pthread_cond_t chunk_ready; ///< Sygnalizuje rozebranie fragmentu.
+};
+
+/**
+ * @brief Znajduje początek pierwszego wiersza zaczynającego się nie wcześniej
+ * niż na pozycji @p pos.
+ * @param[in] p   – wskaźnik na strukturę przechowującą stan rozbioru,
+ * @param[in] pos – pozycja w pliku, niemniejsza niż @p p->offset.
+ * @return Pozycja początku wiersza lub rozmiar pliku, jeśli takiego
+ * wiersza nie ma.
+ */
+static uint64_t line_start_from(const preparse_t *p, uint64_t pos) {
+    if (pos <= p->offset)
+        return p->offset;
+    if (pos >= p->size)
+        return p->size;
+    if (p->data[pos - 1] == END_LINE)
+        return pos;
+    const char *nl = memchr(p->data + pos, END_LINE, p->size - pos);
+    if (nl == NULL)
+        return p->size;
+    return nl - p->data + 1;
+}
+
+/**
+ * @brief Dopisuje wiersz do fragmentu w miejscu @p s.
+ * Powiększa tablicę wierszy, jeśli jest zapełniona. Jeśli nie uda się
+ * zaalokować pamięci, kończy program z kodem @p 1.
+ * @param[in,out] s – miejsce, w którym zapisywany jest fragment,
+ * @param[in] line  – rozebrany wiersz.
+ */
+static void chunk_append(slot_t *s, const parsed_line_t *line) {
+    if (s->chunk.count == s->capacity) {
+        uint64_t capacity = s->capacity == 0 ? DEFAULT_LINES : 2 * s->capacity;
+        parsed_line_t *lines = realloc(s->chunk.lines, capacity * sizeof(parsed_line_t));
+        if (lines == NULL)
+            exit(EXIT_CODE_MALLOC_FAIL);
+        s->chunk.lines = lines;
+        s->capacity = capacity;
+    }
+    s->chunk.lines[s->chunk.count++] = *line;
+}
+
+/**
+ * @brief Rozbiera fragment pliku o numerze @p i do miejsca @p s.
+ * Fragment zawiera wszystkie wiersze, których pierwszy znak leży
+ * w przedziale [@p i * @ref CHUNK_SIZE, (@p i + 1) * @ref CHUNK_SIZE)
+ * liczonym od początku rozbieranego obszaru.
+ * @param[in] p     – wskaźnik na strukturę przechowującą stan rozbioru,
+ * @param[in] i     – numer fragmentu,
+ * @param[out] s    – miejsce, w którym zapisany zostanie fragment.
+ */
+static void parse_chunk(const preparse_t *p, uint64_t i, slot_t *s) {
+    uint64_t begin = line_start_from(p, p->offset + i * CHUNK_SIZE);
+    uint64_t end = line_start_from(p, p->offset + (i + 1) * CHUNK_SIZE);
+    s->chunk.count = 0;
+    s->chunk.line_count = 0;
+    while (begin < end) {
+        const char *line = p->data + begin;
+        const char *nl = memchr(line, END_LINE, p->size - begin);
+        uint64_t len = nl == NULL ? p->size - begin : (uint64_t) (nl - line) + 1;
+        parsed_line_t parsed;
+        parsed.status = command_parse_line(line, len, &parsed.cmd);
+        if (parsed.status != LINE_IGNORE) {
+            parsed.line = s->chunk.line_count;
+            chunk_append(s, &parsed);
+        }
+        s->chunk.line_count++;
+        begin += len;
+    }
+}
+
+/**
+ * @brief Funkcja wykonywana przez wątki rozbierające.
+ * Pobiera numery kolejnych nierozebranych fragmentów, czeka na zwolnienie
+ * odpowiadającego im miejsca i rozbiera je.
+ * @param[in,out] arg – wskaźnik na strukturę przechowującą stan rozbioru.
+ * @return Wartość @p NULL.
+ */
+static void *worker(void *arg) {
+    preparse_t *p = arg;
+    pthread_mutex_lock(&p->lock);
+    while (!p->stop && p->next_to_parse < p->num_of_chunks) {
+        uint64_t i = p->next_to_parse++;
+        slot_t *s = &p->slots[i % p->num_of_slots];
+        while (!p->stop && (s->full || s->expected != i))
+            pthread_cond_wait(&p->slot_free, &p->lock);
+        if (p->stop)
+            break;
+        pthread_mutex_unlock(&p->lock);
+        TRACE_BEGIN(span);
+        parse_chunk(p, i, s);
+        TRACE_END(span, "parse_chunk", i);
+        pthread_mutex_lock(&p->lock);
+        s->full = true;
+        pthread_cond_signal(&p->chunk_ready);
+    }
+    pthread_mutex_unlock(&p->lock);
+    return NULL;
+}
+
+/**
+ * @brief Zwraca liczbę dostępnych rdzeni.
+ * @return Liczba dostępnych rdzeni, niemniejsza niż @p 1.
+ */
+static uint32_t available_cores() {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores < 1 ? 1 : (uint32_t) cores;
+}
+
+/**
+ * @brief Zwalnia pamięć zaalokowaną dla struktury rozbioru.
+ * Nie czeka na wątki, zakłada, że żaden nie działa.
+ * @param[in,out] p – wskaźnik na strukturę przechowującą stan rozbioru.
+ */
+static void preparse_free(preparse_t *p) {
+    if (p->slots != NULL) {
+        for (uint32_t i = 0; i < p->num_of_slots; i++)
+            free(p->slots[i].chunk.lines);
+        free(p->slots);
+    }
+    free(p->threads);
+    if (p->data != NULL && p->size > 0)
+        munmap((void *) p->data, p->size);
+    pthread_mutex_destroy(&p->lock);
+    pthread_cond_destroy(&p->slot_free);
+    pthread_cond_destroy(&p->chunk_ready);
+    free(p);
+}
+
+preparse_t *preparse_start(int fd, uint64_t offset, uint32_t threads) {
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || (uint64_t) st.st_size < offset)
+        return NULL;
+    if (threads == 0)
+        threads = available_cores();
+
+    preparse_t *p = calloc(1, sizeof(preparse_t));
+    if (p == NULL)
+        return NULL;
+    pthread_mutex_init(&p->lock, NULL);
+    pthread_cond_init(&p->slot_free, NULL);
+    pthread_cond_init(&p->chunk_ready, NULL);
+    p->size = st.st_size;
+    p->offset = offset;
+    p->num_of_chunks = (p->size - offset + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    if (p->size > 0) {
+        void *data = mmap(NULL, p->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            preparse_free(p);
+            return NULL;
+        }
+        madvise(data, p->size, MADV_SEQUENTIAL);
+        p->data = data;
+    }
+    p->num_of_slots = threads * SLOTS_PER_THREAD;
+    p->slots = calloc(p->num_of_slots, sizeof(slot_t));
+    p->threads = calloc(threads, sizeof(pthread_t));
+    if (p->slots == NULL || p->threads == NULL) {
+        preparse_free(p);
+        return NULL;
+    }
+    for (uint32_t i = 0; i < p->num_of_slots; i++)
+        p->slots[i].expected = i;
+    for (uint32_t i = 0; i < threads; i++) {
+        if (pthread_create(&p->threads[i], NULL, worker, p) != 0)
+            break;
+        p->num_of_threads++;
+    }
+    if (p->num_of_threads == 0) {
+        preparse_free(p);
+        return NULL;
+    }
+    return p;
+}
+
+const parsed_chunk_t *preparse_next(preparse_t *p) {
+    pthread_mutex_lock(&p->lock);
+    if (p->taken) {
+        slot_t *prev = &p->slots[(p->next_to_take - 1) % p->num_of_slots];
+        prev->full = false;
+        prev->expected += p->num_of_slots;
+        p->taken = false;
+        pthread_cond_broadcast(&p->slot_free);
+    }
+    if (p->next_to_take == p->num_of_chunks) {
+        pthread_mutex_unlock(&p->lock);
+        return NULL;
+    }
+    slot_t *s = &p->slots[p->next_to_take % p->num_of_slots];
+    while (!s->full)
+        pthread_cond_wait(&p->chunk_ready, &p->lock);
+    p->next_to_take++;
+    p->taken = true;
+    pthread_mutex_unlock(&p->lock);
+    return &s->chunk;
+}
+
+void preparse_finish(preparse_t *p) {
+    if (p == NULL)
+        return;
+    pthread_mutex_lock(&p->lock);
+    p->stop = true;
+    pthread_cond_broadcast(&p->slot_free);
+    pthread_mutex_unlock(&p->lock);
+    for (uint32_t i = 0; i < p->num_of_threads; i++)
+        pthread_join(p->threads[i], NULL);
+    preparse_free(p);
+}
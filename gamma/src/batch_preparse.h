@@ -0,0 +1,83 @@
+/** @file
+ * Interfejs udostępniający równoległy rozbiór poleceń trybu wsadowego
+ * zapisanych w pliku.
+ * Plik dzielony jest na fragmenty wyrównane do granic wierszy. Fragmenty
+ * rozbierane są jednocześnie przez wiele wątków, a gotowe tablice poleceń
+ * oddawane są w kolejności występowania w pliku, tak by mogły zostać
+ * wykonane przez jeden wątek silnika gry.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#ifndef GAMMA_BATCH_PREPARSE_H
+#define GAMMA_BATCH_PREPARSE_H
+
+#include <stdint.h>
+#include "command.h"
+
+/**
+ * @brief Rozebrany wiersz wejścia, który nie został zignorowany.
+ */
+typedef struct parsed_line {
+    uint64_t line;        /**< Numer wiersza liczony od początku fragmentu
+                           * (pierwszy wiersz fragmentu ma numer @p 0).
+                           */
+    line_status_t status; ///< Wynik rozbioru: @ref LINE_OK lub @ref LINE_ERROR.
+    command_t cmd;        ///< Polecenie, jeśli @p status jest równy @ref LINE_OK.
+} parsed_line_t;
+
+/**
+ * @brief Rozebrany fragment pliku.
+ */
+typedef struct parsed_chunk {
+    parsed_line_t *lines; ///< Tablica nieignorowanych wierszy fragmentu.
+    uint64_t count;       ///< Długość tablicy @p lines.
+    uint64_t line_count;  /**< Liczba wszystkich wierszy fragmentu, łącznie
+                           * z zignorowanymi.
+                           */
+} parsed_chunk_t;
+
+/**
+ * @brief Struktura przechowująca stan równoległego rozbioru pliku.
+ */
+typedef struct preparse preparse_t;
+
+/**
+ * @brief Rozpoczyna równoległy rozbiór pliku.
+ * Mapuje do pamięci plik o deskryptorze @p fd i uruchamia @p threads wątków
+ * rozbierających jego zawartość od bajtu numer @p offset do końca pliku.
+ * @param[in] fd      – deskryptor zwykłego pliku otwartego do odczytu,
+ * @param[in] offset  – numer bajtu, od którego zaczyna się pierwszy
+ *                      rozbierany wiersz,
+ * @param[in] threads – liczba wątków rozbierających; wartość @p 0 oznacza
+ *                      tyle wątków, ile jest dostępnych rdzeni.
+ * @return Wskaźnik na strukturę przechowującą stan rozbioru lub @p NULL,
+ * jeśli deskryptor nie wskazuje na zwykły plik lub nie udało się zaalokować
+ * zasobów. W tym drugim przypadku wejście nie zostało zmienione i można je
+ * wczytać zwykłym, sekwencyjnym sposobem.
+ */
+preparse_t *preparse_start(int fd, uint64_t offset, uint32_t threads);
+
+/**
+ * @brief Zwraca kolejny rozebrany fragment pliku.
+ * Zwalnia fragment zwrócony przez poprzednie wywołanie funkcji i czeka, aż
+ * następny fragment zostanie rozebrany. Fragmenty zwracane są w kolejności
+ * ich występowania w pliku.
+ * @param[in,out] p – wskaźnik na strukturę przechowującą stan rozbioru,
+ *                    różny od @p NULL.
+ * @return Wskaźnik na rozebrany fragment, ważny do następnego wywołania
+ * funkcji, lub @p NULL, jeśli cały plik został już przetworzony.
+ */
+const parsed_chunk_t *preparse_next(preparse_t *p);
+
+/**
+ * @brief Kończy rozbiór i zwalnia zajmowane przez niego zasoby.
+ * Czeka na zakończenie wszystkich wątków rozbierających.
+ * Nic nie robi, jeśli @p p jest równe @p NULL.
+ * @param[in,out] p – wskaźnik na strukturę przechowującą stan rozbioru.
+ */
+void preparse_finish(preparse_t *p);
+
+#endif //GAMMA_BATCH_PREPARSE_H
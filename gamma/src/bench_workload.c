@@ -0,0 +1,343 @@
+/** @file
+ * Zawiera implementację interfejsu bench_workload.h
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#include "bench_workload.h"
+#include <stdlib.h>
+
+#define INITIAL_CAPACITY 1024 ///< Początkowy rozmiar tablicy wywołań.
+
+/**
+ * @brief Typ funkcji generującej obciążenie.
+ * Funkcja ustawia parametry gry w @p w i dodaje kolejne wywołania.
+ * @param[in,out] w     – obciążenie z pustą tablicą wywołań,
+ * @param[in,out] state – stan generatora liczb pseudolosowych,
+ * @param[in] scale     – dzielnik wymiarów planszy i liczby wywołań.
+ * @return Wartość @p false, jeśli nie udało się zaalokować pamięci.
+ */
+typedef bool (*generator_t)(workload_t *w, uint64_t *state, uint32_t scale);
+
+/**
+ * @brief Nazwy funkcji z gamma.h w kolejności z @ref bench_fn_t.
+ */
+static const char *const fn_names[BENCH_FN_COUNT] = {
+    "gamma_new", "gamma_delete", "gamma_copy", "gamma_move",
+    "gamma_golden_move", "gamma_busy_fields", "gamma_free_fields",
+    "gamma_golden_possible", "gamma_board", "gamma_board_interactive",
+    "gamma_field_width_interactive", "gamma_write_field",
+    "gamma_move_possible", "gamma_player_areas", "gamma_max_areas"
+};
+
+/**
+ * @brief Generator liczb pseudolosowych (xorshift64).
+ * @param[in,out] state – stan generatora, różny od @p 0.
+ * @return Kolejna liczba pseudolosowa.
+ */
+static uint64_t next_random(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *state = x;
+}
+
+/**
+ * @brief Losuje liczbę z przedziału [@p 0, @p n).
+ * @param[in,out] state – stan generatora,
+ * @param[in] n         – długość przedziału, dodatnia.
+ * @return Wylosowana liczba.
+ */
+static uint32_t random_below(uint64_t *state, uint32_t n) {
+    return (next_random(state) >> 16) % n;
+}
+
+/**
+ * @brief Dodaje wywołanie na koniec obciążenia.
+ * @param[in,out] w   – obciążenie,
+ * @param[in] fn      – wywoływana funkcja,
+ * @param[in] player  – numer gracza,
+ * @param[in] x, y    – współrzędne pola.
+ * @return Wartość @p false, jeśli nie udało się zaalokować pamięci.
+ */
+static bool push(workload_t *w, bench_fn_t fn, uint32_t player,
+                 uint32_t x, uint32_t y) {
+    if (w->count == w->capacity) {
+        size_t capacity = w->capacity == 0 ? INITIAL_CAPACITY : 2 * w->capacity;
+        bench_op_t *ops = realloc(w->ops, capacity * sizeof(bench_op_t));
+        if (ops == NULL)
+            return false;
+        w->ops = ops;
+        w->capacity = capacity;
+    }
+    w->ops[w->count++] = (bench_op_t) {fn, player, x, y};
+    return true;
+}
+
+/**
+ * @brief Dodaje wywołanie z losowym graczem i losowym polem.
+ * @param[in,out] w     – obciążenie,
+ * @param[in,out] state – stan generatora,
+ * @param[in] fn        – wywoływana funkcja.
+ * @return Wartość @p false, jeśli nie udało się zaalokować pamięci.
+ */
+static bool push_random(workload_t *w, uint64_t *state, bench_fn_t fn) {
+    return push(w, fn, random_below(state, w->players) + 1,
+                random_below(state, w->width), random_below(state, w->height));
+}
+
+/**
+ * @brief Losowe zapełnianie planszy.
+ * Ruchy losowych graczy na losowe pola przeplatane tanimi zapytaniami,
+ * co jakiś czas złoty ruch, kopia gry i wypisanie planszy.
+ */
+static bool random_fill(workload_t *w, uint64_t *state, uint32_t scale) {
+    static const bench_fn_t queries[] = {
+        BENCH_BUSY_FIELDS, BENCH_FREE_FIELDS, BENCH_PLAYER_AREAS,
+        BENCH_MOVE_POSSIBLE, BENCH_WRITE_FIELD, BENCH_FIELD_WIDTH_INTERACTIVE,
+        BENCH_MAX_AREAS
+    };
+    w->width = w->height = 256 / scale;
+    w->players = 8;
+    w->areas = 32;
+    uint64_t moves = (uint64_t) w->width * w->height * 3 / 2;
+    bool ok = true;
+    for (uint64_t i = 0; ok && i < moves; i++) {
+        ok = push_random(w, state, BENCH_MOVE);
+        if (ok && i % 8 == 0)
+            ok = push_random(w, state, queries[random_below(state, 7)]);
+        if (ok && i % 4096 == 0)
+            ok = push_random(w, state, BENCH_GOLDEN_POSSIBLE)
+                 && push_random(w, state, BENCH_GOLDEN_MOVE);
+        if (ok && i % 16384 == 0)
+            ok = push(w, BENCH_BOARD, 0, 0, 0)
+                 && push(w, BENCH_BOARD_INTERACTIVE, 0, 0, 0)
+                 && push(w, BENCH_COPY, 0, 0, 0);
+    }
+    return ok;
+}
+
+/**
+ * @brief Dodaje zapytania wykonywane w trakcie budowania ścieżki.
+ * @param[in,out] w – obciążenie,
+ * @param[in] i     – numer ruchu na ścieżce.
+ * @return Wartość @p false, jeśli nie udało się zaalokować pamięci.
+ */
+static bool push_path_queries(workload_t *w, uint64_t i) {
+    bool ok = true;
+    if (i % 64 == 0)
+        ok = push(w, BENCH_BUSY_FIELDS, 1, 0, 0)
+             && push(w, BENCH_PLAYER_AREAS, 1, 0, 0);
+    if (ok && i % 16384 == 0)
+        ok = push(w, BENCH_FREE_FIELDS, 1, 0, 0);
+    return ok;
+}
+
+/**
+ * @brief Dodaje wywołania kończące obciążenia ze ścieżką.
+ * Gracz @p 1 dokłada pionki w losowych miejscach, głównie w przerwach
+ * pomiędzy odcinkami ścieżki, co wymaga odnalezienia reprezentanta jej
+ * obszaru, a gracz @p 2 próbuje złotych ruchów rozcinających ścieżkę.
+ * @param[in,out] w     – obciążenie,
+ * @param[in,out] state – stan generatora.
+ * @return Wartość @p false, jeśli nie udało się zaalokować pamięci.
+ */
+static bool push_path_tail(workload_t *w, uint64_t *state) {
+    bool ok = true;
+    for (uint32_t i = 0; ok && i < w->width / 2; i++) {
+        uint32_t x = random_below(state, w->width);
+        uint32_t y = random_below(state, w->height);
+        ok = push(w, BENCH_MOVE_POSSIBLE, 1, x, y) && push(w, BENCH_MOVE, 1, x, y);
+    }
+    for (uint32_t i = 0; ok && i < 16; i++)
+        ok = push(w, BENCH_GOLDEN_POSSIBLE, 2, 0, 0)
+             && push(w, BENCH_GOLDEN_MOVE, 2, random_below(state, w->width),
+                     random_below(state, w->height));
+    return ok && push(w, BENCH_FREE_FIELDS, 1, 0, 0);
+}
+
+/**
+ * @brief Wąż.
+ * Gracz @p 1 z limitem jednego obszaru buduje ścieżkę przechodzącą przez
+ * co drugi wiersz planszy na przemian w prawo i w lewo; każdy ruch łączy
+ * pionek z ciągle rosnącym obszarem.
+ */
+static bool snake(workload_t *w, uint64_t *state, uint32_t scale) {
+    w->width = w->height = 512 / scale;
+    w->players = 2;
+    w->areas = 1;
+    bool ok = true;
+    uint64_t i = 0;
+    for (uint32_t y = 0; ok && y < w->height; y++) {
+        bool right = y % 4 < 2;
+        if (y % 2 == 1) {
+            ok = push(w, BENCH_MOVE, 1, right ? w->width - 1 : 0, y)
+                 && push_path_queries(w, i++);
+            continue;
+        }
+        for (uint32_t j = 0; ok && j < w->width; j++)
+            ok = push(w, BENCH_MOVE, 1, right ? j : w->width - 1 - j, y)
+                 && push_path_queries(w, i++);
+    }
+    return ok && push_path_tail(w, state);
+}
+
+/**
+ * @brief Spirala.
+ * Gracz @p 1 z limitem jednego obszaru buduje ścieżkę zawijającą się od
+ * brzegu planszy do jej środka, z przerwą szerokości jednego pola pomiędzy
+ * kolejnymi zwojami.
+ */
+static bool spiral(workload_t *w, uint64_t *state, uint32_t scale) {
+    static const int dx[] = {1, 0, -1, 0};
+    static const int dy[] = {0, 1, 0, -1};
+    w->width = w->height = 512 / scale;
+    w->players = 2;
+    w->areas = 1;
+    uint32_t x = 0, y = 0;
+    uint64_t i = 0;
+    bool ok = push(w, BENCH_MOVE, 1, x, y);
+    int64_t length = w->width - 1;
+    for (int segment = 0; ok && length > 0; segment++) {
+        for (int64_t j = 0; ok && j < length; j++) {
+            x += dx[segment % 4];
+            y += dy[segment % 4];
+            ok = push(w, BENCH_MOVE, 1, x, y) && push_path_queries(w, i++);
+        }
+        if (segment >= 2 && segment % 2 == 0)
+            length -= 2;
+    }
+    return ok && push_path_tail(w, state);
+}
+
+/**
+ * @brief Burza złotych ruchów.
+ * Plansza zapełniana jest pionkami wielu graczy z małym limitem obszarów,
+ * po czym każdy gracz próbuje wykonać złoty ruch na losowym polu.
+ */
+static bool golden_storm(workload_t *w, uint64_t *state, uint32_t scale) {
+    w->width = w->height = 128 / scale;
+    w->players = 4096 / scale;
+    w->areas = 4;
+    uint64_t moves = (uint64_t) w->width * w->height * 2;
+    bool ok = true;
+    for (uint64_t i = 0; ok && i < moves; i++)
+        ok = push_random(w, state, BENCH_MOVE);
+    for (uint32_t p = 1; ok && p <= w->players; p++) {
+        if (p % 64 == 0)
+            ok = push(w, BENCH_GOLDEN_POSSIBLE, p, 0, 0);
+        for (int j = 0; ok && j < 4; j++)
+            ok = push(w, BENCH_GOLDEN_MOVE, p, random_below(state, w->width),
+                      random_below(state, w->height))
+                 && push_random(w, state, BENCH_BUSY_FIELDS);
+    }
+    return ok;
+}
+
+/**
+ * @brief Zapytania przy limicie obszarów.
+ * Gracze rozrastają się od losowych pól aż do osiągnięcia limitu obszarów,
+ * po czym zadawane są zapytania @ref gamma_free_fields i
+ * @ref gamma_golden_possible przeplatane pojedynczymi ruchami.
+ */
+static bool area_limit(workload_t *w, uint64_t *state, uint32_t scale) {
+    static const int dx[] = {1, 0, -1, 0};
+    static const int dy[] = {0, 1, 0, -1};
+    w->width = w->height = 256 / scale;
+    w->players = 4;
+    w->areas = 16;
+    uint32_t last_x[4], last_y[4];
+    for (int p = 0; p < 4; p++) {
+        last_x[p] = random_below(state, w->width);
+        last_y[p] = random_below(state, w->height);
+    }
+    uint64_t moves = (uint64_t) w->width * w->height;
+    uint32_t queries = 4096 / scale;
+    bool ok = true;
+    for (uint64_t i = 0; ok && i < moves + queries; i++) {
+        uint32_t p = random_below(state, 4);
+        if (i >= moves && i % 16 != 0) {
+            ok = push(w, i % 16 == 8 ? BENCH_GOLDEN_POSSIBLE : BENCH_FREE_FIELDS,
+                      p + 1, 0, 0);
+            continue;
+        }
+        if (random_below(state, 64) == 0) {
+            last_x[p] = random_below(state, w->width);
+            last_y[p] = random_below(state, w->height);
+        } else {
+            uint32_t d = random_below(state, 4);
+            last_x[p] = (last_x[p] + w->width + dx[d]) % w->width;
+            last_y[p] = (last_y[p] + w->height + dy[d]) % w->height;
+        }
+        ok = push(w, BENCH_MOVE, p + 1, last_x[p], last_y[p]);
+    }
+    return ok;
+}
+
+/**
+ * @brief Duża, rzadka plansza.
+ * Nieliczne ruchy na bardzo dużej planszy przeplatane tanimi zapytaniami;
+ * dominuje koszt tworzenia, kopiowania, wypisywania i usuwania gry.
+ */
+static bool huge_sparse(workload_t *w, uint64_t *state, uint32_t scale) {
+    w->width = w->height = 2048 / scale;
+    w->players = 16;
+    w->areas = 100000;
+    uint32_t moves = 50000 / scale;
+    bool ok = true;
+    for (uint32_t i = 0; ok && i < moves; i++)
+        ok = push_random(w, state, BENCH_MOVE)
+             && push_random(w, state, BENCH_BUSY_FIELDS)
+             && push_random(w, state, BENCH_FREE_FIELDS)
+             && push_random(w, state, BENCH_MOVE_POSSIBLE)
+             && push_random(w, state, BENCH_PLAYER_AREAS);
+    return ok && push(w, BENCH_COPY, 0, 0, 0) && push(w, BENCH_BOARD, 0, 0, 0);
+}
+
+/**
+ * @brief Tablica dostępnych obciążeń.
+ */
+static const struct {
+    const char *name;     ///< Nazwa obciążenia.
+    generator_t generate; ///< Funkcja generująca obciążenie.
+} workloads[] = {
+    {"random", random_fill},
+    {"snake", snake},
+    {"spiral", spiral},
+    {"golden", golden_storm},
+    {"limit", area_limit},
+    {"sparse", huge_sparse}
+};
+
+size_t workload_count() {
+    return sizeof(workloads) / sizeof(workloads[0]);
+}
+
+const char *workload_name(size_t i) {
+    return workloads[i].name;
+}
+
+const char *bench_fn_name(bench_fn_t fn) {
+    return fn_names[fn];
+}
+
+bool workload_generate(workload_t *w, size_t i, uint64_t seed, uint32_t scale) {
+    *w = (workload_t) {workloads[i].name, 0, 0, 0, 0, NULL, 0, 0};
+    uint64_t state = seed * 0x9E3779B97F4A7C15ull + i + 1;
+    if (state == 0)
+        state = 1;
+    if (!workloads[i].generate(w, &state, scale)) {
+        workload_free(w);
+        return false;
+    }
+    return true;
+}
+
+void workload_free(workload_t *w) {
+    free(w->ops);
+    w->ops = NULL;
+    w->count = w->capacity = 0;
+}
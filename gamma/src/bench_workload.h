@@ -0,0 +1,109 @@
+/** @file
+ * Interfejs generatora obciążeń dla pomiarów wydajności silnika gry.
+ *
+ * Obciążenie to ciąg wywołań funkcji z gamma.h na jednej grze o ustalonych
+ * parametrach. Ciąg zależy tylko od nazwy obciążenia i ziarna, więc ten sam
+ * pomiar można powtórzyć dla różnych wersji silnika.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#ifndef GAMMA_BENCH_WORKLOAD_H
+#define GAMMA_BENCH_WORKLOAD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Funkcje z gamma.h wywoływane w obciążeniach.
+ */
+typedef enum bench_fn {
+    BENCH_NEW,                     ///< @ref gamma_new
+    BENCH_DELETE,                  ///< @ref gamma_delete
+    BENCH_COPY,                    ///< @ref gamma_copy
+    BENCH_MOVE,                    ///< @ref gamma_move
+    BENCH_GOLDEN_MOVE,             ///< @ref gamma_golden_move
+    BENCH_BUSY_FIELDS,             ///< @ref gamma_busy_fields
+    BENCH_FREE_FIELDS,             ///< @ref gamma_free_fields
+    BENCH_GOLDEN_POSSIBLE,         ///< @ref gamma_golden_possible
+    BENCH_BOARD,                   ///< @ref gamma_board
+    BENCH_BOARD_INTERACTIVE,       ///< @ref gamma_board_interactive
+    BENCH_FIELD_WIDTH_INTERACTIVE, ///< @ref gamma_field_width_interactive
+    BENCH_WRITE_FIELD,             ///< @ref gamma_write_field
+    BENCH_MOVE_POSSIBLE,           ///< @ref gamma_move_possible
+    BENCH_PLAYER_AREAS,            ///< @ref gamma_player_areas
+    BENCH_MAX_AREAS,               ///< @ref gamma_max_areas
+    BENCH_FN_COUNT                 ///< Liczba funkcji.
+} bench_fn_t;
+
+/**
+ * @brief Struktura przechowująca jedno wywołanie funkcji z gamma.h.
+ * Parametry, których funkcja nie przyjmuje, są ignorowane.
+ */
+typedef struct bench_op {
+    uint32_t fn;     ///< Wywoływana funkcja (patrz @ref bench_fn_t).
+    uint32_t player; ///< Numer gracza.
+    uint32_t x;      ///< Numer kolumny.
+    uint32_t y;      ///< Numer wiersza.
+} bench_op_t;
+
+/**
+ * @brief Struktura przechowująca obciążenie.
+ * Gra tworzona jest wywołaniem @ref gamma_new z parametrami @p width,
+ * @p height, @p players i @p areas, następnie wykonywane są kolejne
+ * wywołania z tablicy @p ops, a na końcu gra jest usuwana.
+ */
+typedef struct workload {
+    const char *name;  ///< Nazwa obciążenia.
+    uint32_t width;    ///< Liczba kolumn planszy.
+    uint32_t height;   ///< Liczba wierszy planszy.
+    uint32_t players;  ///< Liczba graczy.
+    uint32_t areas;    ///< Maksymalna liczba obszarów gracza.
+    bench_op_t *ops;   ///< Tablica wywołań.
+    size_t count;      ///< Liczba wywołań.
+    size_t capacity;   ///< Rozmiar tablicy @p ops.
+} workload_t;
+
+/**
+ * @brief Zwraca liczbę dostępnych obciążeń.
+ * @return Liczba dostępnych obciążeń.
+ */
+size_t workload_count();
+
+/**
+ * @brief Zwraca nazwę obciążenia.
+ * @param[in] i – numer obciążenia, mniejszy niż @ref workload_count.
+ * @return Nazwa obciążenia.
+ */
+const char *workload_name(size_t i);
+
+/**
+ * @brief Zwraca nazwę funkcji z gamma.h.
+ * @param[in] fn – funkcja.
+ * @return Nazwa funkcji.
+ */
+const char *bench_fn_name(bench_fn_t fn);
+
+/**
+ * @brief Generuje obciążenie.
+ * @param[out] w    – wskaźnik na strukturę, w której zapisane zostanie
+ *                    obciążenie,
+ * @param[in] i     – numer obciążenia, mniejszy niż @ref workload_count,
+ * @param[in] seed  – ziarno generatora liczb pseudolosowych,
+ * @param[in] scale – dzielnik wymiarów planszy i liczby wywołań, dodatni;
+ *                    wartość @p 1 oznacza pełny rozmiar.
+ * @return Wartość @p true, jeśli udało się wygenerować obciążenie, @p false,
+ * jeśli nie udało się zaalokować pamięci.
+ */
+bool workload_generate(workload_t *w, size_t i, uint64_t seed, uint32_t scale);
+
+/**
+ * @brief Zwalnia pamięć zajmowaną przez obciążenie.
+ * @param[in,out] w – wskaźnik na obciążenie.
+ */
+void workload_free(workload_t *w);
+
+#endif //GAMMA_BENCH_WORKLOAD_H
@@ -0,0 +1,239 @@
+/** @file
+ * Pomiar przepustowości tekstowego i binarnego protokołu trybu wsadowego.
+ *
+ * Program generuje deterministyczny (zależny tylko od ziarna) ciąg poleceń,
+ * zapisuje go w obu protokołach, a następnie mierzy czas rozbioru, wykonania
+ * i zapisu odpowiedzi dla każdego z nich. Pomiar bez wykonywania poleceń
+ * pokazuje sam koszt protokołu.
+ *
+ * Wywołanie: @p gamma_binary_bench [@p commands [@p width @p height
+ * @p players]].
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#define _GNU_SOURCE ///< Makro potrzebne do prawidłowej kompilacji.
+
+#include "binary_protocol.h"
+#include "command.h"
+#include "gamma.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_COMMANDS 2000000 ///< Domyślna liczba poleceń.
+#define DEFAULT_SIZE 1000 ///< Domyślny wymiar planszy.
+#define DEFAULT_PLAYERS 8 ///< Domyślna liczba graczy.
+#define MAX_TEXT_LINE 48 ///< Maksymalna długość wiersza polecenia tekstowego.
+#define SEED 2020 ///< Ziarno generatora poleceń.
+
+/**
+ * @brief Generator liczb pseudolosowych (xorshift64).
+ * @param[in,out] state – stan generatora, różny od @p 0.
+ * @return Kolejna liczba pseudolosowa.
+ */
+static uint64_t next_random(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *state = x;
+}
+
+/**
+ * @brief Zwraca bieżący czas w nanosekundach.
+ * @return Czas zegara monotonicznego w nanosekundach.
+ */
+static uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/**
+ * @brief Generuje ciąg poleceń.
+ * Większość poleceń to ruchy, co dziesiąte to zapytanie @p b, @p f lub @p q.
+ * @param[out] cmds   – tablica na @p n poleceń,
+ * @param[in] n       – liczba poleceń,
+ * @param[in] width   – szerokość planszy,
+ * @param[in] height  – wysokość planszy,
+ * @param[in] players – liczba graczy.
+ */
+static void generate(command_t *cmds, uint64_t n, uint32_t width,
+                     uint32_t height, uint32_t players) {
+    static const char queries[] = {SMALL_B, F, Q};
+    uint64_t state = SEED;
+    for (uint64_t i = 0; i < n; i++) {
+        uint64_t r = next_random(&state);
+        memset(&cmds[i], 0, sizeof(command_t));
+        cmds[i].params[0] = r % players + 1;
+        if (r % 10 == 0) {
+            cmds[i].type = queries[(r >> 8) % 3];
+        } else {
+            cmds[i].type = (r >> 8) % 50 == 0 ? G : M;
+            cmds[i].params[1] = (r >> 16) % width;
+            cmds[i].params[2] = (r >> 40) % height;
+        }
+    }
+}
+
+/**
+ * @brief Zapisuje polecenia w protokole tekstowym.
+ * @param[in] cmds – tablica poleceń,
+ * @param[in] n    – liczba poleceń,
+ * @param[out] len – wskaźnik na zmienną, do której zostanie zapisana długość
+ *                   tekstu.
+ * @return Zaalokowany bufor z tekstem lub @p NULL.
+ */
+static char *encode_text(const command_t *cmds, uint64_t n, uint64_t *len) {
+    char *text = malloc(n * MAX_TEXT_LINE);
+    if (text == NULL)
+        return NULL;
+    uint64_t it = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        const command_t *c = &cmds[i];
+        if (c->type == M || c->type == G)
+            it += sprintf(text + it, "%c %u %u %u\n", c->type,
+                          c->params[0], c->params[1], c->params[2]);
+        else
+            it += sprintf(text + it, "%c %u\n", c->type, c->params[0]);
+    }
+    *len = it;
+    return text;
+}
+
+/**
+ * @brief Zapisuje polecenia w protokole binarnym, w jednej ramce.
+ * @param[in] cmds – tablica poleceń,
+ * @param[in] n    – liczba poleceń.
+ * @return Zaalokowany bufor z ramką lub @p NULL.
+ */
+static unsigned char *encode_binary(const command_t *cmds, uint64_t n) {
+    unsigned char *buf = malloc(BINARY_HEADER_SIZE + n * BINARY_RECORD_SIZE);
+    if (buf == NULL)
+        return NULL;
+    binary_encode_header(buf, n);
+    for (uint64_t i = 0; i < n; i++)
+        binary_encode_command(buf + BINARY_HEADER_SIZE + i * BINARY_RECORD_SIZE, &cmds[i]);
+    return buf;
+}
+
+/**
+ * @brief Mierzy przetwarzanie poleceń w protokole tekstowym.
+ * @param[in] text    – tekst poleceń,
+ * @param[in] len     – długość tekstu,
+ * @param[out] out    – bufor na odpowiedzi,
+ * @param[in] g       – gra, na której wykonywane są polecenia, lub @p NULL,
+ *                      jeśli mierzony ma być tylko protokół.
+ * @return Czas w nanosekundach.
+ */
+static uint64_t run_text(const char *text, uint64_t len, char *out, gamma_t *g) {
+    uint64_t start = now_ns();
+    uint64_t it = 0, pos = 0;
+    command_t cmd;
+    command_result_t result = {true, 1, NULL};
+    while (pos < len) {
+        const char *nl = memchr(text + pos, END_LINE, len - pos);
+        uint64_t line_len = nl - (text + pos) + 1;
+        if (command_parse_line(text + pos, line_len, &cmd) == LINE_OK) {
+            if (g != NULL)
+                command_execute(g, &cmd, &result);
+            if (cmd.type == SMALL_B || cmd.type == F)
+                it += sprintf(out + it, "%lu\n", result.value);
+            else
+                it += sprintf(out + it, "%d\n", result.value != 0);
+        }
+        pos += line_len;
+    }
+    return now_ns() - start;
+}
+
+/**
+ * @brief Mierzy przetwarzanie poleceń w protokole binarnym.
+ * @param[in] frame   – ramka z poleceniami,
+ * @param[out] out    – bufor na ramkę odpowiedzi,
+ * @param[in] g       – gra, na której wykonywane są polecenia, lub @p NULL,
+ *                      jeśli mierzony ma być tylko protokół.
+ * @return Czas w nanosekundach.
+ */
+static uint64_t run_binary(const unsigned char *frame, unsigned char *out, gamma_t *g) {
+    uint64_t start = now_ns();
+    uint32_t n = binary_decode_header(frame);
+    binary_encode_header(out, n);
+    for (uint32_t i = 0; i < n; i++) {
+        const unsigned char *rec = frame + BINARY_HEADER_SIZE + (uint64_t) i * BINARY_RECORD_SIZE;
+        unsigned char *res = out + BINARY_HEADER_SIZE + (uint64_t) i * BINARY_RECORD_SIZE;
+        if (g != NULL) {
+            char *board;
+            binary_execute_record(g, rec, res, &board);
+        } else {
+            command_t cmd;
+            binary_response_t r = {rec[0], BINARY_STATUS_OK, 1};
+            if (!binary_decode_command(rec, &cmd))
+                r.status = BINARY_STATUS_ERROR;
+            binary_encode_response(res, &r);
+        }
+    }
+    return now_ns() - start;
+}
+
+/**
+ * @brief Wypisuje wynik pomiaru.
+ * @param[in] name – nazwa pomiaru,
+ * @param[in] ns   – czas w nanosekundach,
+ * @param[in] n    – liczba poleceń.
+ */
+static void report(const char *name, uint64_t ns, uint64_t n) {
+    printf("%-16s %10.1f ns/cmd %10.2f Mcmd/s\n", name,
+           (double) ns / n, n * 1000.0 / ns);
+}
+
+int main(int argc, char *argv[]) {
+    uint64_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_COMMANDS;
+    uint32_t width = argc > 4 ? strtoul(argv[2], NULL, 10) : DEFAULT_SIZE;
+    uint32_t height = argc > 4 ? strtoul(argv[3], NULL, 10) : DEFAULT_SIZE;
+    uint32_t players = argc > 4 ? strtoul(argv[4], NULL, 10) : DEFAULT_PLAYERS;
+    if (n == 0 || n > UINT32_MAX || width == 0 || height == 0 || players == 0) {
+        fprintf(stderr, "usage: %s [commands [width height players]]\n", argv[0]);
+        return 1;
+    }
+
+    command_t *cmds = malloc(n * sizeof(command_t));
+    uint64_t text_len = 0;
+    char *text = NULL, *text_out = malloc(n * MAX_TEXT_LINE);
+    unsigned char *frame = NULL;
+    unsigned char *frame_out = malloc(BINARY_HEADER_SIZE + n * BINARY_RECORD_SIZE);
+    if (cmds != NULL) {
+        generate(cmds, n, width, height, players);
+        text = encode_text(cmds, n, &text_len);
+        frame = encode_binary(cmds, n);
+    }
+    if (cmds == NULL || text == NULL || text_out == NULL
+        || frame == NULL || frame_out == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    report("text codec", run_text(text, text_len, text_out, NULL), n);
+    report("binary codec", run_binary(frame, frame_out, NULL), n);
+
+    // Limit obszarów nie jest osiągalny, więc zapytania działają w czasie
+    // stałym i pomiar nie jest zdominowany przez przeszukiwanie planszy.
+    uint32_t areas = (uint64_t) width * height > UINT32_MAX ? UINT32_MAX : width * height;
+    gamma_t *g = gamma_new(width, height, players, areas);
+    report("text total", run_text(text, text_len, text_out, g), n);
+    gamma_delete(g);
+    g = gamma_new(width, height, players, areas);
+    report("binary total", run_binary(frame, frame_out, g), n);
+    gamma_delete(g);
+
+    free(cmds);
+    free(text);
+    free(text_out);
+    free(frame);
+    free(frame_out);
+    return 0;
+}
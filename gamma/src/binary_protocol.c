@@ -0,0 +1,138 @@
+/** @file
+ * Zawiera implementację interfejsu binary_protocol.h
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#include "binary_protocol.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Zapisuje 32-bitową liczbę w kolejności bajtów little-endian.
+ * @param[out] buf – bufor o rozmiarze niemniejszym niż @p 4,
+ * @param[in] v    – liczba.
+ */
+static void write_le32(unsigned char *buf, uint32_t v) {
+    for (int i = 0; i < 4; i++)
+        buf[i] = (v >> (8 * i)) & 0xff;
+}
+
+/**
+ * @brief Zapisuje 64-bitową liczbę w kolejności bajtów little-endian.
+ * @param[out] buf – bufor o rozmiarze niemniejszym niż @p 8,
+ * @param[in] v    – liczba.
+ */
+static void write_le64(unsigned char *buf, uint64_t v) {
+    for (int i = 0; i < 8; i++)
+        buf[i] = (v >> (8 * i)) & 0xff;
+}
+
+/**
+ * @brief Odczytuje 32-bitową liczbę zapisaną w kolejności bajtów little-endian.
+ * @param[in] buf – bufor o rozmiarze niemniejszym niż @p 4.
+ * @return Odczytana liczba.
+ */
+static uint32_t read_le32(const unsigned char *buf) {
+    uint32_t v = 0;
+    for (int i = 3; i >= 0; i--)
+        v = (v << 8) | buf[i];
+    return v;
+}
+
+/**
+ * @brief Odczytuje 64-bitową liczbę zapisaną w kolejności bajtów little-endian.
+ * @param[in] buf – bufor o rozmiarze niemniejszym niż @p 8.
+ * @return Odczytana liczba.
+ */
+static uint64_t read_le64(const unsigned char *buf) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; i--)
+        v = (v << 8) | buf[i];
+    return v;
+}
+
+void binary_encode_header(unsigned char *buf, uint32_t count) {
+    write_le32(buf, count);
+    write_le32(buf + 4, 0);
+}
+
+uint32_t binary_decode_header(const unsigned char *buf) {
+    return read_le32(buf);
+}
+
+void binary_encode_command(unsigned char *buf, const command_t *cmd) {
+    int count = get_parameters_count_from_char(cmd->type);
+    memset(buf, 0, BINARY_RECORD_SIZE);
+    buf[0] = cmd->type;
+    for (int i = 0; i < count; i++)
+        write_le32(buf + 4 + 4 * i, cmd->params[i]);
+}
+
+bool binary_decode_command(const unsigned char *buf, command_t *cmd) {
+    int count = get_parameters_count_from_char(buf[0]);
+    if (count == CHAR_INCORRECT || buf[1] != 0 || buf[2] != 0 || buf[3] != 0)
+        return false;
+    cmd->type = buf[0];
+    for (int i = 0; i < 3; i++) {
+        cmd->params[i] = read_le32(buf + 4 + 4 * i);
+        if (i >= count && cmd->params[i] != 0)
+            return false;
+    }
+    return true;
+}
+
+void binary_encode_response(unsigned char *buf, const binary_response_t *res) {
+    memset(buf, 0, BINARY_RECORD_SIZE);
+    buf[0] = res->opcode;
+    buf[1] = res->status;
+    write_le64(buf + 8, res->value);
+}
+
+void binary_decode_response(const unsigned char *buf, binary_response_t *res) {
+    res->opcode = buf[0];
+    res->status = buf[1];
+    res->value = read_le64(buf + 8);
+}
+
+void binary_execute_record(gamma_t *g, const unsigned char *record,
+                           unsigned char *out, char **board) {
+    command_t cmd;
+    binary_response_t res = {record[0], BINARY_STATUS_ERROR, 0};
+    *board = NULL;
+    if (binary_decode_command(record, &cmd)) {
+        command_result_t result;
+        command_execute(g, &cmd, &result);
+        if (result.ok) {
+            res.status = BINARY_STATUS_OK;
+            res.value = result.value;
+            *board = result.board;
+        }
+    }
+    binary_encode_response(out, &res);
+}
+
+void binary_mode(gamma_t *g, FILE *in, FILE *out) {
+    unsigned char header[BINARY_HEADER_SIZE];
+    unsigned char record[BINARY_RECORD_SIZE];
+    unsigned char response[BINARY_RECORD_SIZE];
+    while (fread(header, BINARY_HEADER_SIZE, 1, in) == 1) {
+        uint32_t count = binary_decode_header(header);
+        binary_encode_header(header, count);
+        fwrite(header, BINARY_HEADER_SIZE, 1, out);
+        for (uint32_t i = 0; i < count; i++) {
+            if (fread(record, BINARY_RECORD_SIZE, 1, in) != 1)
+                break;
+            char *board;
+            binary_execute_record(g, record, response, &board);
+            fwrite(response, BINARY_RECORD_SIZE, 1, out);
+            if (board != NULL) {
+                fputs(board, out);
+                free(board);
+            }
+        }
+        fflush(out);
+    }
+}
@@ -0,0 +1,134 @@
+/** @file
+ * Interfejs udostępniający binarny protokół poleceń trybu wsadowego.
+ *
+ * Tryb binarny rozpoczyna wiersz tekstowy @p R @p width @p height
+ * @p players @p areas, na który program odpowiada tak jak na polecenie
+ * @p B (@p OK @p line). Dalej wejście składa się z ramek. Ramka zaczyna się
+ * nagłówkiem o rozmiarze @ref BINARY_HEADER_SIZE bajtów (liczba rekordów
+ * w ramce jako 32-bitowa liczba bez znaku i 4 bajty zarezerwowane), po
+ * którym następują rekordy poleceń o rozmiarze @ref BINARY_RECORD_SIZE
+ * bajtów: kod polecenia (znak polecenia trybu wsadowego), 3 bajty
+ * zarezerwowane, numer gracza, numer kolumny i numer wiersza jako 32-bitowe
+ * liczby bez znaku. Bajty zarezerwowane i parametry, których polecenie
+ * nie ma, muszą być zerami; na rekord, który tego nie spełnia, program
+ * odpowiada statusem @ref BINARY_STATUS_ERROR, tak jak na wiersz z błędną
+ * liczbą parametrów w trybie wsadowym.
+ *
+ * Na każdą ramkę program odpowiada ramką o tej samej liczbie rekordów
+ * odpowiedzi: kod polecenia, status (@ref BINARY_STATUS_OK lub
+ * @ref BINARY_STATUS_ERROR), 6 bajtów zarezerwowanych i wynik jako 64-bitowa
+ * liczba bez znaku. Wynikiem poleceń @p p, @p s i @p u jest długość napisu
+ * opisującego planszę lub liczniki, a sam napis następuje bezpośrednio po
+ * rekordzie odpowiedzi.
+ * Wszystkie liczby zapisywane są w kolejności bajtów little-endian.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#ifndef GAMMA_BINARY_PROTOCOL_H
+#define GAMMA_BINARY_PROTOCOL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "command.h"
+#include "gamma.h"
+
+#define BINARY_MODE 'R' ///< Pierwszy znak w poleceniu rozpoczynającym tryb binarny.
+#define BINARY_HEADER_SIZE 8 ///< Rozmiar nagłówka ramki w bajtach.
+#define BINARY_RECORD_SIZE 16 ///< Rozmiar rekordu polecenia i odpowiedzi w bajtach.
+#define BINARY_STATUS_OK 0 ///< Status odpowiedzi na poprawnie wykonane polecenie.
+#define BINARY_STATUS_ERROR 1 /**< Status odpowiedzi na polecenie, które
+                               * w trybie wsadowym dałoby komunikat @p ERROR.
+                               */
+
+/**
+ * @brief Struktura przechowująca rekord odpowiedzi.
+ */
+typedef struct binary_response {
+    char opcode;    ///< Kod polecenia, na które jest to odpowiedź.
+    uint8_t status; ///< Status odpowiedzi.
+    uint64_t value; ///< Wynik polecenia.
+} binary_response_t;
+
+/**
+ * @brief Zapisuje nagłówek ramki.
+ * @param[out] buf  – bufor o rozmiarze niemniejszym niż @ref BINARY_HEADER_SIZE,
+ * @param[in] count – liczba rekordów w ramce.
+ */
+void binary_encode_header(unsigned char *buf, uint32_t count);
+
+/**
+ * @brief Odczytuje nagłówek ramki.
+ * @param[in] buf – bufor zawierający nagłówek ramki.
+ * @return Liczba rekordów w ramce.
+ */
+uint32_t binary_decode_header(const unsigned char *buf);
+
+/**
+ * @brief Zapisuje rekord polecenia.
+ * Parametry, których polecenie nie ma, zapisywane są jako zera.
+ * @param[out] buf – bufor o rozmiarze niemniejszym niż @ref BINARY_RECORD_SIZE,
+ * @param[in] cmd  – polecenie.
+ */
+void binary_encode_command(unsigned char *buf, const command_t *cmd);
+
+/**
+ * @brief Odczytuje rekord polecenia.
+ * @param[in] buf  – bufor zawierający rekord polecenia,
+ * @param[out] cmd – wskaźnik na strukturę, do której zapisane zostanie
+ *                   polecenie.
+ * @return Wartość @p true, jeśli kod polecenia jest poprawny, a bajty
+ * zarezerwowane i parametry, których polecenie nie ma, są zerami, @p false
+ * w przeciwnym przypadku.
+ */
+bool binary_decode_command(const unsigned char *buf, command_t *cmd);
+
+/**
+ * @brief Zapisuje rekord odpowiedzi.
+ * @param[out] buf – bufor o rozmiarze niemniejszym niż @ref BINARY_RECORD_SIZE,
+ * @param[in] res  – odpowiedź.
+ */
+void binary_encode_response(unsigned char *buf, const binary_response_t *res);
+
+/**
+ * @brief Odczytuje rekord odpowiedzi.
+ * @param[in] buf  – bufor zawierający rekord odpowiedzi,
+ * @param[out] res – wskaźnik na strukturę, do której zapisana zostanie
+ *                   odpowiedź.
+ */
+void binary_decode_response(const unsigned char *buf, binary_response_t *res);
+
+/**
+ * @brief Wykonuje polecenie zapisane w rekordzie i zapisuje rekord odpowiedzi.
+ * Polecenie wykonywane jest funkcją @ref command_execute, tak samo jak
+ * w trybie wsadowym.
+ * @param[in,out] g    – wskaźnik na strukturę reprezentującą stan gry,
+ *                       różny od @p NULL,
+ * @param[in] record   – rekord polecenia,
+ * @param[out] out     – bufor na rekord odpowiedzi,
+ * @param[out] board   – wskaźnik na zmienną, do której zapisany zostanie
+ *                       zaalokowany napis opisujący planszę (dla polecenia
+ *                       @p p) lub @p NULL.
+ */
+void binary_execute_record(gamma_t *g, const unsigned char *record,
+                           unsigned char *out, char **board);
+
+/**
+ * @brief Przeprowadza tryb binarny.
+ * Wczytuje kolejne ramki ze strumienia @p in, wykonuje zawarte w nich
+ * polecenia na grze, której stan reprezentuje struktura wskazywana przez
+ * @p g, i zapisuje ramki odpowiedzi do strumienia @p out. Po każdej ramce
+ * opróżnia bufor strumienia @p out. Kończy działanie, gdy skończy się
+ * strumień wejściowy; niepełna ramka na końcu strumienia jest odpowiadana
+ * tylko w części, dla której wczytano pełne rekordy.
+ * @param[in,out] g    – wskaźnik na strukturę reprezentującą stan gry,
+ *                       różny od @p NULL,
+ * @param[in,out] in   – strumień wejściowy,
+ * @param[in,out] out  – strumień wyjściowy.
+ */
+void binary_mode(gamma_t *g, FILE *in, FILE *out);
+
+#endif //GAMMA_BINARY_PROTOCOL_H
@@ -0,0 +1,225 @@
+/** @file
+ * Zawiera implementację interfejsu command.h
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#define _GNU_SOURCE ///< Makro potrzebne do prawidłowej kompilacji.
+
+#include "command.h"
+#include "memory_util.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief Sprawdza, czy znak jest cyfrą.
+ * @param[in] c – znak.
+ * @return Wartość @p true, jeśli @p c jest cyfrą, @p false w przeciwnym
+ * przypadku.
+ */
+static bool is_digit_char(char c) {
+    return isdigit((unsigned char) c);
+}
+
+/**
+ * @brief Sprawdza, czy znak jest biały.
+ * @param[in] c – znak.
+ * @return Wartość @p true, jeśli @p c jest białym znakiem, @p false
+ * w przeciwnym przypadku.
+ */
+static bool is_space_char(char c) {
+    return isspace((unsigned char) c);
+}
+
+bool read_numbers(const char *line, int parameters_count, uint32_t *numbers) {
+    if (!is_space_char(line[0]))
+        return false;
+    int it = 0;
+    bool in_token = false;
+    uint64_t wynik = 0;
+    for (const char *c = line;; c++) {
+        if (is_digit_char(*c)) {
+            if (!in_token) {
+                if (it > parameters_count - 1)
+                    return false;
+                in_token = true;
+                wynik = 0;
+            }
+            // Po przekroczeniu zakresu wynik przestaje rosnąć,
+            // ale dalej jest większy niż UINT32_MAX.
+            if (wynik <= UINT32_MAX)
+                wynik = wynik * 10 + (*c - '0');
+        } else if (is_space_char(*c)) {
+            if (in_token) {
+                if (wynik > UINT32_MAX)
+                    return false;
+                numbers[it] = wynik;
+                it++;
+                in_token = false;
+            }
+            if (*c == END_LINE)
+                break;
+        } else {
+            return false;
+        }
+    }
+    return it == parameters_count;
+}
+
+int get_parameters_count_from_char(char c) {
+    switch (c) {
+        case M:
+            return 3;
+        case G:
+            return 3;
+        case SMALL_B:
+        case F:
+        case Q:
+            return 1;
+        case P:
+        case STATS:
+        case MEMORY:
+            return 0;
+        default:
+            return CHAR_INCORRECT;
+    }
+}
+
+line_status_t command_parse_line(const char *line, size_t len, command_t *cmd) {
+    char c = line[0];
+    if (c == IGNORE_LINE || c == END_LINE)
+        return LINE_IGNORE;
+    if (line[len - 1] != END_LINE)
+        return LINE_ERROR;
+    int param_count = get_parameters_count_from_char(c);
+    if (param_count == CHAR_INCORRECT)
+        return LINE_ERROR;
+    if (!read_numbers(&line[1], param_count, cmd->params))
+        return LINE_ERROR;
+    cmd->type = c;
+    return LINE_OK;
+}
+
+line_status_t command_parse_multi_line(const char *line, size_t len,
+                                       multi_command_t *mc) {
+    uint32_t numbers[MAX_PARAMETER_COUNT + 1];
+    char c = line[0];
+    if (c == IGNORE_LINE || c == END_LINE)
+        return LINE_IGNORE;
+    if (line[len - 1] != END_LINE)
+        return LINE_ERROR;
+    int param_count;
+    if (c == NEW_GAME)
+        param_count = MAX_PARAMETER_COUNT;
+    else if (c == DELETE_GAME)
+        param_count = 0;
+    else
+        param_count = get_parameters_count_from_char(c);
+    if (param_count == CHAR_INCORRECT)
+        return LINE_ERROR;
+    if (!read_numbers(&line[1], param_count + 1, numbers))
+        return LINE_ERROR;
+    mc->game = numbers[0];
+    mc->cmd.type = c;
+    memcpy(mc->cmd.params, &numbers[1], param_count * sizeof(uint32_t));
+    return LINE_OK;
+}
+
+/**
+ * @brief Tworzy napis z licznikami operacji silnika gry.
+ * Napis ma postać par @p nazwa @p wartość oddzielonych spacjami i jest
+ * zakończony znakiem nowej linii.
+ * @param[in] g – wskaźnik na strukturę przechowującą stan gry.
+ * @return Zaalokowany napis lub @p NULL, jeśli silnik skompilowano bez
+ * liczników lub nie udało się zaalokować pamięci.
+ */
+static char *stats_to_string(gamma_t *g) {
+    gamma_stats_t st;
+    if (!gamma_stats(g, &st))
+        return NULL;
+    char *s = NULL;
+    if (asprintf(&s, "find_parent %lu steps %lu dfs %lu stack_resizes %lu "
+                     "stack_shrinks %lu golden_trials %lu\n",
+                 st.find_parent_calls, st.find_parent_steps, st.dfs_cells,
+                 st.stack_resizes, st.stack_shrinks,
+                 st.golden_trials) < 0)
+        return NULL;
+    return s;
+}
+
+/**
+ * @brief Tworzy napis z rozmiarami pamięci zajmowanej przez grę.
+ * Napis ma postać par @p nazwa @p wartość oddzielonych spacjami i jest
+ * zakończony znakiem nowej linii. Po rozmiarach struktur gry (patrz
+ * @ref gamma_memory_usage) następują liczniki alokacji całego procesu
+ * (patrz @ref mem_get_stats).
+ * @param[in] g – wskaźnik na strukturę przechowującą stan gry.
+ * @return Zaalokowany napis lub @p NULL, jeśli nie udało się zaalokować
+ * pamięci.
+ */
+static char *memory_to_string(gamma_t *g) {
+    gamma_memory_t m;
+    mem_stats_t st;
+    if (!gamma_memory_usage(g, &m))
+        return NULL;
+    mem_get_stats(&st);
+    char *s = NULL;
+    if (asprintf(&s, "total %lu game %lu board %lu parents %lu areas_size %lu "
+                     "visited %lu stack %lu live %lu peak %lu allocs %lu "
+                     "frees %lu failures %lu limit %lu\n",
+                 m.total, m.game, m.board, m.parents, m.areas_size,
+                 m.visited, m.stack, st.live, st.peak, st.allocs, st.frees,
+                 st.failures, st.limit) < 0)
+        return NULL;
+    return s;
+}
+
+void command_execute(gamma_t *g, const command_t *cmd, command_result_t *result) {
+    const uint32_t *num = cmd->params;
+    result->ok = true;
+    result->value = 0;
+    result->board = NULL;
+    switch (cmd->type) {
+        case M:
+            result->value = gamma_move(g, num[0], num[1], num[2]);
+            break;
+        case G:
+            result->value = gamma_golden_move(g, num[0], num[1], num[2]);
+            break;
+        case SMALL_B:
+            result->value = gamma_busy_fields(g, num[0]);
+            break;
+        case F:
+            result->value = gamma_free_fields(g, num[0]);
+            break;
+        case Q:
+            result->value = gamma_golden_possible(g, num[0]);
+            break;
+        case P:
+            result->board = gamma_board(g);
+            if (result->board == NULL)
+                result->ok = false;
+            else
+                result->value = strlen(result->board);
+            break;
+        case STATS:
+            result->board = stats_to_string(g);
+            if (result->board == NULL)
+                result->ok = false;
+            else
+                result->value = strlen(result->board);
+            break;
+        case MEMORY:
+            result->board = memory_to_string(g);
+            if (result->board == NULL)
+                result->ok = false;
+            else
+                result->value = strlen(result->board);
+            break;
+        default:
+            result->ok = false;
+    }
+}
@@ -0,0 +1,165 @@
+/** @file
+ * Interfejs udostępniający rozbiór pojedynczych poleceń trybu wsadowego.
+ * Rozbiór nie modyfikuje wczytanego wiersza, dzięki czemu może być
+ * wykonywany równolegle na wielu wątkach, także bezpośrednio na pamięci
+ * pliku zmapowanego poleceniem @p mmap.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#ifndef GAMMA_COMMAND_H
+#define GAMMA_COMMAND_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "gamma.h"
+
+#define IGNORE_LINE '#' /**< Znak oznaczający ignorowanie linii,
+                         * w której jest pierwszym znakiem.
+                         */
+#define M 'm' ///< Pierwszy znak w poleceniu wywołującym @ref gamma_move.
+#define G 'g' ///< Pierwszy znak w poleceniu wywołującym @ref gamma_golden_move.
+#define P 'p' ///< Pierwszy znak w poleceniu wywołującym @ref gamma_board.
+#define F 'f' ///< Pierwszy znak w poleceniu wywołującym @ref gamma_free_fields.
+#define Q 'q' ///< Pierwszy znak w poleceniu wywołującym @ref gamma_golden_possible.
+#define SMALL_B 'b' ///< Pierwszy znak w poleceniu wywołującym @ref gamma_busy_fields.
+#define STATS 's' ///< Pierwszy znak w poleceniu wywołującym @ref gamma_stats.
+#define MEMORY 'u' ///< Pierwszy znak w poleceniu wywołującym @ref gamma_memory_usage.
+#define NEW_GAME 'N' ///< Pierwszy znak w poleceniu tworzącym grę w trybie wielu gier.
+#define DELETE_GAME 'D' ///< Pierwszy znak w poleceniu usuwającym grę w trybie wielu gier.
+#define MAX_PARAMETER_COUNT 4 ///< Maksymalna liczba parametrów w poleceniu
+#define END_LINE '\n' ///< Znak nowej linii.
+#define CHAR_INCORRECT -1 /**< Zwracana przez @ref get_parameters_count_from_char,
+                           * gdy znak jest niepoprawnym pierwszym znakiem polecenia.
+                           */
+
+/**
+ * @brief Struktura przechowująca rozebrane polecenie trybu wsadowego.
+ */
+typedef struct command {
+    char type;                             ///< Pierwszy znak polecenia.
+    uint32_t params[MAX_PARAMETER_COUNT];  ///< Parametry występujące po znaku.
+} command_t;
+
+/**
+ * @brief Struktura przechowująca wynik wykonania polecenia.
+ */
+typedef struct command_result {
+    bool ok;        /**< Równe @p false, jeśli zamiast wyniku należy
+                     * zgłosić błąd (@p ERROR).
+                     */
+    uint64_t value; /**< Wynik polecenia; dla poleceń zwracających wartość
+                     * typu @p bool równy @p 0 lub @p 1, dla poleceń
+                     * @ref P, @ref STATS i @ref MEMORY długość napisu
+                     * @p board.
+                     */
+    char *board;    /**< Dla polecenia @ref P zaalokowany napis opisujący
+                     * planszę, a dla poleceń @ref STATS i @ref MEMORY
+                     * napis z licznikami operacji lub zajętej pamięci
+                     * zakończony znakiem nowej linii; napis należy
+                     * zwolnić. Dla pozostałych poleceń
+                     * @p NULL.
+                     */
+} command_result_t;
+
+/**
+ * @brief Struktura przechowująca rozebrane polecenie trybu wielu gier.
+ * Polecenie trybu wielu gier to polecenie trybu wsadowego, w którym
+ * pierwszym parametrem jest identyfikator gry, lub jedno z poleceń
+ * @ref NEW_GAME (parametry jak w poleceniu @p B) i @ref DELETE_GAME
+ * (bez parametrów) poprzedzonych identyfikatorem gry.
+ */
+typedef struct multi_command {
+    uint32_t game; ///< Identyfikator gry.
+    command_t cmd; ///< Polecenie bez identyfikatora gry.
+} multi_command_t;
+
+/**
+ * @brief Wynik rozbioru wiersza wejścia w trybie wsadowym.
+ */
+typedef enum line_status {
+    LINE_OK,     ///< Wiersz zawiera poprawne polecenie.
+    LINE_IGNORE, ///< Wiersz jest komentarzem lub jest pusty.
+    LINE_ERROR   ///< Wiersz jest niepoprawny, należy wypisać @p ERROR.
+} line_status_t;
+
+/**
+ * @brief Wczytuje liczby, których zapis dziesiętny występuje w łańcuchu.
+ * Odczytane liczby zapisuje w tablicy @p numbers.
+ * Zakłada, że łańcuch jest zakończony znakiem @ref END_LINE. Sprawdza,
+ * czy występuje w nim dokładnie @p parameters_count liczb oddzielonych
+ * białymi znakami, czy pierwszy znak jest biały i czy w łańcuchu nie ma
+ * znaków innych niż białe znaki i cyfry. Liczby powinny mieścić się
+ * w zakresie zmiennej typu @p uint32_t. Łańcuch nie jest modyfikowany.
+ * @param[in] line              – łańcuch znaków zawierający zapis
+ *                                dziesiętny liczb, zakończony znakiem
+ *                                @ref END_LINE,
+ * @param[in] parameters_count  – spodziewana liczba liczb w łańcuchu,
+ * @param[out] numbers          – tablica, do której zapisywane będą
+ *                                wczytane liczby, o rozmiarze niemniejszym niż
+ *                                @p parameters_count.
+ * @return Wartość @p true jeśli konwersja się udała i wszystkie założenia były
+ * spełnione, wartość @p false w przeciwnym przypadku.
+ */
+bool read_numbers(const char *line, int parameters_count, uint32_t *numbers);
+
+/**
+ * @brief Znajduje liczbę parametrów dla danego pierwszego znaku polecenia.
+ * Rozważa poprawne pierwsze znaki poleceń w trybie wsadowym (czyli znak 'B'
+ * nie jest poprawnym pierwszym znakiem).
+ * @param[in] c – pierwszy znak polecenia.
+ * @return Liczba parametrów w poleceniu, którego pierwszym znakiem jest @p c,
+ * jeżeli @p c jest pierwszym znakiem polecenia akceptowanego po przejściu w
+ * tryb wsadowy, wartość @ref CHAR_INCORRECT w przeciwnym przypadku.
+ */
+int get_parameters_count_from_char(char c);
+
+/**
+ * @brief Rozbiera wiersz wejścia w trybie wsadowym.
+ * Wiersz o długości @p len zawiera wszystkie znaki zwrócone dla niego przez
+ * @p getline (w szczególności kończący go znak @ref END_LINE, o ile wystąpił).
+ * Nie musi być zakończony znakiem końca łańcucha.
+ * @param[in] line – wskaźnik na pierwszy znak wiersza,
+ * @param[in] len  – długość wiersza, liczba dodatnia,
+ * @param[out] cmd – wskaźnik na strukturę, do której zostanie zapisane
+ *                   polecenie, jeśli wiersz jest poprawny.
+ * @return Wartość @ref LINE_IGNORE dla komentarzy i pustych wierszy,
+ * @ref LINE_OK dla poprawnych poleceń i @ref LINE_ERROR w pozostałych
+ * przypadkach.
+ */
+line_status_t command_parse_line(const char *line, size_t len, command_t *cmd);
+
+/**
+ * @brief Rozbiera wiersz wejścia w trybie wielu gier.
+ * Działa jak @ref command_parse_line, ale spodziewa się identyfikatora gry
+ * przed parametrami polecenia i akceptuje dodatkowo polecenia
+ * @ref NEW_GAME i @ref DELETE_GAME.
+ * @param[in] line – wskaźnik na pierwszy znak wiersza,
+ * @param[in] len  – długość wiersza, liczba dodatnia,
+ * @param[out] mc  – wskaźnik na strukturę, do której zostanie zapisane
+ *                   polecenie, jeśli wiersz jest poprawny.
+ * @return Wartość @ref LINE_IGNORE dla komentarzy i pustych wierszy,
+ * @ref LINE_OK dla poprawnych poleceń i @ref LINE_ERROR w pozostałych
+ * przypadkach.
+ */
+line_status_t command_parse_multi_line(const char *line, size_t len,
+                                       multi_command_t *mc);
+
+/**
+ * @brief Wykonuje polecenie trybu wsadowego.
+ * Wywołuje funkcję silnika odpowiadającą poleceniu @p cmd na grze, której
+ * stan reprezentuje struktura wskazywana przez @p g, i zapisuje jej wynik.
+ * Funkcja nic nie wypisuje, jest wspólna dla wszystkich trybów
+ * przyjmujących polecenia trybu wsadowego.
+ * @param[in,out] g    – wskaźnik na strukturę reprezentującą stan gry,
+ *                       różny od @p NULL,
+ * @param[in] cmd      – polecenie o poprawnym pierwszym znaku,
+ * @param[out] result  – wskaźnik na strukturę, do której zostanie zapisany
+ *                       wynik.
+ */
+void command_execute(gamma_t *g, const command_t *cmd, command_result_t *result);
+
+#endif //GAMMA_COMMAND_H
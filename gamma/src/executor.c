@@ -0,0 +1,339 @@
+/** @file
+ * Zawiera implementację interfejsu executor.h
+ *
+ * Kolejka wątku roboczego to kolejka Vyukova: producent dopisuje zadanie
+ * jedną atomową zamianą głowy kolejki, a jedyny konsument zdejmuje zadania
+ * z ogona bez operacji atomowych typu odczyt-modyfikacja-zapis. Wątek,
+ * który nie ma pracy, zasypia na zmiennej warunkowej; producent budzi go
+ * tylko wtedy, gdy zobaczy ustawioną flagę @p sleeping, więc w czasie
+ * ciągłej pracy nie są używane żadne blokady.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#define _GNU_SOURCE ///< Makro potrzebne do prawidłowej kompilacji.
+
+#include "executor.h"
+#include "game_map.h"
+#include "gamma_pool.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define CACHE_LINE 64 ///< Rozmiar linii pamięci podręcznej w bajtach.
+#define SPIN_COUNT 256 /**< Liczba prób pobrania zadania przed uśpieniem
+                        * wątku roboczego.
+                        */
+#define HASH_MULTIPLIER 0x9E3779B97F4A7C15ull ///< Mnożnik haszowania Fibonacciego.
+
+/**
+ * @brief Struktura przechowująca zlecone polecenie, element kolejki.
+ */
+typedef struct task {
+    struct task *_Atomic next; ///< Następne zadanie w kolejce.
+    multi_command_t mc;        ///< Polecenie.
+    executor_callback_t cb;    ///< Funkcja wywoływana po wykonaniu polecenia.
+    void *arg;                 ///< Argument funkcji @p cb.
+} task_t;
+
+/**
+ * @brief Struktura przechowująca stan wątku roboczego.
+ * Głowa kolejki, zapisywana przez producentów, leży w innej linii pamięci
+ * podręcznej niż pola używane tylko przez wątek roboczy.
+ */
+typedef struct worker {
+    _Alignas(CACHE_LINE) task_t *_Atomic head; ///< Ostatnio dopisane zadanie.
+    atomic_bool sleeping;      ///< Równe @p true, gdy wątek może zasnąć.
+    pthread_mutex_t mutex;     ///< Blokada chroniąca zasypianie wątku.
+    pthread_cond_t wake;       ///< Zmienna warunkowa budząca wątek.
+    _Alignas(CACHE_LINE) task_t *tail; ///< Najstarsze zadanie w kolejce.
+    task_t stub;               ///< Zadanie pomocnicze kolejki.
+    game_map_t *games;         ///< Gry należące do wątku.
+    gamma_pool_t *pool;        ///< Usunięte gry wątku do ponownego użycia.
+    bool stop;                 ///< Równe @p true, gdy wątek ma zakończyć pracę.
+    pthread_t thread;          ///< Wątek.
+    struct executor *e;        ///< Wykonawca, do którego należy wątek.
+} worker_t;
+
+/**
+ * @brief Struktura przechowująca stan wykonawcy.
+ */
+struct executor {
+    worker_t *workers;          ///< Tablica wątków roboczych.
+    uint32_t count;             ///< Liczba wątków roboczych.
+    atomic_uint_fast64_t pending; ///< Liczba niewykonanych zleconych poleceń.
+    pthread_mutex_t idle_mutex; ///< Blokada chroniąca oczekiwanie na wykonanie.
+    pthread_cond_t idle;        ///< Zmienna warunkowa sygnalizująca brak pracy.
+};
+
+/**
+ * @brief Dopisuje zadanie do kolejki wątku roboczego.
+ * @param[in,out] w – wątek roboczy,
+ * @param[in] t     – zadanie.
+ */
+static void queue_push(worker_t *w, task_t *t) {
+    atomic_store_explicit(&t->next, NULL, memory_order_relaxed);
+    task_t *prev = atomic_exchange_explicit(&w->head, t, memory_order_acq_rel);
+    atomic_store_explicit(&prev->next, t, memory_order_release);
+}
+
+/**
+ * @brief Zdejmuje zadanie z kolejki wątku roboczego.
+ * Może być wywoływana tylko przez wątek roboczy.
+ * @param[in,out] w – wątek roboczy.
+ * @return Zdjęte zadanie lub @p NULL, jeśli kolejka jest pusta albo
+ * producent nie zakończył jeszcze dopisywania zadania.
+ */
+static task_t *queue_pop(worker_t *w) {
+    task_t *tail = w->tail;
+    task_t *next = atomic_load_explicit(&tail->next, memory_order_acquire);
+    if (tail == &w->stub) {
+        if (next == NULL)
+            return NULL;
+        w->tail = next;
+        tail = next;
+        next = atomic_load_explicit(&next->next, memory_order_acquire);
+    }
+    if (next != NULL) {
+        w->tail = next;
+        return tail;
+    }
+    if (tail != atomic_load_explicit(&w->head, memory_order_acquire))
+        return NULL;
+    queue_push(w, &w->stub);
+    next = atomic_load_explicit(&tail->next, memory_order_acquire);
+    if (next != NULL) {
+        w->tail = next;
+        return tail;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Wykonuje zadanie na grze należącej do wątku roboczego.
+ * @param[in,out] w – wątek roboczy,
+ * @param[in] t     – zadanie.
+ */
+static void execute_task(worker_t *w, const task_t *t) {
+    const multi_command_t *mc = &t->mc;
+    command_result_t result = {false, 0, NULL};
+    gamma_t *g;
+    switch (mc->cmd.type) {
+        case NEW_GAME:
+            if (game_map_get(w->games, mc->game) != NULL)
+                break;
+            g = gamma_pool_get(w->pool, mc->cmd.params[0], mc->cmd.params[1],
+                               mc->cmd.params[2], mc->cmd.params[3]);
+            result.ok = g != NULL && game_map_insert(w->games, mc->game, g);
+            if (!result.ok)
+                gamma_pool_put(w->pool, g);
+            break;
+        case DELETE_GAME:
+            g = game_map_remove(w->games, mc->game);
+            result.ok = g != NULL;
+            gamma_pool_put(w->pool, g);
+            break;
+        default:
+            g = game_map_get(w->games, mc->game);
+            if (g != NULL)
+                command_execute(g, &mc->cmd, &result);
+    }
+    if (t->cb != NULL)
+        t->cb(t->arg, mc, &result);
+    free(result.board);
+}
+
+/**
+ * @brief Oznacza wykonanie zadania i budzi oczekujących na brak pracy.
+ * @param[in,out] e – wykonawca.
+ */
+static void task_done(executor_t *e) {
+    if (atomic_fetch_sub(&e->pending, 1) == 1) {
+        pthread_mutex_lock(&e->idle_mutex);
+        pthread_cond_broadcast(&e->idle);
+        pthread_mutex_unlock(&e->idle_mutex);
+    }
+}
+
+/**
+ * @brief Czeka na zadanie w kolejce wątku roboczego.
+ * Najpierw przez chwilę ponawia próby pobrania zadania, a potem zasypia.
+ * @param[in,out] w – wątek roboczy.
+ * @return Zadanie lub @p NULL, jeśli wątek ma zakończyć pracę.
+ */
+static task_t *wait_for_task(worker_t *w) {
+    for (int i = 0; i < SPIN_COUNT; i++) {
+        task_t *t = queue_pop(w);
+        if (t != NULL)
+            return t;
+    }
+    pthread_mutex_lock(&w->mutex);
+    atomic_store(&w->sleeping, true);
+    task_t *t;
+    // Producent najpierw dopisuje zadanie, a potem sprawdza flagę, więc
+    // po jej ustawieniu każde nowe zadanie jest widoczne albo wątek
+    // zostanie obudzony.
+    while ((t = queue_pop(w)) == NULL && !w->stop)
+        pthread_cond_wait(&w->wake, &w->mutex);
+    atomic_store(&w->sleeping, false);
+    pthread_mutex_unlock(&w->mutex);
+    return t;
+}
+
+/**
+ * @brief Główna pętla wątku roboczego.
+ * @param[in] arg – wskaźnik na strukturę wątku roboczego.
+ * @return Wartość @p NULL.
+ */
+static void *worker_main(void *arg) {
+    worker_t *w = arg;
+    task_t *t;
+    while ((t = wait_for_task(w)) != NULL) {
+        execute_task(w, t);
+        free(t);
+        task_done(w->e);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Budzi wątek roboczy, jeśli zasnął.
+ * @param[in,out] w – wątek roboczy.
+ */
+static void wake_worker(worker_t *w) {
+    // Dopisanie zadania musi być widoczne, zanim odczytamy flagę.
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load(&w->sleeping)) {
+        pthread_mutex_lock(&w->mutex);
+        pthread_cond_signal(&w->wake);
+        pthread_mutex_unlock(&w->mutex);
+    }
+}
+
+/**
+ * @brief Zwraca liczbę dostępnych rdzeni.
+ * @return Liczba dostępnych rdzeni, co najmniej @p 1.
+ */
+static uint32_t available_cores() {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores > 0 ? cores : 1;
+}
+
+/**
+ * @brief Przygotowuje i uruchamia wątek roboczy.
+ * @param[out] w – struktura wątku roboczego,
+ * @param[in] e  – wykonawca.
+ * @return Wartość @p true, jeśli się udało, @p false w przeciwnym przypadku
+ * (wtedy zasoby wątku zostały zwolnione).
+ */
+static bool worker_start(worker_t *w, executor_t *e) {
+    memset(w, 0, sizeof(worker_t));
+    w->e = e;
+    atomic_init(&w->head, &w->stub);
+    atomic_init(&w->stub.next, NULL);
+    atomic_init(&w->sleeping, false);
+    w->tail = &w->stub;
+    w->games = game_map_new();
+    w->pool = gamma_pool_new(GAMMA_POOL_DEFAULT_IDLE);
+    if (w->games == NULL || w->pool == NULL) {
+        game_map_delete(w->games);
+        gamma_pool_delete(w->pool);
+        return false;
+    }
+    pthread_mutex_init(&w->mutex, NULL);
+    pthread_cond_init(&w->wake, NULL);
+    if (pthread_create(&w->thread, NULL, worker_main, w) != 0) {
+        pthread_mutex_destroy(&w->mutex);
+        pthread_cond_destroy(&w->wake);
+        game_map_delete(w->games);
+        gamma_pool_delete(w->pool);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Kończy pracę wątku roboczego i zwalnia jego zasoby wraz z grami.
+ * Zakłada, że kolejka wątku jest pusta.
+ * @param[in,out] w – struktura uruchomionego wątku roboczego.
+ */
+static void worker_stop(worker_t *w) {
+    pthread_mutex_lock(&w->mutex);
+    w->stop = true;
+    pthread_cond_signal(&w->wake);
+    pthread_mutex_unlock(&w->mutex);
+    pthread_join(w->thread, NULL);
+    pthread_mutex_destroy(&w->mutex);
+    pthread_cond_destroy(&w->wake);
+    game_map_delete(w->games);
+    gamma_pool_delete(w->pool);
+}
+
+executor_t *executor_new(uint32_t workers) {
+    if (workers == 0)
+        workers = available_cores();
+    executor_t *e = malloc(sizeof(executor_t));
+    if (e == NULL)
+        return NULL;
+    e->workers = aligned_alloc(CACHE_LINE, workers * sizeof(worker_t));
+    if (e->workers == NULL) {
+        free(e);
+        return NULL;
+    }
+    atomic_init(&e->pending, 0);
+    pthread_mutex_init(&e->idle_mutex, NULL);
+    pthread_cond_init(&e->idle, NULL);
+    for (e->count = 0; e->count < workers; e->count++) {
+        if (!worker_start(&e->workers[e->count], e)) {
+            executor_delete(e);
+            return NULL;
+        }
+    }
+    return e;
+}
+
+void executor_delete(executor_t *e) {
+    if (e == NULL)
+        return;
+    executor_wait(e);
+    for (uint32_t i = 0; i < e->count; i++)
+        worker_stop(&e->workers[i]);
+    pthread_mutex_destroy(&e->idle_mutex);
+    pthread_cond_destroy(&e->idle);
+    free(e->workers);
+    free(e);
+}
+
+uint32_t executor_workers(const executor_t *e) {
+    return e->count;
+}
+
+uint32_t executor_shard(const executor_t *e, uint32_t game) {
+    return ((game * HASH_MULTIPLIER) >> 32) % e->count;
+}
+
+bool executor_submit(executor_t *e, const multi_command_t *mc,
+                     executor_callback_t cb, void *arg) {
+    task_t *t = malloc(sizeof(task_t));
+    if (t == NULL)
+        return false;
+    t->mc = *mc;
+    t->cb = cb;
+    t->arg = arg;
+    worker_t *w = &e->workers[executor_shard(e, mc->game)];
+    atomic_fetch_add(&e->pending, 1);
+    queue_push(w, t);
+    wake_worker(w);
+    return true;
+}
+
+void executor_wait(executor_t *e) {
+    pthread_mutex_lock(&e->idle_mutex);
+    while (atomic_load(&e->pending) > 0)
+        pthread_cond_wait(&e->idle, &e->idle_mutex);
+    pthread_mutex_unlock(&e->idle_mutex);
+}
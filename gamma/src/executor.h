@@ -0,0 +1,100 @@
+/** @file
+ * Interfejs wielowątkowego wykonawcy poleceń dla wielu gier.
+ *
+ * Wykonawca posiada @p n wątków roboczych (domyślnie po jednym na rdzeń).
+ * Każda gra, identyfikowana liczbą typu @p uint32_t, przypisana jest na
+ * stałe do jednego wątku (jego części, ang. shard) na podstawie skrótu
+ * identyfikatora i tylko ten wątek ją odczytuje i modyfikuje, więc gry nie
+ * wymagają blokad. Polecenia trafiają do wątku przez jego kolejkę
+ * wielu producentów i jednego konsumenta, bez blokad po stronie
+ * zlecającego. Polecenia zlecone przez jeden wątek dla jednej gry są
+ * wykonywane w kolejności zlecenia.
+ *
+ * Polecenia mają postać poleceń trybu wielu gier (patrz
+ * @ref multi_command_t): @ref NEW_GAME tworzy grę, @ref DELETE_GAME ją
+ * usuwa, a pozostałe wywołują odpowiednie funkcje z gamma.h.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#ifndef GAMMA_EXECUTOR_H
+#define GAMMA_EXECUTOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "command.h"
+
+/**
+ * Struktura przechowująca stan wykonawcy.
+ */
+typedef struct executor executor_t;
+
+/**
+ * @brief Funkcja wywoływana po wykonaniu polecenia.
+ * Wywoływana jest na wątku roboczym, do którego należy gra, więc nie
+ * powinna długo działać. Napis @p result->board jest zwalniany po jej
+ * zakończeniu. Dla poleceń @ref NEW_GAME i @ref DELETE_GAME wartość
+ * @p result->ok mówi, czy polecenie się powiodło; dla pozostałych jest
+ * równa @p false także wtedy, gdy gra nie istnieje.
+ * @param[in] arg    – argument podany przy zleceniu polecenia,
+ * @param[in] mc     – wykonane polecenie,
+ * @param[in] result – wynik polecenia.
+ */
+typedef void (*executor_callback_t)(void *arg, const multi_command_t *mc,
+                                    const command_result_t *result);
+
+/**
+ * @brief Tworzy wykonawcę i uruchamia jego wątki robocze.
+ * @param[in] workers – liczba wątków roboczych, wartość @p 0 oznacza
+ *                      liczbę dostępnych rdzeni.
+ * @return Wskaźnik na utworzonego wykonawcę lub @p NULL, gdy nie udało się
+ * zaalokować pamięci lub uruchomić wątków.
+ */
+executor_t *executor_new(uint32_t workers);
+
+/**
+ * @brief Czeka na wykonanie wszystkich zleconych poleceń, kończy wątki
+ * robocze i usuwa wykonawcę wraz ze wszystkimi grami.
+ * Nic nie robi, jeśli wskaźnik ma wartość @p NULL.
+ * @param[in] e – wskaźnik na usuwanego wykonawcę.
+ */
+void executor_delete(executor_t *e);
+
+/**
+ * @brief Zwraca liczbę wątków roboczych.
+ * @param[in] e – wskaźnik na wykonawcę, różny od @p NULL.
+ * @return Liczba wątków roboczych.
+ */
+uint32_t executor_workers(const executor_t *e);
+
+/**
+ * @brief Zwraca numer wątku roboczego, do którego należy gra.
+ * @param[in] e    – wskaźnik na wykonawcę, różny od @p NULL,
+ * @param[in] game – identyfikator gry.
+ * @return Numer wątku, liczba mniejsza niż @ref executor_workers.
+ */
+uint32_t executor_shard(const executor_t *e, uint32_t game);
+
+/**
+ * @brief Zleca wykonanie polecenia.
+ * Funkcja może być wywoływana jednocześnie z wielu wątków.
+ * @param[in,out] e  – wskaźnik na wykonawcę, różny od @p NULL,
+ * @param[in] mc     – polecenie o poprawnym pierwszym znaku,
+ * @param[in] cb     – funkcja wywoływana po wykonaniu polecenia lub
+ *                     @p NULL, jeśli wynik nie jest potrzebny,
+ * @param[in] arg    – argument przekazywany funkcji @p cb.
+ * @return Wartość @p true, jeśli polecenie zostało zlecone, @p false, jeśli
+ * nie udało się zaalokować pamięci.
+ */
+bool executor_submit(executor_t *e, const multi_command_t *mc,
+                     executor_callback_t cb, void *arg);
+
+/**
+ * @brief Czeka, aż wszystkie zlecone dotąd polecenia zostaną wykonane.
+ * @param[in,out] e – wskaźnik na wykonawcę, różny od @p NULL.
+ */
+void executor_wait(executor_t *e);
+
+#endif //GAMMA_EXECUTOR_H
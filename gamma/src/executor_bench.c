@@ -0,0 +1,173 @@
+/** @file
+ * Pomiar skalowania wykonawcy poleceń (patrz executor.h).
+ *
+ * Dla kolejnych liczb wątków roboczych (1, 2, 4, ... aż do @p max_workers)
+ * program tworzy @p games gier i zleca w każdej z nich @p moves
+ * pseudolosowych ruchów. Ruchy zlecają równolegle wątki producentów, po
+ * jednym na wątek roboczy, każdy dla swojej części gier, więc do każdej
+ * kolejki piszą wszyscy producenci. Wypisuje łączną liczbę ruchów na sekundę
+ * i przyspieszenie względem jednego wątku roboczego.
+ *
+ * Wywołanie: @p gamma_executor_bench [@p games [@p moves
+ * [@p max_workers]]].
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#define _GNU_SOURCE ///< Makro potrzebne do prawidłowej kompilacji.
+
+#include "executor.h"
+#include "int_to_string_util.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_GAMES 1024 ///< Domyślna liczba gier.
+#define DEFAULT_MOVES 2000 ///< Domyślna liczba ruchów w grze.
+#define BOARD_SIZE 64 ///< Wymiar planszy każdej gry.
+#define PLAYERS 4 ///< Liczba graczy w każdej grze.
+#define AREAS (BOARD_SIZE * BOARD_SIZE) ///< Maksymalna liczba obszarów gracza.
+
+/**
+ * @brief Struktura przechowująca zadanie wątku producenta.
+ */
+typedef struct producer {
+    pthread_t thread; ///< Wątek.
+    executor_t *e;    ///< Wykonawca.
+    uint32_t first;   ///< Pierwsza gra producenta.
+    uint32_t step;    ///< Odstęp pomiędzy grami producenta.
+    uint32_t games;   ///< Liczba wszystkich gier.
+    uint32_t moves;   ///< Liczba ruchów w grze.
+} producer_t;
+
+/**
+ * @brief Generator liczb pseudolosowych (xorshift64).
+ * @param[in,out] state – stan generatora, różny od @p 0.
+ * @return Kolejna liczba pseudolosowa.
+ */
+static uint64_t next_random(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *state = x;
+}
+
+/**
+ * @brief Zwraca bieżący czas w nanosekundach.
+ * @return Czas zegara monotonicznego w nanosekundach.
+ */
+static uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/**
+ * @brief Główna funkcja wątku producenta.
+ * Zleca ruchy w swoich grach na przemian, po jednym w każdej grze.
+ * @param[in] arg – wskaźnik na zadanie producenta.
+ * @return Wartość @p NULL.
+ */
+static void *producer_main(void *arg) {
+    producer_t *p = arg;
+    uint64_t state = p->first + 1;
+    multi_command_t mc = {0, {'m', {0}}};
+    for (uint32_t i = 0; i < p->moves; i++) {
+        for (uint32_t game = p->first; game < p->games; game += p->step) {
+            uint64_t r = next_random(&state);
+            mc.game = game;
+            mc.cmd.params[0] = r % PLAYERS + 1;
+            mc.cmd.params[1] = (r >> 16) % BOARD_SIZE;
+            mc.cmd.params[2] = (r >> 32) % BOARD_SIZE;
+            while (!executor_submit(p->e, &mc, NULL, NULL));
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Mierzy przepustowość wykonawcy o danej liczbie wątków roboczych.
+ * @param[in] workers – liczba wątków roboczych,
+ * @param[in] games   – liczba gier,
+ * @param[in] moves   – liczba ruchów w grze.
+ * @return Czas wykonania wszystkich ruchów w nanosekundach lub @p 0, jeśli
+ * nie udało się przeprowadzić pomiaru.
+ */
+static uint64_t measure(uint32_t workers, uint32_t games, uint32_t moves) {
+    executor_t *e = executor_new(workers);
+    producer_t *producers = calloc(workers, sizeof(producer_t));
+    if (e == NULL || producers == NULL) {
+        executor_delete(e);
+        free(producers);
+        return 0;
+    }
+    multi_command_t mc = {0, {NEW_GAME, {BOARD_SIZE, BOARD_SIZE, PLAYERS, AREAS}}};
+    for (mc.game = 0; mc.game < games; mc.game++)
+        executor_submit(e, &mc, NULL, NULL);
+    executor_wait(e);
+
+    uint64_t start = now_ns();
+    for (uint32_t i = 0; i < workers; i++) {
+        producers[i] = (producer_t) {0, e, i, workers, games, moves};
+        pthread_create(&producers[i].thread, NULL, producer_main, &producers[i]);
+    }
+    for (uint32_t i = 0; i < workers; i++)
+        pthread_join(producers[i].thread, NULL);
+    executor_wait(e);
+    uint64_t elapsed = now_ns() - start;
+
+    executor_delete(e);
+    free(producers);
+    return elapsed;
+}
+
+/**
+ * @brief Wyznacza kolejną mierzoną liczbę wątków roboczych.
+ * @param[in] workers     – ostatnio mierzona liczba wątków,
+ * @param[in] max_workers – największa mierzona liczba wątków.
+ * @return Podwojona liczba wątków, ale nie więcej niż @p max_workers, chyba
+ * że @p workers jest już równe @p max_workers.
+ */
+static uint32_t next_workers(uint32_t workers, uint32_t max_workers) {
+    if (workers < max_workers && workers * 2 > max_workers)
+        return max_workers;
+    return workers * 2;
+}
+
+int main(int argc, char *argv[]) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    uint64_t games = DEFAULT_GAMES, moves = DEFAULT_MOVES;
+    uint64_t max_workers = cores > 0 ? cores : 1;
+    bool ok = argc <= 4;
+    if (ok && argc > 1)
+        ok = parse_number(argv[1], UINT32_MAX, &games);
+    if (ok && argc > 2)
+        ok = parse_number(argv[2], UINT32_MAX, &moves);
+    if (ok && argc > 3)
+        ok = parse_number(argv[3], UINT32_MAX, &max_workers);
+    if (!ok || games == 0 || moves == 0 || max_workers == 0) {
+        fprintf(stderr, "usage: %s [games [moves [max_workers]]]\n", argv[0]);
+        return 1;
+    }
+
+    double base = 0;
+    uint64_t total = (uint64_t) games * moves;
+    for (uint32_t workers = 1; workers <= max_workers;
+         workers = next_workers(workers, max_workers)) {
+        uint64_t ns = measure(workers, games, moves);
+        if (ns == 0) {
+            fprintf(stderr, "cannot start %u workers\n", workers);
+            return 1;
+        }
+        double rate = total * 1e9 / ns;
+        if (base == 0)
+            base = rate;
+        printf("workers %3u %12.0f moves/s speedup %5.2f\n", workers, rate, rate / base);
+    }
+    return 0;
+}
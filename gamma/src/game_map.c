@@ -0,0 +1,150 @@
+/** @file
+ * Zawiera implementację interfejsu game_map.h
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#include "game_map.h"
+#include <stdlib.h>
+
+#define INITIAL_CAPACITY_LOG 4 ///< Logarytm o podstawie 2 z początkowego rozmiaru tablicy.
+#define HASH_MULTIPLIER 0x9E3779B97F4A7C15ull ///< Mnożnik haszowania Fibonacciego.
+
+/**
+ * @brief Struktura przechowująca element tablicy haszującej.
+ * Element jest pusty, jeśli wskaźnik na grę ma wartość @p NULL.
+ */
+typedef struct entry {
+    uint32_t id; ///< Identyfikator gry.
+    gamma_t *g;  ///< Wskaźnik na grę.
+} entry_t;
+
+/**
+ * @brief Struktura przechowująca słownik gier.
+ */
+struct game_map {
+    entry_t *entries;      ///< Tablica haszująca.
+    uint32_t capacity_log; ///< Logarytm o podstawie 2 z rozmiaru tablicy.
+    uint64_t size;         ///< Liczba gier w słowniku.
+};
+
+/**
+ * @brief Wylicza indeks, od którego zaczyna się próbkowanie dla
+ * identyfikatora.
+ * @param[in] id           – identyfikator gry,
+ * @param[in] capacity_log – logarytm o podstawie 2 z rozmiaru tablicy.
+ * @return Indeks w tablicy.
+ */
+static uint64_t home_index(uint32_t id, uint32_t capacity_log) {
+    return (id * HASH_MULTIPLIER) >> (64 - capacity_log);
+}
+
+/**
+ * @brief Zwraca maskę indeksów tablicy.
+ * @param[in] m – wskaźnik na słownik.
+ * @return Rozmiar tablicy pomniejszony o @p 1.
+ */
+static uint64_t index_mask(const game_map_t *m) {
+    return ((uint64_t) 1 << m->capacity_log) - 1;
+}
+
+/**
+ * @brief Znajduje indeks elementu o danym identyfikatorze lub pierwszego
+ * pustego elementu w jego ciągu próbkowania.
+ * @param[in] m  – wskaźnik na słownik,
+ * @param[in] id – identyfikator gry.
+ * @return Indeks w tablicy.
+ */
+static uint64_t find_slot(const game_map_t *m, uint32_t id) {
+    uint64_t mask = index_mask(m);
+    uint64_t i = home_index(id, m->capacity_log);
+    while (m->entries[i].g != NULL && m->entries[i].id != id)
+        i = (i + 1) & mask;
+    return i;
+}
+
+game_map_t *game_map_new() {
+    game_map_t *m = malloc(sizeof(game_map_t));
+    if (m == NULL)
+        return NULL;
+    m->capacity_log = INITIAL_CAPACITY_LOG;
+    m->size = 0;
+    m->entries = calloc((uint64_t) 1 << m->capacity_log, sizeof(entry_t));
+    if (m->entries == NULL) {
+        free(m);
+        return NULL;
+    }
+    return m;
+}
+
+void game_map_delete(game_map_t *m) {
+    if (m == NULL)
+        return;
+    uint64_t capacity = (uint64_t) 1 << m->capacity_log;
+    for (uint64_t i = 0; i < capacity; i++)
+        gamma_delete(m->entries[i].g);
+    free(m->entries);
+    free(m);
+}
+
+gamma_t *game_map_get(const game_map_t *m, uint32_t id) {
+    return m->entries[find_slot(m, id)].g;
+}
+
+/**
+ * @brief Podwaja rozmiar tablicy haszującej.
+ * @param[in,out] m – wskaźnik na słownik.
+ * @return Wartość @p true, jeśli się udało, @p false, jeśli nie udało się
+ * zaalokować pamięci (wtedy słownik nie zmienia się).
+ */
+static bool grow(game_map_t *m) {
+    entry_t *old = m->entries;
+    uint64_t old_capacity = (uint64_t) 1 << m->capacity_log;
+    entry_t *entries = calloc(old_capacity * 2, sizeof(entry_t));
+    if (entries == NULL)
+        return false;
+    m->entries = entries;
+    m->capacity_log++;
+    for (uint64_t i = 0; i < old_capacity; i++)
+        if (old[i].g != NULL)
+            m->entries[find_slot(m, old[i].id)] = old[i];
+    free(old);
+    return true;
+}
+
+bool game_map_insert(game_map_t *m, uint32_t id, gamma_t *g) {
+    // Tablica jest zapełniona co najwyżej w trzech czwartych.
+    if ((m->size + 1) * 4 > ((uint64_t) 3 << m->capacity_log) && !grow(m))
+        return false;
+    entry_t *e = &m->entries[find_slot(m, id)];
+    e->id = id;
+    e->g = g;
+    m->size++;
+    return true;
+}
+
+gamma_t *game_map_remove(game_map_t *m, uint32_t id) {
+    uint64_t mask = index_mask(m);
+    uint64_t hole = find_slot(m, id);
+    gamma_t *g = m->entries[hole].g;
+    if (g == NULL)
+        return NULL;
+    // Przesuwamy w miejsce usuniętego elementu kolejne elementy ciągu,
+    // których próbkowanie zaczyna się nie później niż w tym miejscu.
+    for (uint64_t i = (hole + 1) & mask; m->entries[i].g != NULL; i = (i + 1) & mask) {
+        uint64_t home = home_index(m->entries[i].id, m->capacity_log);
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            m->entries[hole] = m->entries[i];
+            hole = i;
+        }
+    }
+    m->entries[hole].g = NULL;
+    m->size--;
+    return g;
+}
+
+uint64_t game_map_size(const game_map_t *m) {
+    return m->size;
+}
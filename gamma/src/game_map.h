@@ -0,0 +1,77 @@
+/** @file
+ * Interfejs klasy przechowującej gry według ich identyfikatorów.
+ * Słownik jest tablicą haszującą z adresowaniem otwartym i liniowym
+ * próbkowaniem, więc wyszukiwanie gry to zwykle jeden lub dwa odczyty
+ * z ciągłej tablicy. Usuwanie przesuwa kolejne elementy ciągu próbkowania,
+ * więc tablica nie zawiera znaczników usuniętych elementów.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#ifndef GAMMA_GAME_MAP_H
+#define GAMMA_GAME_MAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "gamma.h"
+
+/**
+ * Struktura przechowująca słownik gier.
+ */
+typedef struct game_map game_map_t;
+
+/**
+ * @brief Tworzy pusty słownik gier.
+ * @return Wskaźnik na utworzony słownik lub @p NULL, gdy nie udało się
+ * zaalokować pamięci.
+ */
+game_map_t *game_map_new();
+
+/**
+ * @brief Usuwa słownik wraz ze wszystkimi przechowywanymi w nim grami.
+ * Nic nie robi, jeśli wskaźnik ma wartość @p NULL.
+ * @param[in] m – wskaźnik na usuwany słownik.
+ */
+void game_map_delete(game_map_t *m);
+
+/**
+ * @brief Wyszukuje grę o danym identyfikatorze.
+ * @param[in] m  – wskaźnik na słownik, różny od @p NULL,
+ * @param[in] id – identyfikator gry.
+ * @return Wskaźnik na grę lub @p NULL, jeśli w słowniku nie ma gry
+ * o identyfikatorze @p id.
+ */
+gamma_t *game_map_get(const game_map_t *m, uint32_t id);
+
+/**
+ * @brief Dodaje grę do słownika.
+ * Zakłada, że w słowniku nie ma gry o identyfikatorze @p id. Od tej chwili
+ * słownik jest właścicielem gry.
+ * @param[in,out] m – wskaźnik na słownik, różny od @p NULL,
+ * @param[in] id    – identyfikator gry,
+ * @param[in] g     – wskaźnik na grę, różny od @p NULL.
+ * @return Wartość @p true, jeśli gra została dodana, @p false, jeśli nie
+ * udało się zaalokować pamięci.
+ */
+bool game_map_insert(game_map_t *m, uint32_t id, gamma_t *g);
+
+/**
+ * @brief Usuwa grę ze słownika, nie zwalniając jej.
+ * @param[in,out] m – wskaźnik na słownik, różny od @p NULL,
+ * @param[in] id    – identyfikator gry.
+ * @return Wskaźnik na usuniętą grę, której właścicielem staje się
+ * wywołujący, lub @p NULL, jeśli w słowniku nie było gry o identyfikatorze
+ * @p id.
+ */
+gamma_t *game_map_remove(game_map_t *m, uint32_t id);
+
+/**
+ * @brief Zwraca liczbę gier w słowniku.
+ * @param[in] m – wskaźnik na słownik, różny od @p NULL.
+ * @return Liczba gier.
+ */
+uint64_t game_map_size(const game_map_t *m);
+
+#endif //GAMMA_GAME_MAP_H
@@ -14,6 +14,7 @@
 #include "field.h"
 #include "stack.h"
 #include "int_to_string_util.h"
+#include "trace.h"
 
 #define NO_PLAYER 0  ///< Reprezentuje brak gracza.
 #define DIRECTIONS 4 ///< Maksymalna liczba sąsiadów, jaką może posiadać pole.
@@ -22,8 +23,21 @@
 #define UINT_64_SIZE sizeof(uint64_t) ///< Rozmiar zmiennej typu @p uint64_t
 #define UINT_32_SIZE sizeof(uint32_t) ///< Rozmiar zmiennej typu @p uint32_t
 
+#ifdef GAMMA_STATS
+/** @brief Zwiększa licznik statystyk gry.
+ * Bez makra @p GAMMA_STATS nie robi nic.
+ */
+#define STAT_ADD(g, counter, n) ((g)->stats.counter += (n))
+#else
+#define STAT_ADD(g, counter, n) ((void) 0) ///< Pusta wersja makra zwiększającego licznik.
+#endif
+
 #define NO_PLAYER_CHAR '.' ///< Znak reprezentujący niezajęte pole w napisowej reprezentacji planszy.
 #define SPACE ' ' ///< Znak spacji.
+#define MAX_PLAYER_DIGITS 10 ///< Maksymalna liczba cyfr numeru gracza.
+#define DFS_STACK_MIN_SIZE 16 /**< Początkowy i najmniejszy maksymalny rozmiar
+                               * stosu przeszukiwań planszy.
+                               */
 
 static const int x_dir[DIRECTIONS] = {0, 1, 0, -1}; /**< Pomocnicza tablica
                                                      * pomagająca szukać numerów
@@ -47,8 +61,22 @@ typedef struct m_player {
                                   * zajmowane przez gracza.
                                   */
     uint64_t busy_fields;        ///< Liczba pól zajętych przez gracza.
+    uint64_t frontier;           /**< Liczba wolnych pól sąsiadujących
+                                  * z co najmniej jednym polem gracza,
+                                  * czyli liczba pól, na które gracz
+                                  * z maksymalną liczbą obszarów może
+                                  * postawić pionek.
+                                  */
 } player_t;
 
+/** @brief Struktura opisująca przedział wierszy kolumny planszy.
+ * Przedział jest pusty, jeśli @p low jest równe @p high.
+ */
+typedef struct span {
+    uint32_t low;  ///< Pierwszy wiersz przedziału.
+    uint32_t high; ///< Wiersz tuż za ostatnim wierszem przedziału.
+} span_t;
+
 /** @struct gamma gamma.h
  * @brief Struktura przechowująca stan gry.
  * Przechowuje informacje o wymiarach planszy, liczbie graczy,
@@ -76,18 +104,30 @@ struct gamma {
                              * funkcji @ref gamma_new.
                              */
     uint64_t empty_fields;  ///< Liczba niezajętych pól na planszy.
+    uint32_t players_by_digits[MAX_PLAYER_DIGITS + 1]; /**< @brief Liczby
+                             * graczy zajmujących co najmniej jedno pole.
+                             * Element o indeksie @p d jest równy liczbie
+                             * takich graczy o @p d-cyfrowych numerach;
+                             * pozwala wyznaczyć szerokość pola w
+                             * @ref gamma_board bez przeglądania graczy.
+                             */
     player_t *players;      /**< @brief Tablica graczy.
                              * Wskaźnik na pierwszy element tablicy w której
                              * element o indeksie @p i reprezentuje gracza
                              * o @p i @p + @p 1-szym numerze.
                              */
-    uint32_t **player_arr;     /**< @brief Pamięta który gracz zajmuje dane pole.
-                             * Dynamiczna tablica dwuwymiarowa o wymiarach
-                             * [@p width][@p height], w której komórka
-                             * [@p x][@p y] jest równa numerowi gracza,
-                             * którego pionek zajmuje pole (@p x, @p y), lub
-                             * @ref NO_PLAYER, jeśli pole
-                             * nie jest zajęte przez żadnego gracza.
+    void *owners;           /**< @brief Pamięta który gracz zajmuje dane pole.
+                             * Tablica @p width @p * @p height komórek
+                             * rozmiaru @p owner_size, w której komórka
+                             * o indeksie @p x @p * @p height @p + @p y jest
+                             * równa numerowi gracza, którego pionek zajmuje
+                             * pole (@p x, @p y), lub @ref NO_PLAYER, jeśli
+                             * pole nie jest zajęte przez żadnego gracza.
+                             */
+    uint8_t owner_size;     /**< @brief Rozmiar komórki tablicy @p owners
+                             * w bajtach: najmniejszy z @p 1, @p 2 i @p 4,
+                             * w którym mieści się numer każdego gracza
+                             * (patrz @ref owner_size_for).
                              */
     field_t **parents;      /**< @brief Tablica reprezentantów obszarów.
                              * Dynamiczna tablica dwuwymiarowa o wymiarach
@@ -114,13 +154,53 @@ struct gamma {
                              * reprezentantem żadnego obszaru, wartość
                              * @p areas_size[x][y] jest równa 0.
                              */
-    int **visited;          /**< @brief Tablica pomocnicza używana przy
+    uint32_t **visited;     /**< @brief Tablica pomocnicza używana przy
 						     * przeszukiwaniu planszy. Używana w @ref delete_util.
+                             * Pole (@p x, @p y) jest odwiedzone w bieżącym
+                             * przeszukiwaniu, jeśli @p visited[x][y] jest
+                             * równe @p visit_epoch, więc znaczników nie
+                             * trzeba czyścić po przeszukiwaniu.
+                             */
+    uint32_t visit_epoch;   /**< @brief Numer bieżącego przeszukiwania
+                             * w @ref delete_util, zwiększany przed każdym
+                             * przeszukiwaniem. Po przepełnieniu tablica
+                             * @p visited jest zerowana.
                              */
     stack_t *stack;         /**< @brief Wskaźnik na strukturę reprezentującą stos
                              * struktur reprezentujących pola na planszy.
                              * Używany przy przeszukiwaniu planszy algorytmem DFS.
+                             * Przed przeszukiwaniem jest powiększany do
+                             * rozmiaru przeszukiwanego obszaru, a po złotym
+                             * ruchu i po @ref gamma_golden_possible
+                             * zmniejszany przez @ref stack_shrink.
+                             */
+    uint32_t players_capacity; /**< @brief Liczba graczy, dla których
+                             * zaalokowano tablicę @p players; może być
+                             * większa od @p num_of_players po
+                             * @ref gamma_reset.
+                             */
+    span_t *dirty;          /**< @brief Zmienione wiersze kolumn.
+                             * Tablica @p width przedziałów; przedział
+                             * o indeksie @p x obejmuje wszystkie pola
+                             * kolumny @p x, które od utworzenia gry lub
+                             * ostatniego @ref gamma_reset były zajęte,
+                             * czyli wszystkie komórki tablic planszy
+                             * różniące się od stanu początkowego.
+                             */
+    uint32_t *dirty_columns; /**< @brief Lista kolumn o niepustym
+                             * przedziale w @p dirty.
+                             */
+    uint32_t num_dirty_columns; ///< Długość listy @p dirty_columns.
+    const gamma_allocator_t *allocator; /**< @brief Alokator, którym
+                             * zaalokowana jest cała pamięć gry, lub @p NULL
+                             * dla funkcji biblioteki standardowej.
                              */
+#ifdef GAMMA_STATS
+    gamma_stats_t stats;    /**< @brief Liczniki operacji silnika.
+                             * Pola @p stack_resizes i @p stack_shrinks są
+                             * odczytywane ze stosu.
+                             */
+#endif
 };
 
 /** @brief Sprawdza, czy współrzędne pola i
@@ -157,8 +237,66 @@ static bool wrong_player(uint32_t player, gamma_t *g) {
     return g == NULL || g->num_of_players < player || player < 1;
 }
 
+/** @brief Wybiera rozmiar komórki tablicy właścicieli pól.
+ * @param[in] players – liczba graczy.
+ * @return Najmniejszy rozmiar w bajtach (@p 1, @p 2 lub @p 4), w którym
+ * mieści się numer każdego z @p players graczy.
+ */
+static uint8_t owner_size_for(uint32_t players) {
+    if (players <= UINT8_MAX)
+        return sizeof(uint8_t);
+    if (players <= UINT16_MAX)
+        return sizeof(uint16_t);
+    return sizeof(uint32_t);
+}
+
+/** @brief Zwraca numer gracza zajmującego pole.
+ * Pętle przeglądające wiele pól korzystają z wersji z owner_loops.h,
+ * w których rozmiar komórki jest znany przy kompilacji.
+ * @param[in] g – wskaźnik na strukturę reprezentującą stan gry,
+ *                różny od @p NULL,
+ * @param[in] x – numer kolumny, liczba nieujemna mniejsza od @p g->width,
+ * @param[in] y – numer wiersza, liczba nieujemna mniejsza od @p g->height.
+ * @return Numer gracza zajmującego pole (@p x, @p y) lub @ref NO_PLAYER.
+ */
+static inline uint32_t owner_at(gamma_t *g, uint32_t x, uint32_t y) {
+    uint64_t i = (uint64_t) x * g->height + y;
+    switch (g->owner_size) {
+        case sizeof(uint8_t):
+            return ((const uint8_t *) g->owners)[i];
+        case sizeof(uint16_t):
+            return ((const uint16_t *) g->owners)[i];
+        default:
+            return ((const uint32_t *) g->owners)[i];
+    }
+}
+
+/** @brief Zapisuje numer gracza zajmującego pole.
+ * @param[in,out] g  – wskaźnik na strukturę reprezentującą stan gry,
+ *                     różny od @p NULL,
+ * @param[in] x      – numer kolumny, liczba nieujemna mniejsza od
+ *                     @p g->width,
+ * @param[in] y      – numer wiersza, liczba nieujemna mniejsza od
+ *                     @p g->height,
+ * @param[in] player – numer gracza niewiększy od @p g->num_of_players
+ *                     lub @ref NO_PLAYER.
+ */
+static inline void set_owner(gamma_t *g, uint32_t x, uint32_t y, uint32_t player) {
+    uint64_t i = (uint64_t) x * g->height + y;
+    switch (g->owner_size) {
+        case sizeof(uint8_t):
+            ((uint8_t *) g->owners)[i] = player;
+            break;
+        case sizeof(uint16_t):
+            ((uint16_t *) g->owners)[i] = player;
+            break;
+        default:
+            ((uint32_t *) g->owners)[i] = player;
+    }
+}
+
 /** @brief Sprawdza, czy pole nie należy do żadnego gracza.
-* Sprawdza wartość @p g->player_arr dla pola o współrzędnych
+* Sprawdza wartość @p g->owners dla pola o współrzędnych
 * (@p x, @p y).
 * @param[in] x 	– numer kolumny, liczba nieujemna, mniejsza od
 * 			      @p g->width,
@@ -166,27 +304,29 @@ static bool wrong_player(uint32_t player, gamma_t *g) {
 * 				  @p g->height,
 * @param[in] g  – wskaźnik na strukturę przechowującą stan gry,
 * 				  różny od @p NULL.
-* @return Wartość @p true, jeśli wartość @p g->player_arr dla pola o współrzędnych
+* @return Wartość @p true, jeśli wartość @p g->owners dla pola o współrzędnych
 * (@p x, @p y) jest równa @p NO_PLAYER, @p false w przeciwnym przypadku.
 */
 static bool no_field(uint32_t x, uint32_t y, gamma_t *g) {
-    return g->player_arr[x][y] == NO_PLAYER;
+    return owner_at(g, x, y) == NO_PLAYER;
 }
 
 /** @brief Tworzy stos.
  * Rezerwuje pamięć dla stosu o maksymalnym rozmiarze
- * równym ilości pól na planszy w grze, której stan reprezentowany
+ * @ref DFS_STACK_MIN_SIZE dla gry, której stan reprezentowany
  * jest przez strukturę wskazywaną
  * przez @p g. Ustawia wskaźnik @p g->stack na ten stos.
+ * Przeszukiwania planszy wstawiają na stos każde pole przeszukiwanego
+ * obszaru co najwyżej raz, więc przed przeszukiwaniem wystarczy
+ * powiększyć stos do rozmiaru obszaru (@ref reserve_dfs_stack); wtedy
+ * @ref stack_push zawsze się udaje.
  * @param[in] g – wskaźnik na strukturę reprezentujacą stan gry,
  *                różny od @p NULL.
  * @return Wartość @p true, jeśli udało się zaalokować pamięć,
  * @p false w przeciwnym przypadku.
  */
 static bool init_m_stack(gamma_t *g) {
-    uint64_t stack_max_size = g->width;
-    stack_max_size *= g->height;
-    g->stack = init_stack(stack_max_size);
+    g->stack = init_stack(g->allocator, DFS_STACK_MIN_SIZE);
     if (g->stack == NULL)
         return false;
     return true;
@@ -200,42 +340,63 @@ static bool init_m_stack(gamma_t *g) {
  */
 static void set_pointers_to_NULL(gamma_t *g) {
     g->players = NULL;
+    g->dirty = NULL;
+    g->dirty_columns = NULL;
     g->parents = NULL;
-    g->player_arr = NULL;
+    g->owners = NULL;
     g->visited = NULL;
     g->stack = NULL;
     g->areas_size = NULL;
 }
 
 gamma_t *gamma_new(uint32_t width, uint32_t height, uint32_t players, uint32_t areas) {
+    return gamma_new_with_allocator(width, height, players, areas, NULL);
+}
+
+gamma_t *gamma_new_with_allocator(uint32_t width, uint32_t height,
+                                  uint32_t players, uint32_t areas,
+                                  const gamma_allocator_t *allocator) {
     if (width < 1 || height < 1 || players < 1 || areas < 1)
         return NULL;
 
     gamma_t *g = NULL;
-    g = malloc(sizeof(struct gamma));
+    g = mem_alloc(allocator, sizeof(struct gamma));
     if (g == NULL)
         return NULL;
+    g->allocator = allocator;
     g->max_num_of_areas = areas;
     g->width = width;
     g->height = height;
     g->num_of_players = players;
+    g->players_capacity = players;
+    g->num_dirty_columns = 0;
+    g->visit_epoch = 0;
     g->empty_fields = width;
     g->empty_fields *= height;
+    memset(g->players_by_digits, 0, sizeof(g->players_by_digits));
+#ifdef GAMMA_STATS
+    memset(&g->stats, 0, sizeof(gamma_stats_t));
+#endif
 
     set_pointers_to_NULL(g);
     bool is_ok = true;
-    if (!init_arr_2D((void ***) &g->parents, FIELD_SIZE, width, height))
+    if (!init_arr_2D(allocator, (void ***) &g->parents, FIELD_SIZE, width, height))
         is_ok = false;
-    if (!init_array_1D((void **) &g->players, PLAYER_SIZE, players))
+    if (!init_array_1D(allocator, (void **) &g->players, PLAYER_SIZE, players))
         is_ok = false;
-    if (!init_arr_2D((void ***) &g->player_arr, UINT_32_SIZE, width, height))
+    g->owner_size = owner_size_for(players);
+    if (!init_array_1D(allocator, &g->owners, g->owner_size, (uint64_t) width * height))
         is_ok = false;
-    if (!init_arr_2D((void ***) &g->areas_size, UINT_64_SIZE, width, height))
+    if (!init_arr_2D(allocator, (void ***) &g->areas_size, UINT_64_SIZE, width, height))
         is_ok = false;
-    if (!init_arr_2D((void ***) &g->visited, sizeof(int), width, height))
+    if (!init_arr_2D(allocator, (void ***) &g->visited, UINT_32_SIZE, width, height))
         is_ok = false;
     if (!init_m_stack(g))
         is_ok = false;
+    if (!init_array_1D(allocator, (void **) &g->dirty, sizeof(span_t), width))
+        is_ok = false;
+    if (!init_array_1D(allocator, (void **) &g->dirty_columns, UINT_32_SIZE, width))
+        is_ok = false;
     if (!is_ok) {
         gamma_delete(g);
         return NULL;
@@ -243,12 +404,154 @@ gamma_t *gamma_new(uint32_t width, uint32_t height, uint32_t players, uint32_t a
     return g;
 }
 
+gamma_t *gamma_copy(gamma_t *g) {
+    if (g == NULL)
+        return NULL;
+
+    gamma_t *copy = mem_alloc(g->allocator, sizeof(struct gamma));
+    if (copy == NULL)
+        return NULL;
+    *copy = *g;
+#ifdef GAMMA_STATS
+    memset(&copy->stats, 0, sizeof(gamma_stats_t));
+#endif
+
+    set_pointers_to_NULL(copy);
+    const gamma_allocator_t *a = copy->allocator;
+    bool is_ok = true;
+    if (!copy_arr_2D(a, (void ***) &copy->parents, (void **) g->parents,
+                     FIELD_SIZE, g->width, g->height))
+        is_ok = false;
+    copy->players_capacity = g->num_of_players;
+    if (init_array_1D(a, (void **) &copy->players, PLAYER_SIZE, g->num_of_players))
+        memcpy(copy->players, g->players, PLAYER_SIZE * g->num_of_players);
+    else
+        is_ok = false;
+    if (init_array_1D(a, (void **) &copy->dirty, sizeof(span_t), g->width))
+        memcpy(copy->dirty, g->dirty, sizeof(span_t) * g->width);
+    else
+        is_ok = false;
+    if (init_array_1D(a, (void **) &copy->dirty_columns, UINT_32_SIZE, g->width))
+        memcpy(copy->dirty_columns, g->dirty_columns,
+               UINT_32_SIZE * g->num_dirty_columns);
+    else
+        is_ok = false;
+    uint64_t cells = (uint64_t) g->width * g->height;
+    if (init_array_1D(a, &copy->owners, g->owner_size, cells))
+        memcpy(copy->owners, g->owners, g->owner_size * cells);
+    else
+        is_ok = false;
+    if (!copy_arr_2D(a, (void ***) &copy->areas_size, (void **) g->areas_size,
+                     UINT_64_SIZE, g->width, g->height))
+        is_ok = false;
+    if (!init_arr_2D(a, (void ***) &copy->visited, UINT_32_SIZE, g->width, g->height))
+        is_ok = false;
+    if (!init_m_stack(copy))
+        is_ok = false;
+    if (!is_ok) {
+        gamma_delete(copy);
+        return NULL;
+    }
+    return copy;
+}
+
+bool gamma_reset(gamma_t *g, uint32_t players, uint32_t areas) {
+    if (g == NULL || players < 1 || areas < 1)
+        return false;
+    if (players > g->players_capacity) {
+        player_t *resized = mem_realloc(g->allocator, g->players,
+                                        PLAYER_SIZE * g->players_capacity,
+                                        PLAYER_SIZE * players);
+        if (resized == NULL)
+            return false;
+        g->players = resized;
+        g->players_capacity = players;
+    }
+    uint8_t owner_size = owner_size_for(players);
+    if (owner_size > g->owner_size) {
+        uint64_t cells = (uint64_t) g->width * g->height;
+        void *owners = NULL;
+        if (!init_array_1D(g->allocator, &owners, owner_size, cells))
+            return false;
+        mem_free(g->allocator, g->owners, g->owner_size * cells);
+        g->owners = owners;
+        g->owner_size = owner_size;
+    }
+    memset(g->players, 0, PLAYER_SIZE * players);
+    g->num_of_players = players;
+    g->max_num_of_areas = areas;
+
+    for (uint32_t i = 0; i < g->num_dirty_columns; i++) {
+        uint32_t x = g->dirty_columns[i];
+        span_t span = g->dirty[x];
+        uint32_t rows = span.high - span.low;
+        memset((uint8_t *) g->owners + g->owner_size * ((uint64_t) x * g->height + span.low),
+               0, g->owner_size * rows);
+        memset(g->parents[x] + span.low, 0, FIELD_SIZE * rows);
+        memset(g->areas_size[x] + span.low, 0, UINT_64_SIZE * rows);
+        g->dirty[x].low = g->dirty[x].high = 0;
+    }
+    g->num_dirty_columns = 0;
+    g->empty_fields = (uint64_t) g->width * g->height;
+    memset(g->players_by_digits, 0, sizeof(g->players_by_digits));
+#ifdef GAMMA_STATS
+    memset(&g->stats, 0, sizeof(gamma_stats_t));
+#endif
+    return true;
+}
+
+uint32_t gamma_width(gamma_t *g) {
+    return g == NULL ? 0 : g->width;
+}
+
+uint32_t gamma_height(gamma_t *g) {
+    return g == NULL ? 0 : g->height;
+}
+
+/**
+ * @brief Struktura przechowująca stan przeszukiwania obszarów przy
+ * wyznaczaniu mapy legalnych ruchów.
+ * Tablice mają po jednym elemencie na pole, pole (@p x, @p y) ma indeks
+ * @p y @p * @p width @p + @p x. Są alokowane dopiero wtedy, gdy trzeba
+ * przeszukać pierwszy obszar.
+ */
+typedef struct cut_search {
+    uint64_t *order;     /**< Numer pola w kolejności odwiedzania, liczony
+                          * od @p 1, lub @p 0, jeśli pole nie zostało
+                          * odwiedzone.
+                          */
+    uint64_t *low;       /**< Najmniejszy numer pola osiągalnego z poddrzewa
+                          * pola jedną krawędzią spoza drzewa przeszukiwania.
+                          */
+    uint64_t *stack;     ///< Stos indeksów pól.
+    uint8_t *next_dir;   ///< Kierunek następnego sprawdzanego sąsiada.
+    uint8_t *parent_dir; /**< Kierunek do rodzica w drzewie przeszukiwania
+                          * lub @ref DIRECTIONS dla korzenia.
+                          */
+    uint8_t *pieces;     /**< Liczba części, na które rozpadnie się obszar
+                          * po usunięciu pionka z pola.
+                          */
+    uint64_t time;       ///< Liczba odwiedzonych dotąd pól.
+} cut_search_t;
+
+// Wersje pętli przeglądających planszę dla każdego rozmiaru komórki.
+#define OWNER_T uint8_t
+#define OWNER_BITS 8
+#include "owner_loops.h"
+#define OWNER_T uint16_t
+#define OWNER_BITS 16
+#include "owner_loops.h"
+#define OWNER_T uint32_t
+#define OWNER_BITS 32
+#include "owner_loops.h"
+
 /** @brief Liczy ilość sąsiednich pól zajętych przez gracza @p player.
  * Sprawdza liczbę pól sąsiadujących z polem o współrzędnych (@p x, @p y)
- * dla których wartość odpowiadającej im komórki w @p g->player_arr jest równa
+ * dla których wartość odpowiadającej im komórki w @p g->owners jest równa
  * @p player, co jest równe ilości pól należących do gracza @p player
  * sąsiadujących z polem (@p x, @p y) na planszy w grze,
- * której stan reprezentuje struktura wskazywana przez @p g.
+ * której stan reprezentuje struktura wskazywana przez @p g. Wywołuje
+ * wersję z owner_loops.h dla rozmiaru komórki gry.
  * @param[in] g      – wskaźnik na strukturę przechowującą stan gry,
  * 					   różny od @p NULL,
  * @param[in] x      – numer kolumny, liczba nieujemna, mniejsza od
@@ -259,17 +562,95 @@ gamma_t *gamma_new(uint32_t width, uint32_t height, uint32_t players, uint32_t a
  * @return Liczba takich pól.
  */
 static int count_neighbours(gamma_t *g, uint32_t x, uint32_t y, uint32_t player) {
+    switch (g->owner_size) {
+        case sizeof(uint8_t):
+            return count_neighbours_8(g, x, y, player);
+        case sizeof(uint16_t):
+            return count_neighbours_16(g, x, y, player);
+        default:
+            return count_neighbours_32(g, x, y, player);
+    }
+}
+
+/** @brief Szuka następnego pola, na którym trzeba sprawdzić złoty ruch.
+ * Wywołuje wersję z owner_loops.h dla rozmiaru komórki gry.
+ * @param[in] g        – wskaźnik na strukturę przechowującą stan gry,
+ *                       różny od @p NULL,
+ * @param[in] player   – numer gracza wykonującego złoty ruch,
+ * @param[in] at_limit – czy gracz ma już maksymalną liczbę obszarów,
+ * @param[in,out] x    – numer kolumny pola, od którego zaczyna się
+ *                       przeglądanie, a po powrocie kolumna znalezionego
+ *                       pola,
+ * @param[in,out] y    – numer wiersza pola, od którego zaczyna się
+ *                       przeglądanie, a po powrocie wiersz znalezionego
+ *                       pola.
+ * @return Wartość @p true, jeśli znaleziono pole, @p false, jeśli
+ * przejrzano całą resztę planszy.
+ */
+static bool next_golden_candidate(gamma_t *g, uint32_t player, bool at_limit,
+                                  uint32_t *x, uint32_t *y) {
+    switch (g->owner_size) {
+        case sizeof(uint8_t):
+            return next_golden_candidate_8(g, player, at_limit, x, y);
+        case sizeof(uint16_t):
+            return next_golden_candidate_16(g, player, at_limit, x, y);
+        default:
+            return next_golden_candidate_32(g, player, at_limit, x, y);
+    }
+}
+
+/** @brief Zmienia liczniki wolnych pól sąsiadujących z graczami, gdy
+ * zmienia się stan pola.
+ * Wywoływana tuż po tym, jak pole (@p x, @p y) zostało zajęte przez
+ * gracza @p player (@p taken równe @p true) lub tuż przed tym, jak zostanie
+ * zwolnione przez tego gracza (@p taken równe @p false). Zajęte pole
+ * przestaje być wolnym polem sąsiadującym z graczami, do których należą jego
+ * sąsiedzi, a jego wolni sąsiedzi, którzy nie sąsiadowali dotąd z innym
+ * polem gracza @p player, zaczynają z nim sąsiadować. Zwolnienie pola działa
+ * odwrotnie.
+ * @param[in,out] g  – wskaźnik na strukturę przechowującą stan gry,
+ * 					   różny od @p NULL,
+ * @param[in] x      – numer kolumny, liczba nieujemna, mniejsza od
+ * 					   @p g->width,
+ * @param[in] y      – numer wiersza, liczba nieujemna, mniejsza od
+ * 					   @p g->height,
+ * @param[in] player – numer gracza, do którego należy pole,
+ * @param[in] taken  – @p true, jeśli pole zostało zajęte, @p false, jeśli
+ *                     zostanie zwolnione.
+ */
+static void update_frontiers(gamma_t *g, uint32_t x, uint32_t y, uint32_t player,
+                             bool taken) {
+    uint32_t owners[DIRECTIONS];
     int l = 0;
     for (int i = 0; i < DIRECTIONS; ++i) {
         uint32_t x_i = x + x_dir[i];
         uint32_t y_i = y + y_dir[i];
-        if (!wrong_field(x_i, y_i, g) && g->player_arr[x_i][y_i] == player)
-            l++;
+        if (wrong_field(x_i, y_i, g))
+            continue;
+        uint32_t owner = owner_at(g, x_i, y_i);
+        if (owner == NO_PLAYER) {
+            if (count_neighbours(g, x_i, y_i, player) == 1) {
+                if (taken)
+                    g->players[player - 1].frontier++;
+                else
+                    g->players[player - 1].frontier--;
+            }
+            continue;
+        }
+        bool seen = false;
+        for (int k = 0; k < l; ++k)
+            seen = seen || owners[k] == owner;
+        if (!seen) {
+            owners[l++] = owner;
+            if (taken)
+                g->players[owner - 1].frontier--;
+            else
+                g->players[owner - 1].frontier++;
+        }
     }
-    return l;
 }
 
-/** @brief Zwraca reprezentanta obszaru do którego należy pole.
+/** @brief Odnajduje reprezentanta obszaru do którego należy pole.
  * Wykorzystuje algorytm operacji @p find ze struktury @p Find @p Union.
  * Rekurencyjnie szuka komórki w tablicy @p g->parents reprezentującej
  * pole, które jest swoim własnym reprezentantem.
@@ -281,12 +662,58 @@ static int count_neighbours(gamma_t *g, uint32_t x, uint32_t y, uint32_t player)
  * @return Struktura reprezentująca pole będące reprezentantem obszaru,
  * do którego należy pole @p f.
  */
-static field_t find_parent(gamma_t *g, field_t f) {
+static field_t find_root(gamma_t *g, field_t f) {
+    STAT_ADD(g, find_parent_steps, 1);
     if (!field_equals(f, (g->parents[f.x][f.y])))
-        g->parents[f.x][f.y] = find_parent(g, g->parents[f.x][f.y]);
+        g->parents[f.x][f.y] = find_root(g, g->parents[f.x][f.y]);
     return g->parents[f.x][f.y];
 }
 
+/** @brief Zwraca reprezentanta obszaru do którego należy pole.
+ * Wywołuje @ref find_root, zliczając wywołania w statystykach gry.
+ * @param[in] g – wskaźnik na strukturę reprezentującą stan gry,
+ * 				  różny od @p NULL,
+ * @param[in] f – struktura reprezentująca pole zajęte przez jakiegoś gracza.
+ * @return Struktura reprezentująca pole będące reprezentantem obszaru,
+ * do którego należy pole @p f.
+ */
+static field_t find_parent(gamma_t *g, field_t f) {
+    STAT_ADD(g, find_parent_calls, 1);
+    return find_root(g, f);
+}
+
+/** @brief Zwraca wielkość obszaru, do którego należy pole.
+ * @param[in] g – wskaźnik na strukturę reprezentującą stan gry,
+ * 				  różny od @p NULL,
+ * @param[in] x – numer kolumny zajętego pola, liczba nieujemna mniejsza od
+ *                @p g->width,
+ * @param[in] y – numer wiersza zajętego pola, liczba nieujemna mniejsza od
+ *                @p g->height.
+ * @return Liczba pól obszaru, do którego należy pole (@p x, @p y).
+ */
+static uint64_t area_size(gamma_t *g, uint32_t x, uint32_t y) {
+    field_t f;
+    f.x = x;
+    f.y = y;
+    field_t parent = find_parent(g, f);
+    return g->areas_size[parent.x][parent.y];
+}
+
+/** @brief Przygotowuje stos do usunięcia pionka z obszaru.
+ * Usunięcie pionka z obszaru o @p cells polach przeszukuje pozostałe
+ * pola obszaru i wstawia każde z nich na stos co najwyżej raz, więc
+ * stos o maksymalnym rozmiarze @p cells wystarcza i przeszukiwanie nie
+ * może się przerwać z braku pamięci w połowie zmian na planszy.
+ * @param[in,out] g – wskaźnik na strukturę reprezentującą stan gry,
+ *                    różny od @p NULL,
+ * @param[in] cells – liczba pól obszaru.
+ * @return Wartość @p true, jeśli stos pomieści obszar, @p false, jeśli
+ * nie udało się go powiększyć.
+ */
+static bool reserve_dfs_stack(gamma_t *g, uint64_t cells) {
+    return stack_reserve(g->stack, cells);
+}
+
 uint64_t gamma_busy_fields(gamma_t *g, uint32_t player) {
     if (wrong_player(player, g))
         return 0;
@@ -421,8 +848,20 @@ static void remove_same_areas(gamma_t *g, field_t neighbours[], uint32_t l, uint
  * 							 @p g->num_of_players
  */
 static void take_field(gamma_t *g, uint32_t x, uint32_t y, uint32_t player) {
-    g->player_arr[x][y] = player;
-    g->players[player - 1].busy_fields++;
+    span_t *span = &g->dirty[x];
+    if (span->low == span->high) {
+        g->dirty_columns[g->num_dirty_columns++] = x;
+        span->low = y;
+        span->high = y + 1;
+    } else if (y < span->low) {
+        span->low = y;
+    } else if (y >= span->high) {
+        span->high = y + 1;
+    }
+    set_owner(g, x, y, player);
+    update_frontiers(g, x, y, player, true);
+    if (g->players[player - 1].busy_fields++ == 0)
+        g->players_by_digits[digit_count(player)]++;
     g->players[player - 1].num_of_areas++;
     g->empty_fields--;
 }
@@ -452,7 +891,7 @@ static void move_util(gamma_t *g, uint32_t x, uint32_t y, uint32_t player) {
         f_i.x = x + x_dir[i];
         f_i.y = y + y_dir[i];
         if (!wrong_field(f_i.x, f_i.y, g)
-            && g->player_arr[f_i.x][f_i.y] == player) {
+            && owner_at(g, f_i.x, f_i.y) == player) {
 
             neigbours[l] = f_i;
             if (l == 0) {
@@ -473,20 +912,38 @@ static void move_util(gamma_t *g, uint32_t x, uint32_t y, uint32_t player) {
     remove_same_areas(g, neigbours, l, player);
 }
 
-bool gamma_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
-    if (wrong_player(player, g) || wrong_field(x, y, g))
+/** @brief Sprawdza, czy gracz może postawić pionek na polu.
+ * Sprawdza, czy pole (@p x, @p y) jest wolne i czy postawienie na nim
+ * pionka gracza @p player nie przekroczy maksymalnej liczby obszarów.
+ * Nie zmienia stanu gry.
+ * @param[in] g      – wskaźnik na strukturę reprezentującą stan gry,
+ *                     różny od @p NULL,
+ * @param[in] player – numer gracza, liczba dodatnia niewiększa od
+ *                     @p g->num_of_players,
+ * @param[in] x      – numer kolumny, liczba nieujemna mniejsza od
+ *                     @p g->width,
+ * @param[in] y      – numer wiersza, liczba nieujemna mniejsza od
+ *                     @p g->height.
+ * @return Wartość @p true, jeśli ruch jest legalny, @p false w przeciwnym
+ * przypadku.
+ */
+static bool move_legal(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
+    if (owner_at(g, x, y) != NO_PLAYER)
         return false;
+    return g->players[player - 1].num_of_areas < g->max_num_of_areas
+           || count_neighbours(g, x, y, player) > 0;
+}
 
-    uint32_t p = g->player_arr[x][y];
-    if (p != NO_PLAYER)
+bool gamma_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
+    if (wrong_player(player, g) || wrong_field(x, y, g))
         return false;
 
-    if (g->players[player - 1].num_of_areas >= g->max_num_of_areas
-        && count_neighbours(g, x, y, player) == 0) {
+    if (!move_legal(g, player, x, y))
         return false;
-    }
 
+    TRACE_BEGIN(span);
     move_util(g, x, y, player);
+    TRACE_END(span, "gamma_move", player);
 
     return true;
 }
@@ -497,78 +954,143 @@ uint64_t gamma_free_fields(gamma_t *g, uint32_t player) {
     if (g->players[player - 1].num_of_areas > g->max_num_of_areas)
         return 0;
 
-    uint64_t count = 0;
-    if (g->players[player - 1].num_of_areas == g->max_num_of_areas) {
-        for (uint32_t i = 0; i < g->width; ++i) {
-            for (uint32_t j = 0; j < g->height; ++j) {
-                if (no_field(i, j, g) && count_neighbours(g, i, j, player) > 0)
-                    count++;
-            }
-        }
-        return count;
-    }
+    if (g->players[player - 1].num_of_areas == g->max_num_of_areas)
+        return g->players[player - 1].frontier;
     return g->empty_fields;
 }
 
 /**
- * @brief Wykonuje złoty ruch bez sprawdzania ani zmieniania tego,
- * czy gracz wykonał już złoty ruch.
- * Tymczasowo zmienia wartość pola @p has_played_golden_move w strukturze
- * reprezentującej gracza o numerze @p player (przechowywanej w strukturze
- * reprezentującej stan gry, wskazywanej przez @p g) na wartość @p false.
- * Następnie wykonuje @ref gamma_golden_move na parametrach podanych
- * przy wywołaniu funkcji i zapamiętuje wartość zwróconą przez funkcję.
- * Przywraca początkową wartość pola @p has_played_golden_move w strukturze
- * reprezentującej gracza o numerze @p player.
- * @param[in,out] g        – wskaźnik na strukturę reprezentującą stan gry,
- *                           różny od @p NULL,
- * @param[in] player       – numer gracza, liczba dodatnia niewiększa od
- * 							 @p g->num_of_players,
- * @param[in] x            – numer kolumny, liczbe nieujemna mniejsza od
- * 							 @p g->width,
- * @param[in] y            – numer wiersza, liczba nieujemna mniejsza od
- * 							 @p g->height.
- * @return Wartość @p false w przypadku niepoprawnych parametrów. Wartość
- * zwrócona przy wywołaniu @ref gamma_golden_move na odpowiednio zmienionej
- * strukturze wskazywanej przez @p g w przeciwnym przypadku.
+ * @brief Sprawdza, czy złoty ruch na pole na pewno nie podzieli obszarów
+ * właściciela pola ponad limit.
+ * Usunięcie pionka dzieli jego obszar na co najwyżej tyle części, ilu
+ * sąsiadów należących do właściciela ma pole, więc jeśli nawet przy
+ * największym możliwym podziale właściciel nie przekroczy limitu obszarów,
+ * nie trzeba przeszukiwać planszy.
+ * @param[in] g – wskaźnik na strukturę reprezentującą stan gry,
+ *                różny od @p NULL,
+ * @param[in] x – numer kolumny zajętego pola, liczba nieujemna mniejsza od
+ *                @p g->width,
+ * @param[in] y – numer wiersza zajętego pola, liczba nieujemna mniejsza od
+ *                @p g->height.
+ * @return Wartość @p true, jeśli usunięcie pionka na pewno nie przekroczy
+ * limitu obszarów, @p false, jeśli może go przekroczyć.
  */
-static bool golden_no_checking_nor_changing(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
-    if (wrong_player(player, g) || wrong_field(x, y, g))
-        return false;
+static bool split_surely_fits(gamma_t *g, uint32_t x, uint32_t y) {
+    uint32_t owner = owner_at(g, x, y);
+    return g->players[owner - 1].num_of_areas - 1 + count_neighbours(g, x, y, owner)
+           <= g->max_num_of_areas;
+}
 
-    bool has_played_save = g->players[player - 1].has_played_golden_move;
-    g->players[player - 1].has_played_golden_move = false;
-    bool golden = gamma_golden_move(g, player, x, y);
-    g->players[player - 1].has_played_golden_move = has_played_save;
-    return golden;
+/**
+ * @brief Zwalnia pamięć przeszukiwania obszarów.
+ * @param[in] g     – wskaźnik na strukturę reprezentującą stan gry,
+ *                    różny od @p NULL,
+ * @param[in,out] c – wskaźnik na stan przeszukiwania.
+ */
+static void cut_search_free(gamma_t *g, cut_search_t *c) {
+    uint64_t cells = (uint64_t) g->width * g->height;
+    mem_free(g->allocator, c->order, cells * UINT_64_SIZE);
+    mem_free(g->allocator, c->low, cells * UINT_64_SIZE);
+    mem_free(g->allocator, c->stack, cells * UINT_64_SIZE);
+    mem_free(g->allocator, c->next_dir, cells);
+    mem_free(g->allocator, c->parent_dir, cells);
+    mem_free(g->allocator, c->pieces, cells);
 }
 
-bool gamma_golden_possible(gamma_t *g, uint32_t player) {
-    if (wrong_player(player, g))
-        return false;
-    if (g->players[player - 1].has_played_golden_move)
-        return false;
+/**
+ * @brief Przeszukuje obszar i dla każdego jego pola liczy, na ile części
+ * rozpadnie się obszar po usunięciu z niego pionka.
+ * Iteracyjny algorytm Tarjana wyznaczania punktów artykulacji: usunięcie
+ * pola odcina każde poddrzewo dziecka, z którego nie da się wrócić
+ * powyżej pola, a pole niebędące korzeniem zostawia też część
+ * zawierającą rodzica. Wywołuje wersję z owner_loops.h dla rozmiaru
+ * komórki gry.
+ * @param[in] g     – wskaźnik na strukturę reprezentującą stan gry,
+ *                    różny od @p NULL,
+ * @param[in,out] c – wskaźnik na stan przeszukiwania z zaalokowanymi
+ *                    tablicami,
+ * @param[in] root  – indeks zajętego, nieodwiedzonego pola obszaru.
+ */
+static void cut_search_area(gamma_t *g, cut_search_t *c, uint64_t root) {
+    switch (g->owner_size) {
+        case sizeof(uint8_t):
+            cut_search_area_8(g, c, root);
+            break;
+        case sizeof(uint16_t):
+            cut_search_area_16(g, c, root);
+            break;
+        default:
+            cut_search_area_32(g, c, root);
+    }
+}
 
-    bool player_heurisic = false;
-    for (uint32_t i = 0; i < g->num_of_players; i++) {
-        if (i != player - 1 && g->players[i].busy_fields > 0)
-            player_heurisic = true;
+/**
+ * @brief Zwraca, na ile części rozpadnie się obszar po usunięciu pionka
+ * z pola.
+ * Przy pierwszym wywołaniu dla danego obszaru przeszukuje cały obszar.
+ * @param[in] g     – wskaźnik na strukturę reprezentującą stan gry,
+ *                    różny od @p NULL,
+ * @param[in,out] c – wskaźnik na stan przeszukiwania,
+ * @param[in] x     – numer kolumny zajętego pola,
+ * @param[in] y     – numer wiersza zajętego pola,
+ * @param[out] pieces – wskaźnik, pod który zostanie zapisana liczba części.
+ * @return Wartość @p true, jeśli się udało, @p false, jeśli nie udało się
+ * zaalokować pamięci.
+ */
+static bool cut_pieces(gamma_t *g, cut_search_t *c, uint32_t x, uint32_t y,
+                       uint8_t *pieces) {
+    uint64_t cells = (uint64_t) g->width * g->height;
+    if (c->order == NULL) {
+        c->order = mem_calloc(g->allocator, cells, UINT_64_SIZE);
+        c->low = mem_alloc(g->allocator, cells * UINT_64_SIZE);
+        c->stack = mem_alloc(g->allocator, cells * UINT_64_SIZE);
+        c->next_dir = mem_calloc(g->allocator, cells, 1);
+        c->parent_dir = mem_alloc(g->allocator, cells);
+        c->pieces = mem_calloc(g->allocator, cells, 1);
+        if (c->order == NULL || c->low == NULL || c->stack == NULL
+            || c->next_dir == NULL || c->parent_dir == NULL || c->pieces == NULL)
+            return false;
     }
-    if (!player_heurisic)
+    uint64_t i = (uint64_t) y * g->width + x;
+    if (c->order[i] == 0)
+        cut_search_area(g, c, i);
+    *pieces = c->pieces[i];
+    return true;
+}
+
+bool gamma_legal_map(gamma_t *g, uint32_t player, uint8_t *map) {
+    if (wrong_player(player, g) || map == NULL)
         return false;
-    if (g->players[player - 1].num_of_areas < g->max_num_of_areas)
-        return true;
 
-    for (uint32_t i = 0; i < g->width; i++) {
+    TRACE_BEGIN(span);
+    player_t *p = &g->players[player - 1];
+    bool below_limit = p->num_of_areas < g->max_num_of_areas;
+    cut_search_t c = {NULL, NULL, NULL, NULL, NULL, NULL, 0};
+    bool ok = true;
+    for (uint32_t i = 0; i < g->width && ok; i++) {
         for (uint32_t j = 0; j < g->height; j++) {
-            uint32_t player_it = g->player_arr[i][j];
-            if (golden_no_checking_nor_changing(g, player, i, j)) {
-                golden_no_checking_nor_changing(g, player_it, i, j);
-                return true;
+            uint32_t owner = owner_at(g, i, j);
+            uint8_t bits = 0;
+            bool reachable = below_limit || count_neighbours(g, i, j, player) > 0;
+            if (owner == NO_PLAYER) {
+                if (reachable)
+                    bits = GAMMA_LEGAL_MOVE;
+            } else if (owner != player && reachable && !p->has_played_golden_move) {
+                uint8_t pieces = 0;
+                if (!split_surely_fits(g, i, j) && !cut_pieces(g, &c, i, j, &pieces)) {
+                    ok = false;
+                    break;
+                }
+                if (g->players[owner - 1].num_of_areas - 1 + pieces
+                    <= g->max_num_of_areas)
+                    bits = GAMMA_LEGAL_GOLDEN;
             }
+            map[(uint64_t) j * g->width + i] = bits;
         }
     }
-    return false;
+    cut_search_free(g, &c);
+    TRACE_END(span, "gamma_legal_map", player);
+    return ok;
 }
 
 /** @brief Znajduje szerekość kolumn w reprezentacji planszy
@@ -595,17 +1117,11 @@ bool gamma_golden_possible(gamma_t *g, uint32_t player) {
  * jeśli numery te są jednocyfrowe plus @p 1.
  */
 static uint32_t find_max_number_width(gamma_t *g) {
-    uint32_t max_width = 1;
-    for (uint32_t i = 0; i < g->num_of_players; ++i) {
-        if (g->players[i].busy_fields > 0) {
-            uint32_t d = digit_count(i + 1);
-            if (d > max_width)
-                max_width = d;
-        }
+    for (uint32_t d = MAX_PLAYER_DIGITS; d > 1; d--) {
+        if (g->players_by_digits[d] > 0)
+            return d + 1;
     }
-    if (max_width > 1)
-        max_width++;
-    return max_width;
+    return 1;
 }
 
 uint32_t gamma_field_width_interactive(gamma_t *g) {
@@ -616,37 +1132,52 @@ uint32_t gamma_field_width_interactive(gamma_t *g) {
 }
 
 /**
- * @brief Zapisuje napisową reprezentację planszy do bufora.
+ * @brief Zapisuje do bufora napisową reprezentację prostokątnego fragmentu
+ * planszy.
+ * Fragment składa się z pól (@p x, @p y), gdzie @p x0 <= @p x < @p x1
+ * i @p y0 <= @p y < @p y1. Wiersze zapisywane są od najwyższego, każdy
+ * zakończony znakiem nowej linii, a cały napis znakiem końca łańcucha.
+ * Czas działania jest proporcjonalny do rozmiaru fragmentu. Wywołuje
+ * wersję z owner_loops.h dla rozmiaru komórki gry.
  * @param[in] g          – wskaźnik na strukturę reprezentującą stan gry,
  *                         różny od @p NULL,
  * @param[in] max_width  – szerokosć pola w napisowej reprezentacji planszy,
+ * @param[in] x0         – numer pierwszej kolumny fragmentu,
+ * @param[in] x1         – numer kolumny za ostatnią kolumną fragmentu,
+ *                         niewiększy od @p g->width,
+ * @param[in] y0         – numer pierwszego wiersza fragmentu,
+ * @param[in] y1         – numer wiersza za ostatnim wierszem fragmentu,
+ *                         niewiększy od @p g->height,
  * @param[out] buffer    – bufor rozmiaru zdolnego pomieścić napisową
- *                         reprezentację planszy (niemniejszego niż
- *                         @p g->num_of_fields * @p max_width +
- *                         @p g->height + @p 1.
- */
-static void gamma_board_helper(gamma_t *g, uint32_t max_width, char *buffer) {
-    uint64_t it = 0;
-    for (uint32_t i = 0; i < g->height; ++i) {
-        for (uint32_t j = 0; j < g->width; ++j) {
-            // TODO czy użyć tutaj gamma_write_field
-            // trzeba by chyba zmodyfikować write_field tak, by przyjmowało szerokość pola
-            uint32_t old_it = it;
-            if (g->player_arr[j][g->height - i - 1] == NO_PLAYER) {
-                buffer[it] = NO_PLAYER_CHAR;
-                it++;
-            } else {
-                it = write_int(buffer, it, g->player_arr[j][g->height - i - 1]);
-            }
-            while (it - old_it < max_width) {
-                buffer[it] = SPACE;
-                it++;
-            }
-        }
-        buffer[it] = '\n';
-        it++;
+ *                         reprezentację fragmentu (niemniejszego niż
+ *                         wartość @ref window_length @p + @p 1).
+ */
+static void gamma_board_helper(gamma_t *g, uint32_t max_width, uint32_t x0,
+                               uint32_t x1, uint32_t y0, uint32_t y1,
+                               char *buffer) {
+    switch (g->owner_size) {
+        case sizeof(uint8_t):
+            board_rows_8(g, max_width, x0, x1, y0, y1, buffer);
+            break;
+        case sizeof(uint16_t):
+            board_rows_16(g, max_width, x0, x1, y0, y1, buffer);
+            break;
+        default:
+            board_rows_32(g, max_width, x0, x1, y0, y1, buffer);
     }
-    buffer[it] = '\0';
+}
+
+/**
+ * @brief Liczy długość napisowej reprezentacji fragmentu planszy.
+ * @param[in] max_width – szerokość pola w napisowej reprezentacji planszy,
+ * @param[in] columns   – liczba kolumn fragmentu,
+ * @param[in] rows      – liczba wierszy fragmentu.
+ * @return Liczba znaków napisu bez znaku końca łańcucha.
+ */
+static uint64_t window_length(uint32_t max_width, uint32_t columns, uint32_t rows) {
+    uint64_t num_of_fields = columns;
+    num_of_fields *= rows;
+    return num_of_fields * max_width + rows;
 }
 
 /**
@@ -663,12 +1194,31 @@ static void gamma_board_helper(gamma_t *g, uint32_t max_width, char *buffer) {
  */
 static char *alloc_memory_for_board(gamma_t *g, uint32_t max_width) {
     char *buffer = NULL;
-    uint64_t num_of_fields = g->width;
-    num_of_fields *= g->height;
-    buffer = malloc((num_of_fields * max_width + g->height + 1) * sizeof(char));
+    uint64_t length = window_length(max_width, g->width, g->height);
+    buffer = mem_alloc_detached((length + 1) * sizeof(char));
     return buffer;
 }
 
+uint64_t gamma_board_rows(gamma_t *g, uint32_t y0, uint32_t y1, uint32_t x0,
+                          uint32_t x1, char *buf, uint64_t len) {
+    if (g == NULL || x0 >= x1 || x1 > g->width || y0 >= y1 || y1 > g->height)
+        return 0;
+    uint32_t max_width = find_max_number_width(g);
+    uint64_t length = window_length(max_width, x1 - x0, y1 - y0);
+    if (buf == NULL || len <= length)
+        return length;
+    TRACE_BEGIN(span);
+    gamma_board_helper(g, max_width, x0, x1, y0, y1, buf);
+    TRACE_END(span, "gamma_board_rows", length);
+    return length;
+}
+
+uint64_t gamma_board_buffer(gamma_t *g, char *buf, uint64_t len) {
+    if (g == NULL)
+        return 0;
+    return gamma_board_rows(g, 0, g->height, 0, g->width, buf, len);
+}
+
 char *gamma_board(gamma_t *g) {
     if (g == NULL)
         return NULL;
@@ -676,7 +1226,9 @@ char *gamma_board(gamma_t *g) {
     char *buffer = alloc_memory_for_board(g, max_width);
     if (buffer == NULL)
         return NULL;
-    gamma_board_helper(g, max_width, buffer);
+    TRACE_BEGIN(span);
+    gamma_board_helper(g, max_width, 0, g->width, 0, g->height, buffer);
+    TRACE_END(span, "gamma_board", max_width);
     return buffer;
 }
 
@@ -684,14 +1236,16 @@ void gamma_delete(gamma_t *g) {
     if (g == NULL)
         return;
 
-    free_array((void **) g->player_arr, g->width);
-    free_array((void **) g->parents, g->width);
-    free_array((void **) g->areas_size, g->width);
-    free_array((void **) g->visited, g->width);
-    if (g->players != NULL)
-        free(g->players);
+    const gamma_allocator_t *a = g->allocator;
+    mem_free(a, g->owners, g->owner_size * (uint64_t) g->width * g->height);
+    free_array(a, (void **) g->parents, FIELD_SIZE, g->width, g->height);
+    free_array(a, (void **) g->areas_size, UINT_64_SIZE, g->width, g->height);
+    free_array(a, (void **) g->visited, UINT_32_SIZE, g->width, g->height);
+    mem_free(a, g->players, PLAYER_SIZE * g->players_capacity);
+    mem_free(a, g->dirty, sizeof(span_t) * g->width);
+    mem_free(a, g->dirty_columns, UINT_32_SIZE * g->width);
     stack_destruct(g->stack);
-    free(g);
+    mem_free(a, g, sizeof(struct gamma));
 }
 
 /** @brief Usuwa pionek z pola.
@@ -716,9 +1270,11 @@ static void delete_field(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
     f.y = y;
     field_t parent = find_parent(g, f);
     g->areas_size[parent.x][parent.y] = 0;
-    g->player_arr[x][y] = NO_PLAYER;
+    update_frontiers(g, x, y, player, false);
+    set_owner(g, x, y, NO_PLAYER);
     g->empty_fields++;
-    g->players[player - 1].busy_fields--;
+    if (--g->players[player - 1].busy_fields == 0)
+        g->players_by_digits[digit_count(player)]--;
     g->players[player - 1].num_of_areas--;
 }
 
@@ -726,7 +1282,7 @@ static void delete_field(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
  * Sprawdza czy na planszy, w grze, której stan reprezentuje struktura
  * wskazywana przez @p g, istnieje pole o współrzędnych (@p x, @p y)
  * należące do gracza @p p, i wartość komórki w tablicy @p g->visited
- * odpowiadającej polu (@p x, @p y) jest równa @p 0.
+ * odpowiadającej polu (@p x, @p y) jest różna od @p g->visit_epoch.
  * @param[in,out] g  – wskaźnik na strukture reprezentującą stan gry, różny od
  *                     @p NULL,
  * @param[in] x      – numer kolumny,
@@ -736,86 +1292,56 @@ static void delete_field(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
  * @return Wartość @p true, jeśli na planszy, w grze, której stan
  * reprezentuje struktura wskazywana przez @p g, istnieje pole o
  * współrzędnych (@p x, @p y) należące do gracza @p p
- * (tzn takie, że g->player_arr[x][y] == player) i wartość komórki
+ * (tzn takie, że owner_at(g, x, y) == p) i wartość komórki
  * w tablicy @p g->visited odpowiadającej polu (@p x, @p y) jest
- * równa @p 0. Wartość @p false w przeciwnym przypadku.
+ * różna od @p g->visit_epoch. Wartość @p false w przeciwnym przypadku.
  */
 static bool dfs_condition(gamma_t *g, uint32_t x, uint32_t y, uint32_t p) {
     return !wrong_field(x, y, g)
-           && !g->visited[x][y]
-           && g->player_arr[x][y] == p;
-}
-
-/** @brief Ustawia pola w tablicy @p visited na @p 0.
- * Dla planszy, w grze, której stan reprezentuje struktura wskazwana
- * przez @p g, @p Odwiedzonym @p Obszarem nazwiemy zbiór pól
- * należących do tego samego obszaru na planszy, których wartość
- * w odpowiadającej im komórce tablicy @p g->visited
- * jest równa 1. Funkcja @p init_visited dla wszystkich
- * pól w @p Odwiedzonym @p Obszarze, do którego należy pole
- * (@p x, @p y) ustawia wartość odpowiadającej im komórki w
- * tablicy @p g->visited na @p 0 (używając do tego algorytmu
- * DFS).
- * @param[in,out] g  – wskaźnik na strukture reprezentującą stan gry,
- *                     różny od @p NULL,
- * @param[in] x      – numer kolumny, liczbe nieujemna mniejsza od
- * 					   @p g->width,
- * @param[in] y      – numer wiersza, liczba nieujemna mniejsza od
- * 					   @p g->height.
+           && g->visited[x][y] != g->visit_epoch
+           && owner_at(g, x, y) == p;
+}
+
+/** @brief Rozpoczyna nowe przeszukiwanie planszy.
+ * Zwiększa numer przeszukiwania @p g->visit_epoch, dzięki czemu
+ * wszystkie pola przestają być odwiedzone bez przechodzenia po
+ * tablicy @p g->visited. Gdy numer się przepełni, zeruje tablicę
+ * i zaczyna numerację od @p 1.
+ * @param[in,out] g – wskaźnik na strukture reprezentującą stan gry,
+ *                    różny od @p NULL.
  */
-static void init_visited(gamma_t *g, uint32_t x, uint32_t y) {
-    stack_push(g->stack, x, y);
-    g->visited[x][y] = 0;
-    while (!is_stack_empty(g->stack)) {
-        field_t f = stack_pop(g->stack);
-        for (int i = 0; i < DIRECTIONS; ++i) {
-            uint32_t x_i = f.x + x_dir[i];
-            uint32_t y_i = f.y + y_dir[i];
-            if (!wrong_field(x_i, y_i, g) && g->visited[x_i][y_i]) {
-                g->visited[x_i][y_i] = 0;
-                stack_push(g->stack, x_i, y_i);
-            }
-        }
+static void new_visit_epoch(gamma_t *g) {
+    if (++g->visit_epoch == 0) {
+        memset(g->visited[0], 0, UINT_32_SIZE * g->width * g->height);
+        g->visit_epoch = 1;
     }
 }
 
 /** @brief Ustawia reprezentanta obszaru.
  * Funkcja ustawia pole @p parent jako reprezentanta obszaru
- * do którego należy pole (@p x, @p y), składającego się z pól zajętych
+ * do którego należy, składającego się z pól zajętych
  * przez gracza @p p, w grze, której stan reprezentuje struktura wskazywana
- * przez @p g. Zwraca ilość pól należących do tego obszaru.
+ * przez @p g. Zwraca ilość pól należących do tego obszaru. Wywołuje
+ * wersję z owner_loops.h dla rozmiaru komórki gry.
  * @param[in,out] g – wskaźnik na strukture reprezentującą stan gry,
  *                     różny od @p NULL,
  * @param[in] parent – struktura reprezentująca pole, które zostanie
  *                     ustawione jako reprezentant obszaru,
- * @param[in] x      – numer kolumny, liczbe nieujemna mniejsza od
- * 				       @p g->width,
- * @param[in] y      – numer wiersza, liczba nieujemna mniejsza od
- * 				       @p g->height,
  * @param[in] p      – numer gracza, liczba dodatnia niewiększa od
  *                     @p g->num_of_players.
  * @return Wielkość obszaru pól zajętych przez gracza @p p, do którego
- * należu pole (@p x, @p y), w grze, której stan reprezentuje struktura
+ * należy pole @p parent, w grze, której stan reprezentuje struktura
  * wskazywana przez @p g.
  */
-static uint64_t set_parent_dfs(gamma_t *g, field_t parent, uint32_t x, uint32_t y, uint32_t p) {
-    uint64_t count = 0;
-    stack_push(g->stack, x, y);
-    g->visited[x][y] = 1;
-    while (!is_stack_empty(g->stack)) {
-        count++;
-        field_t f = stack_pop(g->stack);
-        g->parents[f.x][f.y] = parent;
-        for (int i = 0; i < DIRECTIONS; ++i) {
-            uint32_t x_i = f.x + x_dir[i];
-            uint32_t y_i = f.y + y_dir[i];
-            if (dfs_condition(g, x_i, y_i, p)) {
-                g->visited[x_i][y_i] = 1;
-                stack_push(g->stack, x_i, y_i);
-            }
-        }
+static uint64_t set_parent_dfs(gamma_t *g, field_t parent, uint32_t p) {
+    switch (g->owner_size) {
+        case sizeof(uint8_t):
+            return relabel_area_8(g, parent, p);
+        case sizeof(uint16_t):
+            return relabel_area_16(g, parent, p);
+        default:
+            return relabel_area_32(g, parent, p);
     }
-    return count;
 }
 
 /** @brief Usuwa pole i aktualizuje informacje o obszarach.
@@ -831,22 +1357,26 @@ static uint64_t set_parent_dfs(gamma_t *g, field_t parent, uint32_t x, uint32_t
  * 					   @p g->height,
  * @param[in] player – numer gracza, liczba dodatnia niewiększa od
  *                     @p g->num_of_players. Funkcja zakłada, że pionek
- *                     gracza @p player leży na polu (@p x, @p y).
+ *                     gracza @p player leży na polu (@p x, @p y), a stos
+ *                     @p g->stack pomieści obszar tego pola
+ *                     (@ref reserve_dfs_stack).
  */
 static void delete_util(gamma_t *g, uint32_t x, uint32_t y, uint32_t player) {
+    TRACE_BEGIN(span);
     delete_field(g, player, x, y);
+    new_visit_epoch(g);
 
     for (int i = 0; i < DIRECTIONS; ++i) {
         field_t f_i;
         f_i.x = x + x_dir[i];
         f_i.y = y + y_dir[i];
         if (dfs_condition(g, f_i.x, f_i.y, player)) {
-            uint64_t a_size = set_parent_dfs(g, f_i, f_i.x, f_i.y, player);
+            uint64_t a_size = set_parent_dfs(g, f_i, player);
             g->players[player - 1].num_of_areas++;
             g->areas_size[f_i.x][f_i.y] = a_size;
         }
     }
-    init_visited(g, x, y);
+    TRACE_END(span, "delete_util", player);
 }
 
 /** @brief Próbuje usunąć pionek i wstawić nowy na jego miejsce.
@@ -873,7 +1403,8 @@ static void delete_util(gamma_t *g, uint32_t x, uint32_t y, uint32_t player) {
  * usunąć z planszy pionek leżący na polu (@p x, @p y) należący do pewnego
  * gracza i ustawić na nim pionka gracza @p n_player (na planszy w grze,
  * której stan reprezentuje struktura wskazywana przez @p g), wartość
- * @p false w przeciwnym przypadku.
+ * @p false w przeciwnym przypadku lub gdy nie udało się powiększyć stosu
+ * (wtedy plansza pozostaje bez zmian).
  */
 static bool delete_and_move(gamma_t *g, uint32_t x, uint32_t y, uint32_t n_player) {
     if (g->players[n_player - 1].num_of_areas >= g->max_num_of_areas
@@ -881,7 +1412,9 @@ static bool delete_and_move(gamma_t *g, uint32_t x, uint32_t y, uint32_t n_playe
         return false;
     }
 
-    uint32_t player = g->player_arr[x][y];
+    uint32_t player = owner_at(g, x, y);
+    if (!reserve_dfs_stack(g, area_size(g, x, y)))
+        return false;
     delete_util(g, x, y, player);
 
 
@@ -897,20 +1430,38 @@ static bool delete_and_move(gamma_t *g, uint32_t x, uint32_t y, uint32_t n_playe
     return true;
 }
 
-bool gamma_golden_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
+/** @brief Wykonuje złoty ruch.
+ * Działa jak @ref gamma_golden_move, ale nie zmniejsza stosu po ruchu,
+ * więc można jej używać między zarezerwowaniem stosu a przeszukiwaniem,
+ * które z tej rezerwy korzysta (@ref golden_possible_scan).
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
+ *                      @p players z funkcji @ref gamma_new,
+ * @param[in] x       – numer kolumny, liczba nieujemna mniejsza od wartości
+ *                      @p width z funkcji @ref gamma_new,
+ * @param[in] y       – numer wiersza, liczba nieujemna mniejsza od wartości
+ *                      @p height z funkcji @ref gamma_new.
+ * @return Wartość @p true, jeśli ruch został wykonany, a @p false,
+ * gdy gracz wykorzystał już swój złoty ruch, ruch jest nielegalny,
+ * parametr jest niepoprawny lub nie udało się powiększyć stosu.
+ */
+static bool golden_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
     if (wrong_player(player, g) || wrong_field(x, y, g))
         return false;
 
     if (g->players[player - 1].has_played_golden_move)
         return false;
 
-    if (g->player_arr[x][y] == player)
+    if (owner_at(g, x, y) == player)
         return false;
 
     if (no_field(x, y, g))
         return false;
 
-    if (delete_and_move(g, x, y, player)) {
+    TRACE_BEGIN(span);
+    bool moved = delete_and_move(g, x, y, player);
+    TRACE_END(span, "gamma_golden_move", player);
+    if (moved) {
         g->players[player - 1].has_played_golden_move = true;
         return true;
     }
@@ -918,6 +1469,123 @@ bool gamma_golden_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
     return false;
 }
 
+bool gamma_golden_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
+    bool moved = golden_move(g, player, x, y);
+    if (g != NULL)
+        stack_shrink(g->stack, DFS_STACK_MIN_SIZE);
+    return moved;
+}
+
+/**
+ * @brief Wykonuje złoty ruch bez sprawdzania ani zmieniania tego,
+ * czy gracz wykonał już złoty ruch.
+ * Tymczasowo zmienia wartość pola @p has_played_golden_move w strukturze
+ * reprezentującej gracza o numerze @p player (przechowywanej w strukturze
+ * reprezentującej stan gry, wskazywanej przez @p g) na wartość @p false.
+ * Następnie wykonuje @ref golden_move na parametrach podanych
+ * przy wywołaniu funkcji i zapamiętuje wartość zwróconą przez funkcję.
+ * Przywraca początkową wartość pola @p has_played_golden_move w strukturze
+ * reprezentującej gracza o numerze @p player.
+ * @param[in,out] g        – wskaźnik na strukturę reprezentującą stan gry,
+ *                           różny od @p NULL,
+ * @param[in] player       – numer gracza, liczba dodatnia niewiększa od
+ * 							 @p g->num_of_players,
+ * @param[in] x            – numer kolumny, liczbe nieujemna mniejsza od
+ * 							 @p g->width,
+ * @param[in] y            – numer wiersza, liczba nieujemna mniejsza od
+ * 							 @p g->height.
+ * @return Wartość @p false w przypadku niepoprawnych parametrów. Wartość
+ * zwrócona przy wywołaniu @ref golden_move na odpowiednio zmienionej
+ * strukturze wskazywanej przez @p g w przeciwnym przypadku.
+ */
+static bool golden_no_checking_nor_changing(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
+    if (wrong_player(player, g) || wrong_field(x, y, g))
+        return false;
+
+    bool has_played_save = g->players[player - 1].has_played_golden_move;
+    g->players[player - 1].has_played_golden_move = false;
+    bool golden = golden_move(g, player, x, y);
+    g->players[player - 1].has_played_golden_move = has_played_save;
+    return golden;
+}
+
+/**
+ * @brief Sprawdza, czy gracz może wykonać złoty ruch na którymkolwiek polu.
+ * Pomija pola wolne, pola gracza i (gdy gracz ma maksymalną liczbę
+ * obszarów) pola, które z nim nie sąsiadują (@ref next_golden_candidate).
+ * Na pozostałych polach ruch
+ * jest możliwy, jeśli nie podzieli obszarów właściciela ponad limit: gdy
+ * @ref split_surely_fits tego nie rozstrzyga, próbuje wykonać złoty ruch
+ * i cofa go, jeśli się udał.
+ * @param[in,out] g  – wskaźnik na strukturę reprezentującą stan gry,
+ *                     różny od @p NULL,
+ * @param[in] player – numer gracza, liczba dodatnia niewiększa od
+ *                     @p g->num_of_players.
+ * @return Wartość @p true, jeśli na którymś polu złoty ruch się udał,
+ * @p false w przeciwnym przypadku.
+ */
+static bool golden_possible_scan(gamma_t *g, uint32_t player) {
+    bool at_limit = g->players[player - 1].num_of_areas >= g->max_num_of_areas;
+    uint32_t i = 0, j = 0;
+    for (; next_golden_candidate(g, player, at_limit, &i, &j); j++) {
+        uint32_t player_it = owner_at(g, i, j);
+        if (split_surely_fits(g, i, j))
+            return true;
+        // Cofnięcie ruchu usuwa pionek gracza z obszaru, który ma
+        // co najwyżej busy_fields + 1 pól; stos musi go pomieścić
+        // już teraz, bo cofnięcia nie można przerwać.
+        uint64_t cells = area_size(g, i, j);
+        uint64_t back = g->players[player - 1].busy_fields + 1;
+        if (!reserve_dfs_stack(g, cells > back ? cells : back))
+            return false;
+        STAT_ADD(g, golden_trials, 1);
+        if (golden_no_checking_nor_changing(g, player, i, j)) {
+            golden_no_checking_nor_changing(g, player_it, i, j);
+            return true;
+        }
+    }
+    return false;
+}
+
+/** @brief Sprawdza, czy gracz może wykonać złoty ruch.
+ * Działa jak @ref gamma_golden_possible, ale nie zmniejsza stosu po
+ * sprawdzeniu.
+ * @param[in,out] g  – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player – numer gracza, liczba dodatnia niewiększa od wartości
+ *                     @p players z funkcji @ref gamma_new.
+ * @return Wartość @p true, jeśli gracz jeszcze nie wykonał w tej rozgrywce
+ * złotego ruchu i któryś z jego złotych ruchów jest legalny, a @p false
+ * w przeciwnym przypadku.
+ */
+static bool golden_possible(gamma_t *g, uint32_t player) {
+    if (wrong_player(player, g))
+        return false;
+    if (g->players[player - 1].has_played_golden_move)
+        return false;
+
+    uint32_t players_with_fields = 0;
+    for (uint32_t d = 1; d <= MAX_PLAYER_DIGITS; d++)
+        players_with_fields += g->players_by_digits[d];
+    if (g->players[player - 1].busy_fields > 0)
+        players_with_fields--;
+    if (players_with_fields == 0)
+        return false;
+    if (g->players[player - 1].num_of_areas < g->max_num_of_areas)
+        return true;
+
+    TRACE_BEGIN(span);
+    bool possible = golden_possible_scan(g, player);
+    TRACE_END(span, "gamma_golden_possible", player);
+    return possible;
+}
+
+bool gamma_golden_possible(gamma_t *g, uint32_t player) {
+    bool possible = golden_possible(g, player);
+    if (g != NULL)
+        stack_shrink(g->stack, DFS_STACK_MIN_SIZE);
+    return possible;
+}
+
 char *gamma_board_interactive(gamma_t *g) {
     if (g == NULL)
         return NULL;
@@ -925,15 +1593,37 @@ char *gamma_board_interactive(gamma_t *g) {
     char *buffer = alloc_memory_for_board(g, max_width);
     if (buffer == NULL)
         return NULL;
-    gamma_board_helper(g, max_width, buffer);
+    gamma_board_helper(g, max_width, 0, g->width, 0, g->height, buffer);
     return buffer;
 }
 
+uint64_t gamma_board_interactive_buffer(gamma_t *g, char *buf, uint64_t len) {
+    if (g == NULL)
+        return 0;
+    uint32_t max_width = gamma_field_width_interactive(g);
+    uint64_t length = window_length(max_width, g->width, g->height);
+    if (buf == NULL || len <= length)
+        return length;
+    gamma_board_helper(g, max_width, 0, g->width, 0, g->height, buf);
+    return length;
+}
+
+bool gamma_cells(gamma_t *g, gamma_cells_t *cells) {
+    if (g == NULL || cells == NULL)
+        return false;
+    cells->owners = g->owners;
+    cells->owner_size = g->owner_size;
+    cells->stride = g->height;
+    cells->width = g->width;
+    cells->height = g->height;
+    return true;
+}
+
 bool gamma_write_field(gamma_t *g, char *s, uint32_t x, uint32_t y) {
     if (wrong_field(x, y, g))
         return false;
     uint32_t it = 0;
-    uint32_t player = g->player_arr[x][y];
+    uint32_t player = owner_at(g, x, y);
     if (player == NO_PLAYER) {
         s[it++] = NO_PLAYER_CHAR;
     } else {
@@ -948,10 +1638,7 @@ bool gamma_write_field(gamma_t *g, char *s, uint32_t x, uint32_t y) {
 bool gamma_move_possible(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
     if (wrong_field(x, y, g) || wrong_player(player, g))
         return false;
-    if (!gamma_move(g, player, x, y))
-        return false;
-    delete_util(g, x, y, player);
-    return true;
+    return move_legal(g, player, x, y);
 }
 
 uint32_t gamma_player_areas(gamma_t *g, uint32_t player) {
@@ -965,3 +1652,39 @@ uint32_t gamma_max_areas(gamma_t *g) {
         return 0;
     return g->max_num_of_areas;
 }
+
+uint32_t gamma_field_owner(gamma_t *g, uint32_t x, uint32_t y) {
+    if (g == NULL || wrong_field(x, y, g))
+        return NO_PLAYER;
+    return owner_at(g, x, y);
+}
+
+bool gamma_memory_usage(gamma_t *g, gamma_memory_t *usage) {
+    if (g == NULL || usage == NULL)
+        return false;
+    usage->game = sizeof(struct gamma) + PLAYER_SIZE * g->players_capacity
+                  + (sizeof(span_t) + UINT_32_SIZE) * g->width;
+    usage->board = g->owner_size * (uint64_t) g->width * g->height;
+    usage->parents = arr_2D_size(FIELD_SIZE, g->width, g->height);
+    usage->areas_size = arr_2D_size(UINT_64_SIZE, g->width, g->height);
+    usage->visited = arr_2D_size(UINT_32_SIZE, g->width, g->height);
+    usage->stack = stack_memory(g->stack);
+    usage->total = usage->game + usage->board + usage->parents
+                   + usage->areas_size + usage->visited + usage->stack;
+    return true;
+}
+
+bool gamma_stats(gamma_t *g, gamma_stats_t *stats) {
+#ifdef GAMMA_STATS
+    if (g == NULL)
+        return false;
+    *stats = g->stats;
+    stats->stack_resizes = stack_resizes(g->stack);
+    stats->stack_shrinks = stack_shrinks(g->stack);
+    return true;
+#else
+    (void) g;
+    (void) stats;
+    return false;
+#endif
+}
@@ -12,12 +12,52 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "gamma_allocator.h"
 
 /**
  * Struktura przechowująca stan gry.
  */
 typedef struct gamma gamma_t;
 
+/**
+ * @brief Liczniki operacji silnika gry.
+ * Zliczane tylko wtedy, gdy silnik skompilowano z makrem @p GAMMA_STATS
+ * (patrz @ref gamma_stats).
+ */
+typedef struct gamma_stats {
+    uint64_t find_parent_calls;   ///< Liczba wyszukań reprezentanta obszaru.
+    uint64_t find_parent_steps;   /**< Łączna długość ścieżek przebytych
+                                   * podczas wyszukiwania reprezentantów.
+                                   */
+    uint64_t dfs_cells;           /**< Liczba pól odwiedzonych przy
+                                   * przenumerowywaniu obszarów po złotym
+                                   * ruchu.
+                                   */
+    uint64_t stack_resizes;       ///< Liczba powiększeń stosu.
+    uint64_t stack_shrinks;       /**< Liczba zmniejszeń stosu po złotych
+                                   * ruchach i sprawdzeniach
+                                   * @ref gamma_golden_possible.
+                                   */
+    uint64_t golden_trials;       /**< Liczba próbnych złotych ruchów
+                                   * wykonanych przez
+                                   * @ref gamma_golden_possible.
+                                   */
+} gamma_stats_t;
+
+/**
+ * @brief Liczba bajtów zajmowanych przez grę, w podziale na struktury
+ * (patrz @ref gamma_memory_usage).
+ */
+typedef struct gamma_memory {
+    uint64_t game;       ///< Struktura gry i tablica graczy.
+    uint64_t board;      ///< Tablica numerów graczy zajmujących pola.
+    uint64_t parents;    ///< Tablica reprezentantów obszarów.
+    uint64_t areas_size; ///< Tablica rozmiarów obszarów.
+    uint64_t visited;    ///< Tablica znaczników odwiedzenia pól.
+    uint64_t stack;      ///< Stos używany przy przeszukiwaniu planszy.
+    uint64_t total;      ///< Suma wszystkich powyższych.
+} gamma_memory_t;
+
 /** @brief Tworzy strukturę przechowującą stan gry.
  * Alokuje pamięć na nową strukturę przechowującą stan gry.
  * Inicjuje tę strukturę tak, aby reprezentowała początkowy stan gry.
@@ -32,6 +72,69 @@ typedef struct gamma gamma_t;
 gamma_t *gamma_new(uint32_t width, uint32_t height,
                    uint32_t players, uint32_t areas);
 
+/** @brief Tworzy strukturę przechowującą stan gry w pamięci alokatora.
+ * Działa tak jak @ref gamma_new, ale całą pamięć gry, także później
+ * alokowaną (powiększenia stosu, tablice pomocnicze, kopie utworzone
+ * funkcją @ref gamma_copy), alokuje funkcjami alokatora @p allocator.
+ * Napisy zwracane przez @ref gamma_board są nadal alokowane funkcją
+ * @p malloc, bo zwalnia je wywołujący.
+ * @param[in] width     – szerokość planszy, liczba dodatnia,
+ * @param[in] height    – wysokość planszy, liczba dodatnia,
+ * @param[in] players   – liczba graczy, liczba dodatnia,
+ * @param[in] areas     – maksymalna liczba obszarów,
+ *                        jakie może zająć jeden gracz, liczba dodatnia,
+ * @param[in] allocator – wskaźnik na alokator, który musi istnieć aż do
+ *                        usunięcia gry, lub @p NULL, wtedy funkcja działa
+ *                        tak jak @ref gamma_new.
+ * @return Wskaźnik na utworzoną strukturę lub NULL, gdy nie udało się
+ * zaalokować pamięci lub któryś z parametrów jest niepoprawny.
+ */
+gamma_t *gamma_new_with_allocator(uint32_t width, uint32_t height,
+                                  uint32_t players, uint32_t areas,
+                                  const gamma_allocator_t *allocator);
+
+/** @brief Tworzy kopię struktury przechowującej stan gry.
+ * Alokuje pamięć na nową strukturę przechowującą stan gry i kopiuje do niej
+ * stan gry reprezentowany przez strukturę wskazywaną przez @p g. Kopia jest
+ * niezależna od oryginału: zmiany jednej z nich nie wpływają na drugą.
+ * Kopia jest alokowana tym samym alokatorem co oryginał.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry.
+ * @return Wskaźnik na utworzoną strukturę lub NULL, gdy nie udało się
+ * zaalokować pamięci lub @p g ma wartość NULL.
+ */
+gamma_t *gamma_copy(gamma_t *g);
+
+/** @brief Przywraca grę do stanu początkowego.
+ * Ustawia stan gry tak, jakby została utworzona wywołaniem
+ * @ref gamma_new z wymiarami planszy @p g i podanymi parametrami, ale bez
+ * ponownego alokowania planszy. Czyści tylko kolumny i wiersze planszy,
+ * które zostały zajęte od utworzenia gry lub ostatniego wywołania tej
+ * funkcji, więc po krótkiej rozgrywce na dużej planszy kosztuje znacznie
+ * mniej niż @ref gamma_delete i @ref gamma_new. Tablicę właścicieli pól
+ * alokuje na nowo tylko wtedy, gdy numery graczy przestają się mieścić
+ * w jej komórkach (patrz @ref gamma_cells_t).
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] players – liczba graczy, liczba dodatnia,
+ * @param[in] areas   – maksymalna liczba obszarów,
+ *                      jakie może zająć jeden gracz, liczba dodatnia.
+ * @return Wartość @p true, jeśli gra została przywrócona, @p false, jeśli
+ * któryś z parametrów jest niepoprawny lub nie udało się zaalokować pamięci
+ * na większą liczbę graczy; wtedy stan gry się nie zmienia.
+ */
+bool gamma_reset(gamma_t *g, uint32_t players, uint32_t areas);
+
+/** @brief Podaje szerokość planszy.
+ * @param[in] g – wskaźnik na strukturę przechowującą stan gry.
+ * @return Liczba kolumn planszy lub @p 0, jeśli @p g ma wartość NULL.
+ */
+uint32_t gamma_width(gamma_t *g);
+
+/** @brief Podaje wysokość planszy.
+ * @param[in] g – wskaźnik na strukturę przechowującą stan gry.
+ * @return Liczba wierszy planszy lub @p 0, jeśli @p g ma wartość NULL.
+ */
+uint32_t gamma_height(gamma_t *g);
+
 /** @brief Usuwa strukturę przechowującą stan gry.
  * Usuwa z pamięci strukturę wskazywaną przez @p g.
  * Nic nie robi, jeśli wskaźnik ten ma wartość NULL.
@@ -64,8 +167,9 @@ bool gamma_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y);
  * @param[in] y       – numer wiersza, liczba nieujemna mniejsza od wartości
  *                      @p height z funkcji @ref gamma_new.
  * @return Wartość @p true, jeśli ruch został wykonany, a @p false,
- * gdy gracz wykorzystał już swój złoty ruch, ruch jest nielegalny
- * lub któryś z parametrów jest niepoprawny.
+ * gdy gracz wykorzystał już swój złoty ruch, ruch jest nielegalny,
+ * któryś z parametrów jest niepoprawny lub nie udało się zaalokować
+ * pamięci na przeszukanie obszaru (wtedy stan gry się nie zmienia).
  */
 bool gamma_golden_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y);
 
@@ -99,10 +203,32 @@ uint64_t gamma_free_fields(gamma_t *g, uint32_t player);
  *                      @p players z funkcji @ref gamma_new.
  * @return Wartość @p true, jeśli gracz jeszcze nie wykonał w tej rozgrywce
  * złotego ruchu i istnieje pole, na które mógłby przy obecnym stanie planszy
- * wykonać złoty ruch, wartość @p false w przeciwnym przypadku.
+ * wykonać złoty ruch, wartość @p false w przeciwnym przypadku lub gdy nie
+ * udało się zaalokować pamięci na sprawdzenie któregoś pola.
  */
 bool gamma_golden_possible(gamma_t *g, uint32_t player);
 
+#define GAMMA_LEGAL_MOVE 1   ///< Bit mapy legalności: gracz może postawić pionek na polu.
+#define GAMMA_LEGAL_GOLDEN 2 ///< Bit mapy legalności: gracz może wykonać złoty ruch na pole.
+
+/** @brief Wyznacza, na które pola gracz może wykonać ruch.
+ * Dla każdego pola zapisuje w mapie bit @ref GAMMA_LEGAL_MOVE, jeśli
+ * @ref gamma_move gracza @p player na to pole by się udał, i bit
+ * @ref GAMMA_LEGAL_GOLDEN, jeśli udałby się @ref gamma_golden_move.
+ * Nie zmienia stanu gry i działa w czasie liniowym względem liczby pól:
+ * obszary, które złoty ruch mógłby podzielić ponad limit, przeszukiwane są
+ * raz, a nie osobno dla każdego pola.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
+ *                      @p players z funkcji @ref gamma_new,
+ * @param[out] map    – tablica @p width @p * @p height bajtów; bajt
+ *                      o indeksie @p y @p * @p width @p + @p x opisuje pole
+ *                      (@p x, @p y).
+ * @return Wartość @p true, jeśli mapa została wypełniona, @p false, jeśli
+ * któryś z parametrów jest niepoprawny lub nie udało się zaalokować pamięci.
+ */
+bool gamma_legal_map(gamma_t *g, uint32_t player, uint8_t *map);
+
 /** @brief Daje napis opisujący stan planszy.
  * Alokuje w pamięci bufor, w którym umieszcza napis zawierający tekstowy
  * opis aktualnego stanu planszy. Przykład znajduje się w pliku gamma_test.c.
@@ -113,6 +239,47 @@ bool gamma_golden_possible(gamma_t *g, uint32_t player);
  */
 char *gamma_board(gamma_t *g);
 
+/** @brief Zapisuje do bufora napis opisujący stan planszy.
+ * Zapisuje ten sam napis co @ref gamma_board, ale do bufora wywołującego,
+ * bez alokowania pamięci. Jeśli bufor jest za mały, funkcja niczego nie
+ * zapisuje, ale zwraca potrzebną długość, więc można ją najpierw wywołać
+ * z @p buf równym @p NULL.
+ * @param[in] g    – wskaźnik na strukturę przechowującą stan gry,
+ * @param[out] buf – bufor na napis lub @p NULL,
+ * @param[in] len  – rozmiar bufora w bajtach.
+ * @return Długość napisu (bez znaku końca łańcucha); napis został zapisany,
+ * jeśli jest ona mniejsza od @p len. Wartość @p 0, jeśli @p g ma wartość
+ * NULL.
+ */
+uint64_t gamma_board_buffer(gamma_t *g, char *buf, uint64_t len);
+
+/** @brief Zapisuje do bufora napis opisujący fragment planszy.
+ * Fragment składa się z pól (@p x, @p y), gdzie @p x0 <= @p x < @p x1
+ * i @p y0 <= @p y < @p y1. Pola formatowane są tak samo jak w
+ * @ref gamma_board (w szczególności mają tę samą szerokość), więc dla całej
+ * planszy napis jest równy wynikowi @ref gamma_board. Funkcja nie alokuje
+ * pamięci, a czas jej działania jest proporcjonalny do rozmiaru fragmentu.
+ * Jeśli bufor jest za mały, funkcja niczego nie zapisuje, ale zwraca
+ * potrzebną długość, więc można ją najpierw wywołać z @p buf równym
+ * @p NULL.
+ * @param[in] g    – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] y0   – numer pierwszego wiersza fragmentu,
+ * @param[in] y1   – numer wiersza za ostatnim wierszem fragmentu, większy
+ *                   od @p y0 i niewiększy od wartości @p height z funkcji
+ *                   @ref gamma_new,
+ * @param[in] x0   – numer pierwszej kolumny fragmentu,
+ * @param[in] x1   – numer kolumny za ostatnią kolumną fragmentu, większy
+ *                   od @p x0 i niewiększy od wartości @p width z funkcji
+ *                   @ref gamma_new,
+ * @param[out] buf – bufor na napis lub @p NULL,
+ * @param[in] len  – rozmiar bufora w bajtach.
+ * @return Długość napisu opisującego fragment (bez znaku końca łańcucha);
+ * napis został zapisany, jeśli jest ona mniejsza od @p len. Wartość @p 0,
+ * jeśli któryś z parametrów jest niepoprawny.
+ */
+uint64_t gamma_board_rows(gamma_t *g, uint32_t y0, uint32_t y1, uint32_t x0,
+                          uint32_t x1, char *buf, uint64_t len);
+
 /**
  * @brief Zwraca napis reprezentujący planszę zgodną z konwencją przyjętą
  * w wyświetlaniu planszy w trybie interaktywnym.
@@ -135,6 +302,77 @@ char *gamma_board(gamma_t *g);
  */
 char *gamma_board_interactive(gamma_t *g);
 
+/** @brief Zapisuje do bufora napis opisujący stan planszy w trybie
+ * interaktywnym.
+ * Zapisuje ten sam napis co @ref gamma_board_interactive, ale do bufora
+ * wywołującego, bez alokowania pamięci, na tych samych zasadach co
+ * @ref gamma_board_buffer.
+ * @param[in] g    – wskaźnik na strukturę przechowującą stan gry,
+ * @param[out] buf – bufor na napis lub @p NULL,
+ * @param[in] len  – rozmiar bufora w bajtach.
+ * @return Długość napisu (bez znaku końca łańcucha); napis został zapisany,
+ * jeśli jest ona mniejsza od @p len. Wartość @p 0, jeśli @p g ma wartość
+ * NULL.
+ */
+uint64_t gamma_board_interactive_buffer(gamma_t *g, char *buf, uint64_t len);
+
+/**
+ * @brief Struktura opisująca tablicę właścicieli pól planszy.
+ * Komórki tablicy mają po @p owner_size bajtów (@p 1, gdy graczy jest
+ * najwyżej 255, @p 2, gdy najwyżej 65535, a @p 4 w przeciwnym
+ * przypadku). Numer gracza zajmującego pole (@p x, @p y) lub @p 0, jeśli
+ * pole jest wolne, to komórka o indeksie @p x @p * @p stride @p + @p y;
+ * odczytuje ją @ref gamma_cells_owner.
+ */
+typedef struct gamma_cells {
+    const void *owners;     ///< Początek tablicy.
+    uint64_t stride;        ///< Odległość między kolejnymi kolumnami planszy.
+    uint32_t width;         ///< Liczba kolumn planszy.
+    uint32_t height;        ///< Liczba wierszy planszy.
+    uint8_t owner_size;     ///< Rozmiar komórki tablicy w bajtach.
+} gamma_cells_t;
+
+/** @brief Odczytuje właściciela pola z tablicy udostępnionej przez
+ * @ref gamma_cells.
+ * @param[in] cells – opis tablicy wypełniony przez @ref gamma_cells,
+ * @param[in] x     – numer kolumny, liczba nieujemna mniejsza od
+ *                    @p cells->width,
+ * @param[in] y     – numer wiersza, liczba nieujemna mniejsza od
+ *                    @p cells->height.
+ * @return Numer gracza zajmującego pole (@p x, @p y) lub @p 0, jeśli
+ * pole jest wolne.
+ */
+static inline uint32_t gamma_cells_owner(const gamma_cells_t *cells,
+                                         uint32_t x, uint32_t y) {
+    uint64_t i = x * cells->stride + y;
+    switch (cells->owner_size) {
+        case sizeof(uint8_t):
+            return ((const uint8_t *) cells->owners)[i];
+        case sizeof(uint16_t):
+            return ((const uint16_t *) cells->owners)[i];
+        default:
+            return ((const uint32_t *) cells->owners)[i];
+    }
+}
+
+/** @brief Udostępnia tablicę właścicieli pól planszy bez kopiowania.
+ * Tablica jest tylko do odczytu i należy do gry. Pozostaje ważna do
+ * usunięcia gry lub wywołania @ref gamma_reset (które może ją zastąpić
+ * tablicą o szerszych komórkach, jeśli przybędzie graczy), a jej
+ * zawartość zmieniają kolejne ruchy.
+ * @param[in] g      – wskaźnik na strukturę przechowującą stan gry,
+ * @param[out] cells – wskaźnik na strukturę, do której zostanie zapisany
+ *                     opis tablicy.
+ * @return Wartość @p true, jeśli opis został zapisany, @p false, jeśli
+ * któryś z parametrów ma wartość NULL.
+ */
+bool gamma_cells(gamma_t *g, gamma_cells_t *cells);
+
+#define GAMMA_MAX_FIELD_WIDTH 11 /**< Największa szerokość pola w napisowej
+                                  * reprezentacji planszy: dziesięć cyfr
+                                  * numeru gracza i spacja.
+                                  */
+
 /**
  * @brief Zwraca szerokosć pola w napisowej reprezentacji
  * planszy w trybie interaktywnym.
@@ -144,7 +382,8 @@ char *gamma_board_interactive(gamma_t *g);
  *                różny od @p NULL.
  * @return Wartość @p 1, jeśli dziesiętna reprezentacja liczby graczy
  * jest jednocyfrowa, w przeciwnym przypadku ilość cyfr w dziesiętnej
- * reprezentacji liczby graczy @p + @p 1.
+ * reprezentacji liczby graczy @p + @p 1, nie więcej niż
+ * @ref GAMMA_MAX_FIELD_WIDTH.
  */
 uint32_t gamma_field_width_interactive(gamma_t *g);
 
@@ -173,7 +412,7 @@ bool gamma_write_field(gamma_t *g, char *s, uint32_t x, uint32_t y);
  * @brief Sprawdza, czy gracz może wykonać ruch na danym polu.
  * Sprawdza, czy gracz o numerze @p player może wykonać ruch na polu
  * (@p x, @p y) w grze, której stan reprezentowany jest przez strukturę
- * wskazywaną przez @p g.
+ * wskazywaną przez @p g. Nie zmienia stanu gry i działa w czasie stałym.
  * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
  * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
  *                      @p players z funkcji @ref gamma_new,
@@ -212,4 +451,43 @@ uint32_t gamma_player_areas(gamma_t *g, uint32_t player);
  */
 uint32_t gamma_max_areas(gamma_t *g);
 
+/**
+ * @brief Zwraca numer gracza zajmującego pole.
+ * @param[in] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] x – numer kolumny, liczba nieujemna mniejsza od wartości
+ *                @p width z funkcji @ref gamma_new,
+ * @param[in] y – numer wiersza, liczba nieujemna mniejsza od wartości
+ *                @p height z funkcji @ref gamma_new.
+ * @return Numer gracza zajmującego pole @p (x, @p y) lub wartość @p 0,
+ * jeśli pole jest wolne lub któryś z parametrów jest niepoprawny.
+ */
+uint32_t gamma_field_owner(gamma_t *g, uint32_t x, uint32_t y);
+
+/**
+ * @brief Odczytuje, ile pamięci zajmuje gra.
+ * Podaje rozmiary zaalokowanych struktur bez narzutu alokatora. Napisy
+ * zwracane przez @ref gamma_board i @ref gamma_board_interactive należą do
+ * wywołującego i nie są wliczane. Łączne liczniki alokacji wszystkich gier
+ * i limit zajętej pamięci udostępnia memory_util.h.
+ * @param[in] g      – wskaźnik na strukturę przechowującą stan gry,
+ * @param[out] usage – wskaźnik na strukturę, do której zostaną zapisane
+ *                     rozmiary.
+ * @return Wartość @p true, jeśli rozmiary zostały odczytane, @p false, jeśli
+ * któryś z parametrów ma wartość NULL.
+ */
+bool gamma_memory_usage(gamma_t *g, gamma_memory_t *usage);
+
+/**
+ * @brief Odczytuje liczniki operacji silnika gry.
+ * Liczniki zliczane są od utworzenia gry (także przez @ref gamma_copy),
+ * o ile silnik skompilowano z makrem @p GAMMA_STATS; bez niego zliczanie
+ * nic nie kosztuje, a funkcja zawsze zwraca @p false.
+ * @param[in] g      – wskaźnik na strukturę przechowującą stan gry,
+ * @param[out] stats – wskaźnik na strukturę, do której zostaną zapisane
+ *                     liczniki.
+ * @return Wartość @p true, jeśli liczniki zostały odczytane, @p false, jeśli
+ * silnik skompilowano bez liczników lub @p g ma wartość NULL.
+ */
+bool gamma_stats(gamma_t *g, gamma_stats_t *stats);
+
 #endif /* GAMMA_H */
@@ -0,0 +1,40 @@
+/** @file
+ * Interfejs alokatora pamięci gry.
+ *
+ * Gra utworzona funkcją @ref gamma_new_with_allocator alokuje całą swoją
+ * pamięć (strukturę gry, tablice planszy, stos przeszukiwania i tablice
+ * pomocnicze) przez funkcje podanego alokatora. Alokator może więc umieścić
+ * grę np. w arenie wątku (patrz arena.h) lub w pamięci lokalnej dla węzła
+ * NUMA. Wyjątkiem są napisy zwracane przez @ref gamma_board, które
+ * wywołujący zwalnia funkcją @p free.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#ifndef GAMMA_GAMMA_ALLOCATOR_H
+#define GAMMA_GAMMA_ALLOCATOR_H
+
+#include <stddef.h>
+
+/**
+ * @brief Struktura opisująca alokator pamięci.
+ * Funkcje dostają rozmiar każdego zwalnianego i realokowanego bloku, więc
+ * alokator nie musi go pamiętać. Zwrócona pamięć musi być wyrównana tak jak
+ * pamięć zwracana przez @p malloc.
+ */
+typedef struct gamma_allocator {
+    /** @brief Alokuje @p size bajtów, niekoniecznie wyzerowanych;
+     * zwraca @p NULL, jeśli się nie udało. */
+    void *(*alloc)(void *ctx, size_t size);
+    /** @brief Zmienia rozmiar bloku z @p old_size na @p new_size bajtów,
+     * zachowując jego zawartość; zwraca @p NULL i nie zmienia bloku, jeśli
+     * się nie udało. */
+    void *(*realloc)(void *ctx, void *ptr, size_t old_size, size_t new_size);
+    /** @brief Zwalnia blok o rozmiarze @p size bajtów. */
+    void (*free)(void *ctx, void *ptr, size_t size);
+    void *ctx; ///< Argument przekazywany funkcjom alokatora.
+} gamma_allocator_t;
+
+#endif //GAMMA_GAMMA_ALLOCATOR_H
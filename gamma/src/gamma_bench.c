@@ -0,0 +1,399 @@
+/** @file
+ * Pomiar wydajności funkcji silnika gry.
+ *
+ * Dla każdego obciążenia z bench_workload.h program wykonuje wygenerowany
+ * ciąg wywołań, mierząc czas każdego wywołania osobno, i wypisuje średni
+ * czas jednego wywołania każdej funkcji z gamma.h. Z kilku przebiegów
+ * brany jest najkrótszy łączny czas danej funkcji. Jeśli jądro na to
+ * pozwala, wokół każdego wywołania odczytywane są też sprzętowe liczniki
+ * wydajności (patrz perf_counters.h); w przeciwnym przypadku, lub z opcją
+ * @p -W, mierzony jest tylko czas. Od pomiarów odejmowany jest koszt
+ * samego pomiaru.
+ *
+ * Wynik ma postać wierszy @p workload @p function @p calls @p ns_per_op
+ * @p cycles @p instructions @p cache_misses @p branch_misses (wartości
+ * liczników na jedno wywołanie lub @p -, gdy liczniki są niedostępne)
+ * oddzielonych spacjami; wiersze zaczynające się znakiem @p # są
+ * komentarzami. Suma kontrolna wyników wywołań pozwala sprawdzić, że
+ * porównywane wersje silnika zachowują się tak samo.
+ *
+ * Wywołanie: @p gamma_bench [@p -s @p seed] [@p -w @p workload]
+ * [@p -r @p runs] [@p -d @p divisor] [@p -W].
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#define _GNU_SOURCE ///< Makro potrzebne do prawidłowej kompilacji.
+
+#include "bench_workload.h"
+#include "gamma.h"
+#include "int_to_string_util.h"
+#include "perf_counters.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_SEED 2020 ///< Domyślne ziarno generatora obciążeń.
+#define DEFAULT_RUNS 3 ///< Domyślna liczba przebiegów każdego obciążenia.
+#define MAX_DIVISOR 64 ///< Największy dzielnik rozmiaru obciążeń.
+#define CALIBRATION_ROUNDS 100000 ///< Liczba pustych pomiarów wyznaczających koszt pomiaru.
+#define FNV_OFFSET 14695981039346656037ull ///< Początkowa wartość skrótu FNV-1a.
+#define FNV_PRIME 1099511628211ull ///< Mnożnik skrótu FNV-1a.
+
+/**
+ * @brief Struktura przechowująca wynik jednego przebiegu obciążenia.
+ */
+typedef struct bench_result {
+    uint64_t ns[BENCH_FN_COUNT];    ///< Łączny czas wywołań każdej funkcji.
+    uint64_t calls[BENCH_FN_COUNT]; ///< Liczba wywołań każdej funkcji.
+    uint64_t events[BENCH_FN_COUNT][PERF_COUNTERS]; /**< Łączne przyrosty
+                                                     * liczników sprzętowych
+                                                     * dla każdej funkcji.
+                                                     */
+    uint64_t checksum;              ///< Suma kontrolna wyników wywołań.
+} bench_result_t;
+
+/**
+ * @brief Struktura przechowująca ustawienia pomiaru.
+ */
+typedef struct bench {
+    perf_counters_t counters; ///< Liczniki sprzętowe.
+    bool use_counters;        ///< Równe @p true, jeśli liczniki są otwarte.
+    double overhead_ns;       ///< Koszt pustego pomiaru w nanosekundach.
+    double overhead_events[PERF_COUNTERS]; /**< Przyrosty liczników
+                                            * w pustym pomiarze.
+                                            */
+} bench_t;
+
+/**
+ * @brief Struktura przechowująca stan pomiaru jednego wywołania.
+ */
+typedef struct probe {
+    uint64_t start;                 ///< Czas rozpoczęcia w nanosekundach.
+    bool valid;                     ///< Równe @p true, jeśli odczytano liczniki.
+    uint64_t events[PERF_COUNTERS]; ///< Wartości liczników na początku.
+} probe_t;
+
+/**
+ * @brief Zwraca bieżący czas w nanosekundach.
+ * @return Czas zegara monotonicznego w nanosekundach.
+ */
+static uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/**
+ * @brief Rozpoczyna pomiar wywołania.
+ * @param[in] b  – ustawienia pomiaru,
+ * @param[out] p – stan pomiaru.
+ */
+static void probe_begin(const bench_t *b, probe_t *p) {
+    p->valid = b->use_counters && perf_counters_read(&b->counters, p->events);
+    p->start = now_ns();
+}
+
+/**
+ * @brief Kończy pomiar wywołania i dolicza go do wyniku funkcji.
+ * @param[in] b     – ustawienia pomiaru,
+ * @param[in] p     – stan pomiaru,
+ * @param[in,out] r – wynik przebiegu,
+ * @param[in] fn    – mierzona funkcja.
+ */
+static void probe_end(const bench_t *b, const probe_t *p, bench_result_t *r,
+                      bench_fn_t fn) {
+    r->ns[fn] += now_ns() - p->start;
+    r->calls[fn]++;
+    uint64_t events[PERF_COUNTERS];
+    if (p->valid && perf_counters_read(&b->counters, events)) {
+        for (int i = 0; i < PERF_COUNTERS; i++)
+            r->events[fn][i] += events[i] - p->events[i];
+    }
+}
+
+/**
+ * @brief Mierzy koszt samego pomiaru.
+ * Zapisuje w @p b średni czas i przyrosty liczników pustego pomiaru.
+ * @param[in,out] b – ustawienia pomiaru.
+ */
+static void calibrate(bench_t *b) {
+    static bench_result_t r;
+    probe_t p;
+    for (int i = 0; i < CALIBRATION_ROUNDS; i++) {
+        probe_begin(b, &p);
+        probe_end(b, &p, &r, BENCH_NEW);
+    }
+    b->overhead_ns = (double) r.ns[BENCH_NEW] / CALIBRATION_ROUNDS;
+    for (int i = 0; i < PERF_COUNTERS; i++)
+        b->overhead_events[i] = (double) r.events[BENCH_NEW][i] / CALIBRATION_ROUNDS;
+}
+
+/**
+ * @brief Dołącza liczbę do sumy kontrolnej (FNV-1a).
+ * @param[in] hash  – dotychczasowa suma kontrolna,
+ * @param[in] value – dołączana liczba.
+ * @return Nowa suma kontrolna.
+ */
+static uint64_t mix(uint64_t hash, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        hash ^= (value >> (8 * i)) & 0xFF;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Wylicza skrót napisu.
+ * @param[in] s – napis lub @p NULL.
+ * @return Skrót napisu, @p 0 dla @p NULL.
+ */
+static uint64_t hash_string(const char *s) {
+    if (s == NULL)
+        return 0;
+    uint64_t hash = FNV_OFFSET;
+    for (; *s != '\0'; s++) {
+        hash ^= (unsigned char) *s;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Wykonuje jedno wywołanie z obciążenia i mierzy jego czas.
+ * Czas zwalniania napisów i kopii gry nie jest wliczany.
+ * @param[in] b         – ustawienia pomiaru,
+ * @param[in,out] g     – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] op        – wywołanie,
+ * @param[in,out] field – bufor na napisową reprezentację pola,
+ * @param[in,out] r     – wynik przebiegu.
+ */
+static void execute(const bench_t *b, gamma_t *g, const bench_op_t *op,
+                    char *field, bench_result_t *r) {
+    uint64_t value = 0;
+    char *s = NULL;
+    gamma_t *copy = NULL;
+    probe_t p;
+    probe_begin(b, &p);
+    switch (op->fn) {
+        case BENCH_COPY:
+            copy = gamma_copy(g);
+            break;
+        case BENCH_MOVE:
+            value = gamma_move(g, op->player, op->x, op->y);
+            break;
+        case BENCH_GOLDEN_MOVE:
+            value = gamma_golden_move(g, op->player, op->x, op->y);
+            break;
+        case BENCH_BUSY_FIELDS:
+            value = gamma_busy_fields(g, op->player);
+            break;
+        case BENCH_FREE_FIELDS:
+            value = gamma_free_fields(g, op->player);
+            break;
+        case BENCH_GOLDEN_POSSIBLE:
+            value = gamma_golden_possible(g, op->player);
+            break;
+        case BENCH_BOARD:
+            s = gamma_board(g);
+            break;
+        case BENCH_BOARD_INTERACTIVE:
+            s = gamma_board_interactive(g);
+            break;
+        case BENCH_FIELD_WIDTH_INTERACTIVE:
+            value = gamma_field_width_interactive(g);
+            break;
+        case BENCH_WRITE_FIELD:
+            value = gamma_write_field(g, field, op->x, op->y);
+            break;
+        case BENCH_MOVE_POSSIBLE:
+            value = gamma_move_possible(g, op->player, op->x, op->y);
+            break;
+        case BENCH_PLAYER_AREAS:
+            value = gamma_player_areas(g, op->player);
+            break;
+        case BENCH_MAX_AREAS:
+            value = gamma_max_areas(g);
+    }
+    probe_end(b, &p, r, op->fn);
+    if (s != NULL) {
+        value = hash_string(s);
+        free(s);
+    }
+    if (copy != NULL) {
+        value = gamma_busy_fields(copy, 1);
+        gamma_delete(copy);
+    }
+    r->checksum = mix(r->checksum, value);
+}
+
+/**
+ * @brief Przeprowadza jeden przebieg obciążenia.
+ * @param[in] b  – ustawienia pomiaru,
+ * @param[in] w  – obciążenie,
+ * @param[out] r – wynik przebiegu.
+ * @return Wartość @p false, jeśli nie udało się utworzyć gry.
+ */
+static bool run(const bench_t *b, const workload_t *w, bench_result_t *r) {
+    memset(r, 0, sizeof(bench_result_t));
+    r->checksum = FNV_OFFSET;
+    probe_t p;
+    probe_begin(b, &p);
+    gamma_t *g = gamma_new(w->width, w->height, w->players, w->areas);
+    probe_end(b, &p, r, BENCH_NEW);
+    if (g == NULL)
+        return false;
+    char *field = malloc(gamma_field_width_interactive(g) + 1);
+    if (field == NULL) {
+        gamma_delete(g);
+        return false;
+    }
+    for (size_t i = 0; i < w->count; i++)
+        execute(b, g, &w->ops[i], field, r);
+    free(field);
+    probe_begin(b, &p);
+    gamma_delete(g);
+    probe_end(b, &p, r, BENCH_DELETE);
+    return true;
+}
+
+/**
+ * @brief Wypisuje średnią wartość na jedno wywołanie po odjęciu kosztu
+ * pomiaru.
+ * @param[in] total    – łączna wartość,
+ * @param[in] calls    – liczba wywołań, dodatnia,
+ * @param[in] overhead – koszt pomiaru.
+ */
+static void print_per_call(uint64_t total, uint64_t calls, double overhead) {
+    double value = (double) total / calls - overhead;
+    printf(" %.1f", value > 0 ? value : 0);
+}
+
+/**
+ * @brief Mierzy i wypisuje wyniki jednego obciążenia.
+ * Dla każdej funkcji i każdej mierzonej wielkości brana jest najmniejsza
+ * wartość z przebiegów.
+ * @param[in] b    – ustawienia pomiaru,
+ * @param[in] w    – obciążenie,
+ * @param[in] runs – liczba przebiegów, dodatnia.
+ * @return Wartość @p false, jeśli nie udało się przeprowadzić pomiaru lub
+ * przebiegi dały różne sumy kontrolne.
+ */
+static bool measure(const bench_t *b, const workload_t *w, uint32_t runs) {
+    static bench_result_t best, r;
+    if (!run(b, w, &best))
+        return false;
+    for (uint32_t i = 1; i < runs; i++) {
+        if (!run(b, w, &r) || r.checksum != best.checksum)
+            return false;
+        for (int fn = 0; fn < BENCH_FN_COUNT; fn++) {
+            if (r.ns[fn] < best.ns[fn])
+                best.ns[fn] = r.ns[fn];
+            for (int k = 0; k < PERF_COUNTERS; k++) {
+                if (r.events[fn][k] < best.events[fn][k])
+                    best.events[fn][k] = r.events[fn][k];
+            }
+        }
+    }
+    for (int fn = 0; fn < BENCH_FN_COUNT; fn++) {
+        if (best.calls[fn] == 0)
+            continue;
+        printf("%s %s %lu", w->name, bench_fn_name(fn), best.calls[fn]);
+        print_per_call(best.ns[fn], best.calls[fn], b->overhead_ns);
+        for (int k = 0; k < PERF_COUNTERS; k++) {
+            if (b->use_counters)
+                print_per_call(best.events[fn][k], best.calls[fn],
+                               b->overhead_events[k]);
+            else
+                printf(" -");
+        }
+        printf("\n");
+    }
+    printf("# %s %ux%u players %u areas %u checksum %016lx\n", w->name,
+           w->width, w->height, w->players, w->areas, best.checksum);
+    fflush(stdout);
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    uint64_t seed = DEFAULT_SEED;
+    uint32_t runs = DEFAULT_RUNS;
+    uint32_t divisor = 1;
+    const char *only = NULL;
+    bool wall_time_only = false;
+    bool bad_number = false;
+    uint64_t n = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "s:w:r:d:W")) != -1) {
+        switch (opt) {
+            case 's':
+                bad_number |= !parse_number(optarg, UINT64_MAX, &seed);
+                break;
+            case 'w':
+                only = optarg;
+                break;
+            case 'r':
+                bad_number |= !parse_number(optarg, UINT32_MAX, &n);
+                runs = n;
+                break;
+            case 'd':
+                bad_number |= !parse_number(optarg, MAX_DIVISOR, &n);
+                divisor = n;
+                break;
+            case 'W':
+                wall_time_only = true;
+                break;
+            default:
+                runs = 0;
+        }
+    }
+    if (bad_number || optind < argc || runs == 0 || divisor == 0) {
+        fprintf(stderr, "usage: %s [-s seed] [-w workload] [-r runs] "
+                        "[-d divisor] [-W]\n", argv[0]);
+        return 1;
+    }
+
+    static bench_t b;
+    if (!wall_time_only) {
+        b.use_counters = perf_counters_open(&b.counters);
+        if (!b.use_counters)
+            printf("# hardware counters unavailable (%s), wall time only\n",
+                   strerror(errno));
+    }
+    calibrate(&b);
+    printf("# gamma_bench seed %lu runs %u divisor %u overhead %.1f ns\n",
+           seed, runs, divisor, b.overhead_ns);
+    printf("# workload function calls ns_per_op");
+    for (int k = 0; k < PERF_COUNTERS; k++)
+        printf(" %s", perf_counter_name(k));
+    printf("\n");
+    bool found = false;
+    for (size_t i = 0; i < workload_count(); i++) {
+        if (only != NULL && strcmp(only, workload_name(i)) != 0)
+            continue;
+        found = true;
+        workload_t w;
+        if (!workload_generate(&w, i, seed, divisor)) {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+        bool ok = measure(&b, &w, runs);
+        workload_free(&w);
+        if (!ok) {
+            fprintf(stderr, "%s: measurement failed\n", workload_name(i));
+            return 1;
+        }
+    }
+    if (b.use_counters)
+        perf_counters_close(&b.counters);
+    if (!found) {
+        fprintf(stderr, "unknown workload %s\n", only);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,159 @@
+/** @file
+ * Konwerter między tekstowym a binarnym protokołem trybu wsadowego.
+ *
+ * Wywołanie @p gamma_convert @p -b [@p records] zamienia tekstowy zapis
+ * rozgrywki w trybie wsadowym (polecenie @p B i kolejne polecenia) na wejście
+ * trybu binarnego, grupując po @p records rekordów w ramce (domyślnie
+ * @ref DEFAULT_FRAME_RECORDS). Zignorowane wiersze są pomijane, a każdy
+ * niepoprawny wiersz zamieniany jest na rekord o kodzie @p 0, na który
+ * program odpowie błędem, tak by odpowiedzi odpowiadały kolejnym
+ * nieignorowanym wierszom.
+ *
+ * Wywołanie @p gamma_convert @p -t zamienia wyjście trybu binarnego na
+ * napisy, jakie wypisałby tryb wsadowy. Błędy wypisywane są na @p stderr
+ * jako @p ERROR @p n, gdzie @p n to numer rekordu liczony od @p 1.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#define _GNU_SOURCE ///< Makro potrzebne do prawidłowej kompilacji.
+
+#include "binary_protocol.h"
+#include "command.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_FRAME_RECORDS 64 ///< Domyślna liczba rekordów w ramce.
+#define GETLINE_FAILURE -1 /**< Stała zwracana przez @p getline,
+                            * gdy nie uda się wczytać linii.
+                            */
+#define ULL unsigned long long ///< Makro definiujące typ @p unsigned @p long @p long.
+
+/**
+ * @brief Wypisuje ramkę złożoną z @p count rekordów z bufora @p records.
+ * @param[in] records – bufor zawierający rekordy,
+ * @param[in] count   – liczba rekordów.
+ */
+static void flush_frame(const unsigned char *records, uint32_t count) {
+    unsigned char header[BINARY_HEADER_SIZE];
+    if (count == 0)
+        return;
+    binary_encode_header(header, count);
+    fwrite(header, BINARY_HEADER_SIZE, 1, stdout);
+    fwrite(records, BINARY_RECORD_SIZE, count, stdout);
+}
+
+/**
+ * @brief Zamienia tekstowy zapis rozgrywki na wejście trybu binarnego.
+ * @param[in] frame_records – maksymalna liczba rekordów w ramce, dodatnia.
+ * @return Kod zakończenia programu.
+ */
+static int text_to_binary(uint32_t frame_records) {
+    char *line = NULL;
+    size_t size = 0;
+    ssize_t len;
+    bool started = false;
+    unsigned char *records = malloc((size_t) frame_records * BINARY_RECORD_SIZE);
+    if (records == NULL)
+        return 1;
+    uint32_t count = 0;
+    while ((len = getline(&line, &size, stdin)) != GETLINE_FAILURE) {
+        if (line[0] == IGNORE_LINE || line[0] == END_LINE)
+            continue;
+        if (!started) {
+            if (line[0] != 'B') {
+                fprintf(stderr, "expected B command, got: %s", line);
+                free(records);
+                free(line);
+                return 1;
+            }
+            line[0] = BINARY_MODE;
+            fwrite(line, 1, len, stdout);
+            started = true;
+            continue;
+        }
+        command_t cmd = {0, {0}};
+        if (command_parse_line(line, len, &cmd) != LINE_OK)
+            cmd.type = 0;
+        binary_encode_command(records + (size_t) count * BINARY_RECORD_SIZE, &cmd);
+        if (++count == frame_records) {
+            flush_frame(records, count);
+            count = 0;
+        }
+    }
+    flush_frame(records, count);
+    free(records);
+    free(line);
+    return 0;
+}
+
+/**
+ * @brief Zamienia wyjście trybu binarnego na napisy trybu wsadowego.
+ * @return Kod zakończenia programu.
+ */
+static int binary_to_text() {
+    char *line = NULL;
+    size_t size = 0;
+    if (getline(&line, &size, stdin) == GETLINE_FAILURE) {
+        free(line);
+        return 1;
+    }
+    fputs(line, stdout);
+    free(line);
+
+    unsigned char header[BINARY_HEADER_SIZE];
+    unsigned char record[BINARY_RECORD_SIZE];
+    ULL number = 1;
+    while (fread(header, BINARY_HEADER_SIZE, 1, stdin) == 1) {
+        uint32_t count = binary_decode_header(header);
+        for (uint32_t i = 0; i < count; i++, number++) {
+            if (fread(record, BINARY_RECORD_SIZE, 1, stdin) != 1)
+                return 1;
+            binary_response_t res;
+            binary_decode_response(record, &res);
+            if (res.status != BINARY_STATUS_OK) {
+                fprintf(stderr, "ERROR %llu\n", number);
+            } else if (res.opcode == P || res.opcode == STATS
+                       || res.opcode == MEMORY) {
+                for (uint64_t j = 0; j < res.value; j++) {
+                    int c = getchar();
+                    if (c == EOF)
+                        return 1;
+                    putchar(c);
+                }
+            } else if (res.opcode == SMALL_B || res.opcode == F) {
+                printf("%lu\n", res.value);
+            } else {
+                printf("%d\n", res.value != 0);
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Wypisuje sposób użycia programu.
+ * @param[in] name – nazwa programu.
+ * @return Kod zakończenia programu.
+ */
+static int usage(const char *name) {
+    fprintf(stderr, "usage: %s -b [records_per_frame] | -t\n", name);
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc >= 2 && strcmp(argv[1], "-b") == 0 && argc <= 3) {
+        uint32_t frame_records = DEFAULT_FRAME_RECORDS;
+        if (argc == 3)
+            frame_records = strtoul(argv[2], NULL, 10);
+        if (frame_records == 0)
+            return usage(argv[0]);
+        return text_to_binary(frame_records);
+    }
+    if (argc == 2 && strcmp(argv[1], "-t") == 0)
+        return binary_to_text();
+    return usage(argv[0]);
+}
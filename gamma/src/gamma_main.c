@@ -1,6 +1,88 @@
+#define _GNU_SOURCE
+
 #include "parser.h"
+#include "server.h"
+#include "trace.h"
+#include "memory_util.h"
+#include "int_to_string_util.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * Największa liczba wątków, którą można podać w opcjach programu.
+ */
+#define MAX_THREADS 1024
+
+/**
+ * @brief Wypisuje sposób użycia programu.
+ * @param[in] name – nazwa programu.
+ * @return Kod zakończenia programu.
+ */
+static int usage(const char *name) {
+    fprintf(stderr, "usage: %s [-a threads] [-j threads] [-m bytes] "
+                    "[-t] [-T trace.json] "
+                    "[-s socket [-w workers]]\n", name);
+    return 1;
+}
 
-int main() {
-    read_input();
+int main(int argc, char *argv[]) {
+    parser_options_t options = {0};
+    const char *socket_path = NULL;
+    uint32_t workers = 0;
+    uint64_t n;
+    int opt;
+    while ((opt = getopt(argc, argv, "a:j:m:s:tT:w:")) != -1) {
+        switch (opt) {
+            case 'a':
+                if (!parse_number(optarg, MAX_THREADS, &n))
+                    return usage(argv[0]);
+                options.async_queries = true;
+                options.query_threads = n;
+                break;
+            case 'j':
+                if (!parse_number(optarg, MAX_THREADS, &n))
+                    return usage(argv[0]);
+                options.parallel_parse = true;
+                options.parse_threads = n;
+                break;
+            case 'm':
+                if (!parse_number(optarg, UINT64_MAX, &n))
+                    return usage(argv[0]);
+                mem_set_limit(n);
+                break;
+            case 's':
+                socket_path = optarg;
+                break;
+            case 't':
+                options.command_timing = true;
+                break;
+            case 'T':
+                options.trace_path = optarg;
+                break;
+            case 'w':
+                if (!parse_number(optarg, MAX_THREADS, &n))
+                    return usage(argv[0]);
+                workers = n;
+                break;
+            default:
+                return usage(argv[0]);
+        }
+    }
+    if (options.trace_path != NULL && !trace_enabled()) {
+        fprintf(stderr, "%s: built without tracing, configure with "
+                        "-DGAMMA_TRACE=ON\n", argv[0]);
+        return 1;
+    }
+    if (socket_path != NULL) {
+        if (!server_run(socket_path, workers)) {
+            perror(socket_path);
+            return 1;
+        }
+        return 0;
+    }
+    read_input(&options);
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,89 @@
+/** @file
+ * Zawiera implementację interfejsu gamma_pool.h
+ *
+ * Gry są przechowywane w tablicy w kolejności oddania. Pula jest mała, więc
+ * gra o danych wymiarach jest wyszukiwana liniowo od końca tablicy, czyli od
+ * ostatnio oddanej, której plansza najpewniej jest jeszcze w pamięci
+ * podręcznej.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#include "gamma_pool.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Struktura przechowująca pulę gier.
+ */
+struct gamma_pool {
+    gamma_t **idle;    ///< Przechowywane gry, od najdawniej oddanej.
+    uint32_t count;    ///< Liczba przechowywanych gier.
+    uint32_t max_idle; ///< Największa liczba przechowywanych gier.
+};
+
+/**
+ * @brief Usuwa grę z tablicy puli, nie zwalniając jej.
+ * @param[in,out] pool – wskaźnik na pulę,
+ * @param[in] i        – indeks gry, mniejszy od liczby gier w puli.
+ * @return Wskaźnik na usuniętą grę.
+ */
+static gamma_t *take_idle(gamma_pool_t *pool, uint32_t i) {
+    gamma_t *g = pool->idle[i];
+    memmove(pool->idle + i, pool->idle + i + 1,
+            (pool->count - i - 1) * sizeof(gamma_t *));
+    pool->count--;
+    return g;
+}
+
+gamma_pool_t *gamma_pool_new(uint32_t max_idle) {
+    gamma_pool_t *pool = malloc(sizeof(gamma_pool_t));
+    if (pool == NULL)
+        return NULL;
+    pool->count = 0;
+    pool->max_idle = max_idle;
+    pool->idle = malloc((max_idle > 0 ? max_idle : 1) * sizeof(gamma_t *));
+    if (pool->idle == NULL) {
+        free(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+void gamma_pool_delete(gamma_pool_t *pool) {
+    if (pool == NULL)
+        return;
+    for (uint32_t i = 0; i < pool->count; i++)
+        gamma_delete(pool->idle[i]);
+    free(pool->idle);
+    free(pool);
+}
+
+gamma_t *gamma_pool_get(gamma_pool_t *pool, uint32_t width, uint32_t height,
+                        uint32_t players, uint32_t areas) {
+    if (pool != NULL && players >= 1 && areas >= 1) {
+        for (uint32_t i = pool->count; i-- > 0;) {
+            gamma_t *g = pool->idle[i];
+            if (gamma_width(g) == width && gamma_height(g) == height) {
+                if (!gamma_reset(g, players, areas))
+                    break;
+                return take_idle(pool, i);
+            }
+        }
+    }
+    return gamma_new(width, height, players, areas);
+}
+
+void gamma_pool_put(gamma_pool_t *pool, gamma_t *g) {
+    if (g == NULL)
+        return;
+    if (pool == NULL || pool->max_idle == 0) {
+        gamma_delete(g);
+        return;
+    }
+    if (pool->count == pool->max_idle)
+        gamma_delete(take_idle(pool, 0));
+    pool->idle[pool->count++] = g;
+}
@@ -0,0 +1,73 @@
+/** @file
+ * Interfejs puli gier do ponownego użycia.
+ *
+ * Pula przechowuje zakończone gry zamiast je usuwać. Gra o takich samych
+ * wymiarach planszy jest potem wydawana ponownie po przywróceniu jej do
+ * stanu początkowego funkcją @ref gamma_reset, więc krótkie gry na planszach
+ * tych samych rozmiarów nie alokują ani nie zerują całej planszy. Pula nie
+ * jest bezpieczna wątkowo; każdy wątek powinien mieć własną.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#ifndef GAMMA_GAMMA_POOL_H
+#define GAMMA_GAMMA_POOL_H
+
+#include "gamma.h"
+#include <stdint.h>
+
+#define GAMMA_POOL_DEFAULT_IDLE 16 ///< Domyślna liczba przechowywanych gier.
+
+/**
+ * @brief Struktura przechowująca pulę gier.
+ */
+typedef struct gamma_pool gamma_pool_t;
+
+/**
+ * @brief Tworzy pustą pulę gier.
+ * @param[in] max_idle – największa liczba gier przechowywanych w puli.
+ * @return Wskaźnik na pulę lub @p NULL, jeśli nie udało się zaalokować
+ * pamięci.
+ */
+gamma_pool_t *gamma_pool_new(uint32_t max_idle);
+
+/**
+ * @brief Usuwa pulę wraz z przechowywanymi w niej grami.
+ * Nic nie robi, jeśli @p pool ma wartość @p NULL.
+ * @param[in,out] pool – wskaźnik na pulę.
+ */
+void gamma_pool_delete(gamma_pool_t *pool);
+
+/**
+ * @brief Wydaje grę w stanie początkowym.
+ * Jeśli w puli jest gra o planszy rozmiaru @p width na @p height, przywraca
+ * ją do stanu początkowego i wydaje; w przeciwnym przypadku tworzy nową grę
+ * funkcją @ref gamma_new. Parametry mają takie samo znaczenie jak
+ * w @ref gamma_new.
+ * @param[in,out] pool – wskaźnik na pulę lub @p NULL, wtedy gra jest zawsze
+ *                       tworzona od nowa,
+ * @param[in] width    – szerokość planszy, liczba dodatnia,
+ * @param[in] height   – wysokość planszy, liczba dodatnia,
+ * @param[in] players  – liczba graczy, liczba dodatnia,
+ * @param[in] areas    – maksymalna liczba obszarów,
+ *                       jakie może zająć jeden gracz, liczba dodatnia.
+ * @return Wskaźnik na grę, której właścicielem staje się wywołujący, lub
+ * @p NULL, gdy któryś z parametrów jest niepoprawny lub nie udało się
+ * zaalokować pamięci.
+ */
+gamma_t *gamma_pool_get(gamma_pool_t *pool, uint32_t width, uint32_t height,
+                        uint32_t players, uint32_t areas);
+
+/**
+ * @brief Oddaje grę do puli.
+ * Od tej chwili pula jest właścicielem gry. Jeśli pula jest pełna, usuwa
+ * najdawniej oddaną grę. Nic nie robi, jeśli @p g ma wartość @p NULL.
+ * @param[in,out] pool – wskaźnik na pulę lub @p NULL, wtedy gra jest
+ *                       usuwana,
+ * @param[in] g        – wskaźnik na grę.
+ */
+void gamma_pool_put(gamma_pool_t *pool, gamma_t *g);
+
+#endif //GAMMA_GAMMA_POOL_H
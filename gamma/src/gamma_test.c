@@ -11,7 +11,9 @@
 #undef NDEBUG
 #endif
 
+#include "arena.h"
 #include "gamma.h"
+#include "scheduler.h"
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -32,6 +34,118 @@ static const char board[] =
   "1221......\n"
   "1.........\n";
 
+static int64_t live_blocks = 0; ///< Liczba bloków zaalokowanych przez @ref counting.
+
+/** @brief Alokuje blok i zlicza go.
+ * @param[in] ctx  – nieużywany,
+ * @param[in] size – liczba bajtów.
+ * @return Wskaźnik na blok.
+ */
+static void *count_alloc(void *ctx, size_t size) {
+  (void) ctx;
+  live_blocks++;
+  return malloc(size);
+}
+
+/** @brief Zmienia rozmiar bloku.
+ * @param[in] ctx      – nieużywany,
+ * @param[in] ptr      – wskaźnik na blok,
+ * @param[in] old_size – nieużywany,
+ * @param[in] new_size – nowy rozmiar w bajtach.
+ * @return Wskaźnik na blok.
+ */
+static void *count_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+  (void) ctx;
+  (void) old_size;
+  return realloc(ptr, new_size);
+}
+
+/** @brief Zwalnia blok i zlicza zwolnienie.
+ * @param[in] ctx  – nieużywany,
+ * @param[in] ptr  – wskaźnik na blok,
+ * @param[in] size – nieużywany.
+ */
+static void count_free(void *ctx, void *ptr, size_t size) {
+  (void) ctx;
+  (void) size;
+  live_blocks--;
+  free(ptr);
+}
+
+/** @brief Alokator zliczający zaalokowane bloki. */
+static const gamma_allocator_t counting = {count_alloc, count_realloc, count_free, NULL};
+
+/** @brief Wykonuje te same losowe ruchy i złote ruchy w dwóch grach
+ * o jednakowych wymiarach i sprawdza, że dają te same wyniki i plansze.
+ * @param[in,out] a   – wskaźnik na pierwszą grę,
+ * @param[in,out] b   – wskaźnik na drugą grę,
+ * @param[in] seed    – ziarno generatora,
+ * @param[in] players – liczba graczy,
+ * @param[in] moves   – liczba prób ruchu.
+ */
+static void play_same(gamma_t *a, gamma_t *b, uint64_t seed, uint32_t players,
+                      uint32_t moves) {
+  gamma_cells_t cells;
+  assert(gamma_cells(a, &cells));
+  for (uint32_t i = 0; i < moves; i++) {
+    seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+    uint32_t player = (seed >> 20) % players + 1;
+    uint32_t x = (seed >> 33) % cells.width, y = (seed >> 45) % cells.height;
+    if ((seed >> 61) == 0)
+      assert(gamma_golden_move(a, player, x, y) == gamma_golden_move(b, player, x, y));
+    else
+      assert(gamma_move(a, player, x, y) == gamma_move(b, player, x, y));
+  }
+  char *pa = gamma_board(a), *pb = gamma_board(b);
+  assert(pa != NULL && pb != NULL && strcmp(pa, pb) == 0);
+  free(pa);
+  free(pb);
+}
+
+/** @brief Znajduje następnego gracza, który może wykonać ruch, sprawdzając
+ * po kolei wszystkich graczy.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] players – liczba graczy,
+ * @param[in] curr    – numer gracza, po którym zaczyna się szukanie.
+ * @return Numer gracza lub @p 0, jeśli żaden gracz nie może wykonać ruchu.
+ */
+static uint32_t next_player(gamma_t *g, uint32_t players, uint32_t curr) {
+  for (uint32_t i = 1; i <= players; i++) {
+    uint32_t p = (curr + i - 1) % players + 1;
+    if (gamma_free_fields(g, p) > 0 || gamma_golden_possible(g, p))
+      return p;
+  }
+  return 0;
+}
+
+/** @brief Porównuje harmonogram tur z @ref next_player w losowej grze.
+ * @param[in] seed    – ziarno generatora, liczba różna od @p 0,
+ * @param[in] size    – szerokość i wysokość planszy,
+ * @param[in] players – liczba graczy,
+ * @param[in] areas   – maksymalna liczba obszarów gracza.
+ */
+static void check_scheduler(uint64_t seed, uint32_t size, uint32_t players,
+                            uint32_t areas) {
+  gamma_t *g = gamma_new(size, size, players, areas);
+  scheduler_t *s = scheduler_new(g, players);
+  assert(g != NULL && s != NULL);
+  uint32_t player = 1;
+  while (player != 0) {
+    seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+    uint32_t x = (seed >> 33) % size, y = (seed >> 45) % size;
+    uint32_t previous = gamma_field_owner(g, x, y);
+    if ((seed >> 60) == 0 && gamma_golden_move(g, player, x, y))
+      scheduler_moved(s, player, previous);
+    else if (gamma_move(g, player, x, y))
+      scheduler_moved(s, player, 0);
+    uint32_t expected = next_player(g, players, player);
+    player = scheduler_next(s, player);
+    assert(player == expected);
+  }
+  scheduler_delete(s);
+  gamma_delete(g);
+}
+
 /** @brief Testuje silnik gry gamma.
  * Przeprowadza przykładowe testy silnika gry gamma.
  * @return Zero, gdy wszystkie testy przebiegły poprawnie,
@@ -93,6 +207,190 @@ int main() {
   printf("%s", p);
   free(p);
 
+  gamma_t *c = gamma_copy(g);
+  assert(c != NULL);
+  assert(gamma_move(c, 1, 1, 0));
+  assert(gamma_busy_fields(c, 1) == 6);
+  assert(gamma_busy_fields(g, 1) == 5);
+  p = gamma_board(g);
+  assert(strcmp(p, board) == 0);
+  free(p);
+  gamma_delete(c);
+
+  assert(gamma_field_owner(g, 5, 5) == 2);
+  assert(gamma_field_owner(g, 7, 5) == 0);
+  assert(gamma_field_owner(g, 10, 0) == 0);
+  assert(gamma_field_owner(NULL, 0, 0) == 0);
+
+  gamma_t *row = gamma_new(5, 1, 2, 1);
+  uint8_t legal[5];
+  assert(gamma_move(row, 1, 0, 0));
+  assert(gamma_move(row, 1, 1, 0));
+  assert(gamma_move(row, 1, 2, 0));
+  assert(gamma_legal_map(row, 2, legal));
+  assert(memcmp(legal, (uint8_t[]) {GAMMA_LEGAL_GOLDEN, 0, GAMMA_LEGAL_GOLDEN,
+                                    GAMMA_LEGAL_MOVE, GAMMA_LEGAL_MOVE}, 5) == 0);
+  assert(gamma_legal_map(row, 1, legal));
+  assert(memcmp(legal, (uint8_t[]) {0, 0, 0, GAMMA_LEGAL_MOVE, 0}, 5) == 0);
+  assert(!gamma_legal_map(row, 3, legal));
+  gamma_delete(row);
+
+  char window[16];
+  assert(gamma_board_rows(g, 0, 3, 0, 11, window, sizeof(window)) == 0);
+  assert(gamma_board_rows(g, 5, 7, 5, 8, NULL, 0) == 8);
+  assert(gamma_board_rows(g, 5, 7, 5, 8, window, 8) == 8);
+  assert(gamma_board_rows(g, 5, 7, 5, 8, window, sizeof(window)) == 8);
+  assert(strcmp(window, ".2.\n2..\n") == 0);
+  char full[sizeof(board)];
+  assert(gamma_board_rows(g, 0, 10, 0, 10, full, sizeof(full)) == strlen(board));
+  assert(strcmp(full, board) == 0);
+
+  assert(gamma_board_buffer(g, NULL, 0) == strlen(board));
+  assert(gamma_board_buffer(g, full, strlen(board)) == strlen(board));
+  assert(gamma_board_buffer(g, full, sizeof(full)) == strlen(board));
+  assert(strcmp(full, board) == 0);
+  p = gamma_board_interactive(g);
+  assert(gamma_board_interactive_buffer(g, NULL, 0) == strlen(p));
+  free(p);
+
+  gamma_cells_t cells;
+  assert(!gamma_cells(NULL, &cells));
+  assert(gamma_cells(g, &cells));
+  assert(cells.width == 10 && cells.height == 10);
+  assert(cells.owner_size == 1);
+  assert(gamma_cells_owner(&cells, 5, 5) == 2);
+  assert(gamma_cells_owner(&cells, 0, 9) == 1);
+  assert(gamma_cells_owner(&cells, 7, 5) == 0);
+
+  gamma_memory_t m;
+  assert(!gamma_memory_usage(NULL, &m));
+  assert(!gamma_memory_usage(g, NULL));
+  assert(gamma_memory_usage(g, &m));
+  assert(m.total == m.game + m.board + m.parents + m.areas_size
+                    + m.visited + m.stack);
+  assert(m.board > 0 && m.stack > 0);
+  assert(m.stack < m.visited);
+
+  gamma_t *wide = gamma_new(100, 100, 2, 1);
+  assert(wide != NULL);
+  assert(gamma_move(wide, 2, 99, 99));
+  for (uint32_t y = 0; y < 100; y++)
+    for (uint32_t x = 0; x < 100 - 2 * (y == 99); x++)
+      assert(gamma_move(wide, 1, x, y));
+  gamma_memory_t wide_m;
+  assert(gamma_memory_usage(wide, &wide_m));
+  uint64_t small_stack = wide_m.stack;
+  assert(gamma_golden_possible(wide, 2));
+  assert(gamma_memory_usage(wide, &wide_m));
+  assert(wide_m.stack > small_stack);
+  assert(gamma_golden_possible(wide, 1));
+  assert(gamma_memory_usage(wide, &wide_m));
+  assert(wide_m.stack == small_stack);
+  gamma_delete(wide);
+
+  gamma_t *h = gamma_new_with_allocator(4, 4, 2, 2, &counting);
+  assert(h != NULL && live_blocks > 0);
+  assert(gamma_move(h, 1, 0, 0));
+  assert(gamma_move(h, 1, 1, 0));
+  assert(gamma_move(h, 2, 3, 3));
+  assert(gamma_golden_move(h, 2, 0, 0));
+  gamma_t *hc = gamma_copy(h);
+  assert(gamma_legal_map(hc, 1, (uint8_t[16]) {0}));
+  assert(gamma_reset(hc, 5, 1));
+  gamma_delete(h);
+  gamma_delete(hc);
+  assert(live_blocks == 0);
+
+  gamma_t *r = gamma_copy(g);
+  assert(!gamma_reset(r, 0, 1));
+  assert(gamma_busy_fields(r, 1) == 5);
+  assert(gamma_reset(r, 3, 1));
+  gamma_t *fresh = gamma_new(10, 10, 3, 1);
+  char *expected = gamma_board(fresh);
+  p = gamma_board(r);
+  assert(strcmp(p, expected) == 0);
+  free(p);
+  assert(gamma_busy_fields(r, 1) == 0);
+  assert(gamma_free_fields(r, 3) == 100);
+  assert(gamma_move(r, 3, 5, 5));
+  assert(gamma_move(r, 1, 0, 0));
+  assert(!gamma_move(r, 1, 2, 0));
+  assert(gamma_move(r, 1, 1, 0));
+  assert(gamma_reset(r, 300, 1));
+  assert(gamma_move(r, 300, 9, 9));
+  assert(gamma_field_owner(r, 9, 9) == 300);
+  assert(gamma_cells(r, &cells) && cells.owner_size == 2);
+  assert(gamma_cells_owner(&cells, 9, 9) == 300);
+  assert(gamma_cells_owner(&cells, 0, 0) == 0);
+  free(expected);
+  gamma_delete(fresh);
+  gamma_delete(r);
+
+  gamma_t *line = gamma_new(7, 1, 2, 2);
+  scheduler_t *s = scheduler_new(line, 2);
+  assert(gamma_move(line, 1, 0, 0));
+  assert(gamma_move(line, 2, 1, 0));
+  assert(gamma_move(line, 1, 2, 0));
+  assert(gamma_move(line, 2, 3, 0));
+  assert(gamma_golden_move(line, 1, 3, 0));
+  assert(gamma_move(line, 2, 4, 0));
+  for (int i = 0; i < 6; i++)
+    scheduler_moved(s, i % 2 + 1, i == 4 ? 2 : 0);
+  assert(scheduler_next(s, 2) == 2);
+  assert(scheduler_next(s, 2) == 2);
+  assert(gamma_golden_move(line, 2, 0, 0));
+  scheduler_moved(s, 2, 1);
+  assert(scheduler_next(s, 2) == 1);
+  scheduler_delete(s);
+  gamma_delete(line);
+  for (uint64_t seed = 1; seed <= 300; seed++)
+    check_scheduler(seed, 2 + seed % 5, 1 + seed % 7, 1 + seed % 3);
+
+  arena_t *arena = arena_new(256);
+  assert(arena != NULL);
+  const gamma_allocator_t *al = arena_allocator(arena);
+  char *first = al->alloc(al->ctx, 100);
+  char *second = al->alloc(al->ctx, 100);
+  assert(first != NULL && second != NULL && first != second);
+  memset(second, 'b', 100);
+  al->free(al->ctx, first, 100);
+  char *third = al->alloc(al->ctx, 40);
+  memset(third, 'c', 40);
+  assert(second[0] == 'b' && second[99] == 'b');
+  al->free(al->ctx, third, 40);
+  assert(al->alloc(al->ctx, 40) == third);
+  char *grown = al->realloc(al->ctx, third, 40, 48);
+  assert(grown == third && grown[0] == 'c' && grown[39] == 'c');
+  char *moved = al->realloc(al->ctx, second, 100, 200);
+  assert(moved != NULL && moved != second && moved[0] == 'b' && moved[99] == 'b');
+  char *big = al->alloc(al->ctx, 1000);
+  assert(big != NULL);
+  memset(big, 'd', 1000);
+  assert(moved[99] == 'b' && grown[0] == 'c');
+  arena_clear(arena);
+  char *reused = al->alloc(al->ctx, 1200);
+  assert(reused != NULL);
+  memset(reused, 'e', 1200);
+  arena_clear(arena);
+  for (int round = 0; round < 2; round++) {
+    gamma_t *plain = gamma_new(12, 9, 4, 3);
+    gamma_t *in_arena = gamma_new_with_allocator(12, 9, 4, 3, arena_allocator(arena));
+    assert(plain != NULL && in_arena != NULL);
+    play_same(plain, in_arena, 7, 4, 400);
+    gamma_t *plain_copy = gamma_copy(plain);
+    gamma_t *arena_copy = gamma_copy(in_arena);
+    assert(plain_copy != NULL && arena_copy != NULL);
+    play_same(plain_copy, arena_copy, 8, 4, 100);
+    assert(gamma_reset(plain, 300, 2) && gamma_reset(in_arena, 300, 2));
+    play_same(plain, in_arena, 9, 300, 400);
+    gamma_delete(plain_copy);
+    gamma_delete(arena_copy);
+    gamma_delete(plain);
+    gamma_delete(in_arena);
+    arena_clear(arena);
+  }
+  arena_delete(arena);
+
   gamma_delete(g);
   return 0;
 }
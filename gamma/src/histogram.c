@@ -0,0 +1,69 @@
+/** @file
+ * Zawiera implementację interfejsu histogram.h
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#include "histogram.h"
+#include <string.h>
+
+void histogram_init(histogram_t *h) {
+    memset(h, 0, sizeof(histogram_t));
+}
+
+void histogram_merge(histogram_t *dst, const histogram_t *src) {
+    if (src->total == 0)
+        return;
+    for (uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+        dst->counts[i] += src->counts[i];
+    if (dst->total == 0 || src->min < dst->min)
+        dst->min = src->min;
+    if (src->max > dst->max)
+        dst->max = src->max;
+    dst->total += src->total;
+    dst->sum += src->sum;
+}
+
+/**
+ * @brief Zwraca największą wartość należącą do przedziału.
+ * @param[in] i – numer przedziału.
+ * @return Największa wartość, dla której @ref histogram_bucket zwraca @p i.
+ */
+static uint64_t bucket_upper_bound(uint32_t i) {
+    if (i < HISTOGRAM_SUB_BUCKETS)
+        return i;
+    uint32_t shift = (i >> HISTOGRAM_SUB_BITS) - 1;
+    uint64_t mantissa = i - (shift << HISTOGRAM_SUB_BITS);
+    return ((mantissa + 1) << shift) - 1;
+}
+
+uint64_t histogram_percentile(const histogram_t *h, double p) {
+    if (h->total == 0)
+        return 0;
+    uint64_t rank = (uint64_t) (p / 100.0 * h->total + 0.5);
+    if (rank < 1)
+        rank = 1;
+    if (rank > h->total)
+        rank = h->total;
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        seen += h->counts[i];
+        if (seen >= rank) {
+            uint64_t bound = bucket_upper_bound(i);
+            return bound < h->max ? bound : h->max;
+        }
+    }
+    return h->max;
+}
+
+void histogram_print(const histogram_t *h, const char *name, FILE *out) {
+    fprintf(out, "%-8s count %10lu mean %10.0f min %10lu p50 %10lu p90 %10lu "
+                 "p99 %10lu p99.9 %10lu max %10lu\n",
+            name, h->total, h->total ? (double) h->sum / h->total : 0.0,
+            h->min,
+            histogram_percentile(h, 50), histogram_percentile(h, 90),
+            histogram_percentile(h, 99), histogram_percentile(h, 99.9),
+            h->max);
+}
@@ -0,0 +1,95 @@
+/** @file
+ * Interfejs klasy implementującej histogram o logarytmicznych przedziałach
+ * (w stylu HDR Histogram), służący do zbierania czasów wykonania.
+ * Każda potęga dwójki podzielona jest na @ref HISTOGRAM_SUB_BUCKETS
+ * równych przedziałów, więc błąd względny odczytanych percentyli nie
+ * przekracza około 3%, a zapis wartości to kilka operacji arytmetycznych.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#ifndef GAMMA_HISTOGRAM_H
+#define GAMMA_HISTOGRAM_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define HISTOGRAM_SUB_BITS 5 ///< Logarytm o podstawie 2 z liczby przedziałów na potęgę dwójki.
+#define HISTOGRAM_SUB_BUCKETS (1 << HISTOGRAM_SUB_BITS) ///< Liczba przedziałów na potęgę dwójki.
+#define HISTOGRAM_BUCKETS ((64 - HISTOGRAM_SUB_BITS + 1) * HISTOGRAM_SUB_BUCKETS) ///< Liczba wszystkich przedziałów.
+
+/**
+ * @brief Struktura reprezentująca histogram.
+ * Struktura nie wymaga alokacji pamięci, wyzerowana reprezentuje pusty
+ * histogram.
+ */
+typedef struct histogram {
+    uint64_t counts[HISTOGRAM_BUCKETS]; ///< Liczności przedziałów.
+    uint64_t total;                     ///< Liczba zapisanych wartości.
+    uint64_t sum;                       ///< Suma zapisanych wartości.
+    uint64_t min;                       ///< Najmniejsza zapisana wartość.
+    uint64_t max;                       ///< Największa zapisana wartość.
+} histogram_t;
+
+/**
+ * @brief Zeruje histogram.
+ * @param[out] h – wskaźnik na histogram, różny od @p NULL.
+ */
+void histogram_init(histogram_t *h);
+
+/**
+ * @brief Zwraca numer przedziału, do którego należy wartość.
+ * @param[in] v – wartość.
+ * @return Numer przedziału, liczba mniejsza od @ref HISTOGRAM_BUCKETS.
+ */
+static inline uint32_t histogram_bucket(uint64_t v) {
+    if (v < HISTOGRAM_SUB_BUCKETS)
+        return v;
+    uint32_t shift = 63 - __builtin_clzll(v) - HISTOGRAM_SUB_BITS;
+    return (shift << HISTOGRAM_SUB_BITS) + (v >> shift);
+}
+
+/**
+ * @brief Zapisuje wartość w histogramie.
+ * @param[in,out] h – wskaźnik na histogram, różny od @p NULL,
+ * @param[in] v     – wartość.
+ */
+static inline void histogram_record(histogram_t *h, uint64_t v) {
+    h->counts[histogram_bucket(v)]++;
+    if (h->total == 0 || v < h->min)
+        h->min = v;
+    if (v > h->max)
+        h->max = v;
+    h->total++;
+    h->sum += v;
+}
+
+/**
+ * @brief Dodaje do histogramu @p dst wartości zapisane w histogramie @p src.
+ * @param[in,out] dst – wskaźnik na histogram, różny od @p NULL,
+ * @param[in] src     – wskaźnik na histogram, różny od @p NULL.
+ */
+void histogram_merge(histogram_t *dst, const histogram_t *src);
+
+/**
+ * @brief Zwraca przybliżenie percentyla.
+ * @param[in] h – wskaźnik na histogram, różny od @p NULL,
+ * @param[in] p – percentyl, liczba z przedziału [@p 0, @p 100].
+ * @return Górna granica przedziału, w którym leży percentyl @p p, nie większa
+ * niż największa zapisana wartość, lub @p 0 dla pustego histogramu.
+ */
+uint64_t histogram_percentile(const histogram_t *h, double p);
+
+/**
+ * @brief Wypisuje podsumowanie histogramu w jednym wierszu.
+ * Wypisuje nazwę, liczbę wartości, średnią, minimum, percentyle
+ * 50, 90, 99, 99.9 i maksimum.
+ * @param[in] h    – wskaźnik na histogram, różny od @p NULL,
+ * @param[in] name – nazwa histogramu,
+ * @param[in] out  – strumień, do którego wypisywane jest podsumowanie.
+ */
+void histogram_print(const histogram_t *h, const char *name, FILE *out);
+
+#endif //GAMMA_HISTOGRAM_H
@@ -6,7 +6,9 @@
  * @date 12.05.2020
  */
 #include "int_to_string_util.h"
+#include <errno.h>
 #include <stdint.h>
+#include <stdlib.h>
 
 uint64_t write_int(char *s, uint64_t l, uint32_t n) {
     uint32_t count = digit_count(n);
@@ -29,4 +31,16 @@ uint32_t digit_count(uint64_t n) {
         count++;
     }
     return count;
-}
\ No newline at end of file
+}
+
+bool parse_number(const char *arg, uint64_t max, uint64_t *value) {
+    if (*arg < '0' || *arg > '9')
+        return false;
+    char *end;
+    errno = 0;
+    unsigned long long n = strtoull(arg, &end, 10);
+    if (errno != 0 || *end != '\0' || n > max)
+        return false;
+    *value = n;
+    return true;
+}
@@ -1,7 +1,7 @@
 /** @file
  * Interfejs udostępniający funkcje
  * pomagające wpisywać reprezentacje napisowe
- * liczb do buforów
+ * liczb do buforów i odczytywać liczby z argumentów programów
  *
  * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
  * @copyright Uniwersytet Warszawski
@@ -11,6 +11,7 @@
 #ifndef GAMMA_INT_TO_STRING_UTIL_H
 #define GAMMA_INT_TO_STRING_UTIL_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 /** @brief Wpisuje liczbę do napisu.
@@ -35,4 +36,13 @@ uint64_t write_int(char *s, uint64_t l, uint32_t n);
  */
 uint32_t digit_count(uint64_t n);
 
+/** @brief Zamienia argument programu na liczbę.
+ * @param[in] arg    – argument,
+ * @param[in] max    – największa dopuszczalna wartość,
+ * @param[out] value – wskaźnik na zmienną, w której zostanie zapisana liczba.
+ * @return Wartość @p true, jeśli @p arg jest zapisem dziesiętnym liczby
+ * nieujemnej nie większej od @p max, wartość @p false w przeciwnym przypadku.
+ */
+bool parse_number(const char *arg, uint64_t max, uint64_t *value);
+
 #endif //GAMMA_INT_TO_STRING_UTIL_H
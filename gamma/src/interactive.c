@@ -9,6 +9,8 @@
 #include "interactive.h"
 #include "int_to_string_util.h"
 #include "interactive_input_util.h"
+#include "screen.h"
+#include "scheduler.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -27,6 +29,8 @@
 #define SMALL_G 'g' ///< Reprezentuje znak @p 'g'.
 #define BIG_C 'C' ///< Reprezentuje znak @p 'C'.
 #define SMALL_C 'c' ///< Reprezentuje znak @p 'c'.
+#define BIG_H 'H' ///< Reprezentuje znak @p 'H'.
+#define SMALL_H 'h' ///< Reprezentuje znak @p 'h'.
 #define CTRL_D 4 ///< Kod znaku wczytanego jako wciśnięcie @p CTRL-D.
 #define IOCTL_ERROR -1 /**< Kod zwracany przez funkcję @p
                         * ioctl w razie niepowodzenia.
@@ -53,113 +57,141 @@
 
 #define RED "\033[31m" ///< Kod aktywujący wypisywanie w kolorze czerwonym.
 #define GREEN "\033[32m" ///< Kod aktywujący wypisywanie w kolorze zielonym.
-#define YELLOW "\033[33m" ///< Kod aktywujący wypisywanie w kolorze żółtym.
-#define RED_BACKGROUND "\033[41m" ///< Kod aktywujący wypisywanie na czerwonym tle.
-#define GREEN_BACKGROUND "\033[42m" ///< Kod aktywujący wupisywanie na zielonym tle.
+#define STATUS_LENGTH 128 ///< Rozmiar bufora na napis reprezentujący gracza.
+#define EXTRA_LINES 3 /**< Liczba wierszy terminala poza planszą: napis
+                       * reprezentujący gracza, komunikat i wiersz, w którym
+                       * zostaje kursor terminala.
+                       */
 
 /**
- * @brief Przywraca domyślne ustawienia wyświetlanych napisów.
- */
-static void reset_font() {
-    printf("\033[0m");
-}
-
-/**
- * @brief Przesuwa kursor.
- * Przesuwa kursor na pole w kolumnie @p col i wierszu @p row.
- * @param[in] row – numer wiersza,
- * @param[in] col – numer kolumny.
- */
-static void move_to(int row, int col) {
-    printf("\033[%d;%df", row, col);
-}
-
-/**
- * @brief Chowa kursor.
+ * @brief Struktura przechowująca dane wyświetlane w napisie reprezentującym
+ * gracza, którego jest tura.
+ * Obliczenie liczby wolnych pól i możliwości złotego ruchu może wymagać
+ * przejrzenia całej planszy, więc dane liczone są tylko wtedy, gdy zmieni
+ * się gracz lub stan planszy, a nie przy każdym wciśnięciu klawisza.
  */
-static void hide_cursor() {
-    printf("\e[?25l"); /* hide the cursor */
-}
+typedef struct player_status {
+    uint32_t player;      /**< Numer gracza, którego dotyczą dane, lub
+                           * @ref NO_PLAYER, jeśli dane są nieaktualne.
+                           */
+    uint64_t busy_fields; ///< Liczba pól zajętych przez gracza.
+    uint64_t free_fields; ///< Liczba pól, na które gracz może zrobić ruch.
+    uint32_t areas;       ///< Liczba obszarów gracza.
+    bool golden_possible; ///< Równe @p true, jeśli gracz może zrobić złoty ruch.
+} player_status_t;
 
 /**
- * @brief Pokazuje kursor w terminalu
+ * @brief Struktura opisująca widoczny na ekranie fragment planszy.
+ * Ekran trybu interaktywnego zawiera tylko ten fragment, więc pamięć
+ * i koszt rysowania zależą od rozmiaru terminala, a nie planszy.
  */
-static void show_cursor() {
-    printf("\e[?25h");
-}
+typedef struct viewport {
+    uint32_t board_height; ///< Liczba wierszy planszy.
+    uint32_t board_width;  ///< Liczba kolumn planszy.
+    uint32_t field_width;  ///< Szerokość napisu reprezentującego pole.
+    uint32_t top;          /**< Numer pierwszego widocznego wiersza planszy,
+                            * licząc od górnego wiersza ekranu.
+                            */
+    uint32_t left;         ///< Numer pierwszej widocznej kolumny planszy.
+    uint32_t height;       ///< Liczba widocznych wierszy planszy.
+    uint32_t width;        ///< Liczba widocznych kolumn planszy.
+    uint32_t term_cols;    ///< Liczba kolumn terminala.
+    const uint8_t *legal;  /**< Mapa legalnych ruchów (patrz
+                            * @ref gamma_legal_map), według której
+                            * podświetlane są pola, lub @p NULL, jeśli
+                            * nakładka jest wyłączona.
+                            */
+} viewport_t;
 
 /**
- * @brief Zapisuje pozycję kursora.
+ * @brief Struktura przechowująca nakładkę pokazującą pola, na które gracz,
+ * którego jest tura, może wykonać ruch lub złoty ruch.
+ * Mapa wyznaczana jest ponownie tylko po zmianie stanu gry lub gracza,
+ * a przerysowywane są tylko widoczne pola, których podświetlenie się
+ * zmieniło.
  */
-static void save_cursor_position() {
-    printf("\033[s");
-}
+typedef struct overlay {
+    bool enabled;   ///< Równe @p true, jeśli nakładka jest wyświetlana.
+    bool stale;     /**< Równe @p true, jeśli od wyznaczenia mapy zmienił
+                     * się stan gry lub gracz.
+                     */
+    uint8_t *shown; ///< Mapa, według której narysowano pola.
+    uint8_t *fresh; ///< Bufor na nowo wyznaczaną mapę.
+} overlay_t;
 
 /**
- * @brief Przywraca kursorowi pozycję zapisaną w ostatnim wywołaniu funkcji
- * @ref save_cursor_position.
- * Zakłada, że takie istnieje.
+ * @brief Przywraca domyślne ustawienia wyświetlanych napisów.
  */
-static void restore_cursor_position() {
-    printf("\033[u");
+static void reset_font() {
+    printf("\033[0m");
 }
 
 /**
- * Czyści ekran terminala i przesuwa kursor do punktu (@p 1, @p 1).
+ * @brief Aktualizuje dane gracza, którego jest tura.
+ * Jeśli dane w @p st dotyczą innego gracza niż @p player lub są
+ * nieaktualne, liczy je na nowo.
+ * @param[in] g      – wskaźnik na strukturę reprezentującą stan gry,
+ *                     różny od @p NULL,
+ * @param[in,out] st – wskaźnik na dane gracza,
+ * @param[in] player – numer gracza.
+ * @return Wartość @p true, jeśli dane zostały policzone na nowo i napis
+ * reprezentujący gracza trzeba wyświetlić ponownie, @p false w przeciwnym
+ * przypadku.
  */
-static inline void clear_screen_move_to_1_1() {
-    printf("\033[2J");
-    move_to(1, 1);
+static bool update_player_status(gamma_t *g, player_status_t *st, uint32_t player) {
+    if (st->player == player)
+        return false;
+    st->player = player;
+    st->busy_fields = gamma_busy_fields(g, player);
+    st->free_fields = gamma_free_fields(g, player);
+    st->areas = gamma_player_areas(g, player);
+    st->golden_possible = gamma_golden_possible(g, player);
+    return true;
 }
 
 /**
- * @brief Wypisuje napis reprezentujący gracza.
- * Wypisuje na aktualnej pozycji kursora napis reprezentujący
- * gracza o numerze @p player w grze reprezentowanej przez strukturę
- * wskazywaną przez @p g. Napis zawiera informację o numerze gracza,
+ * @brief Rysuje napis reprezentujący gracza.
+ * Rysuje w wierszu @p row bufora ekranu napis reprezentujący
+ * gracza, którego dane przechowuje struktura wskazywana przez @p st.
+ * Napis zawiera informację o numerze gracza,
  * liczbie pól zajętych przez gracza, liczbie pól, na które gracz może
  * aktualnie zrobić ruch i o tym, czy gracz może w zrobić w obecnej turze
- * zrobić złoty ruch. Napis jest zakończony znakiem nowej linii.
+ * zrobić złoty ruch. Poprzednia zawartość wiersza jest czyszczona.
  * Napis jest koloru zielonego.
- * @param[in] g      – wskaźnik na strukturę reprezentującą stan gry,
- *                     różny od @p NULL.
- * @param[in] player – numer gracza.
+ * @param[in,out] screen – wskaźnik na bufor ekranu,
+ * @param[in] st         – wskaźnik na aktualne dane gracza,
+ * @param[in] max_areas  – maksymalna liczba obszarów gracza,
+ * @param[in] row        – numer wiersza ekranu.
  */
-static void print_player(gamma_t *g, uint32_t player) {
-    printf("%s", GREEN);
-    uint64_t busy_fields = gamma_busy_fields(g, player);
-    uint64_t free_fields = gamma_free_fields(g, player);
-    uint32_t areas = gamma_player_areas(g, player);
-    uint32_t max_areas = gamma_max_areas(g);
-    bool golden_possible = gamma_golden_possible(g, player);
-    printf("PLAYER %d, B: %lu, F: %lu, areas: %d\\%d",
-           player,
-           busy_fields,
-           free_fields,
-           areas, max_areas);
-    if (golden_possible) {
-        printf(" ");
-        printf(YELLOW);
-        printf(GOLDEN_POSSIBLE);
+static void put_player(screen_t *screen, const player_status_t *st,
+                       uint32_t max_areas, uint32_t row) {
+    char line[STATUS_LENGTH];
+    int len = snprintf(line, sizeof(line), "PLAYER %d, B: %lu, F: %lu, areas: %d\\%d",
+                       st->player,
+                       st->busy_fields,
+                       st->free_fields,
+                       st->areas, max_areas);
+    screen_clear_line(screen, row, 0);
+    uint32_t col = screen_put(screen, row, 0, line, len, SCREEN_GREEN);
+    if (st->golden_possible) {
+        col = screen_put(screen, row, col, " ", 1, SCREEN_GREEN);
+        screen_put(screen, row, col, GOLDEN_POSSIBLE, strlen(GOLDEN_POSSIBLE),
+                   SCREEN_YELLOW);
     }
-    reset_font();
 }
 
 /**
- * @brief Wyświetla komunikat na dole ekranu.
- * Przenosi kursor na pozycję w pierwszej kolumnie i
- * @p rows @p + @p 2 wierszu. Wyświetla tam komunikat
- * @p s. Na końcu przywraca kursor do początkowej pozycji.
- * @param[in] s    – łańcuch znaków będący komunikatem do wyświetlenia,
- *                   powinien być zakończony znakiem końca łańcucha,
- * @param[in] rows – liczba wierszy w napisie reprezentującym
- *                   planszę w trybie interaktywnym.
+ * @brief Rysuje komunikat na dole ekranu.
+ * Rysuje komunikat @p s w kolorze czerwonym w pierwszej kolumnie
+ * wiersza @p rows @p + @p 1 bufora ekranu.
+ * @param[in,out] screen – wskaźnik na bufor ekranu,
+ * @param[in] s          – łańcuch znaków będący komunikatem do wyświetlenia,
+ *                         powinien być zakończony znakiem końca łańcucha,
+ * @param[in] rows       – liczba wierszy w napisie reprezentującym
+ *                         planszę w trybie interaktywnym.
  */
-static void print_komunikat(char *s, uint32_t rows) {
-    save_cursor_position();
-    move_to(rows + 2, 1);
-    printf("%s", s);
-    restore_cursor_position();
+static void put_komunikat(screen_t *screen, const char *s, uint32_t rows) {
+    screen_put(screen, rows + 1, 0, s, strlen(s), SCREEN_RED);
 }
 
 /**
@@ -177,46 +209,6 @@ static void print_player_game_end(gamma_t *g, uint32_t player) {
     printf("PLAYER %d, Busy fields: %lu\n", player, busy_fields);
 }
 
-/**
- * @brief Inkrementuje numer gracza.
- * @param[in] player         – numer gracza, liczba dodatnia niewiększa od
- *                             @p num_of_players,
- * @param[in] num_of_players – liczba graczy.
- * @return Wartość @p 1, gdy liczba @p player jest rówma @p num_of_players,
- * Wartość @p player + 1 w przeciwnym przypadku.
- */
-static uint32_t increment_player(uint32_t player, uint32_t num_of_players) {
-    return player % num_of_players + 1;
-}
-
-/**
- * @brief Znajduje i zwraca numer następnego grającego gracza.
- * Sprawdza, który gracz powinien grać po graczu o numerze @p curr.
- * Przechodzi po kolei graczy zaczynając od tego, który powinien grać po
- * graczu o numerze @p curr i dla każdego sprawdza, czy w może wykonać ruch
- * (zwykły lub złoty) na planszy w grze, której stan reprezentuje
- * struktura wskazywana przez @p g.
- * @param[in] g        – wskaźnik na strukture reprezentującą stan gry,
- *                       różny od @p NULL,
- * @param[in] curr     – numer gracza, którego "następnika" szukamy,
- * @param[in] players  – liczba wszystkich graczy w grze (licząc tych, co
- *                       nie mogą wykonać ruchu).
- * @return Numer pierwszego gracza, który może wykonać ruch, lub
- * wartość @ref NO_PLAYER, jeśli żaden gracz nie może wykonać ruchu.
- */
-static uint32_t next_playing_player(gamma_t *g, uint32_t curr, uint32_t players) {
-    uint32_t next = increment_player(curr, players);
-    if (gamma_free_fields(g, next) > 0 || gamma_golden_possible(g, next))
-        return next;
-    uint32_t it = increment_player(next, players);
-    while (it != next) {
-        if (gamma_free_fields(g, it) > 0 || gamma_golden_possible(g, it))
-            return it;
-        it = increment_player(it, players);
-    }
-    return NO_PLAYER;
-}
-
 /**
  * @brief Sprawdza, czy znak reprezentuję strzałkę.
  * @param[in] c – kod znaku.
@@ -264,20 +256,17 @@ static void erase_to_the_end_of_line() {
 
 /**
  * @brief Wyświetla napisy reprezentujące graczy w podsumowaniu gry.
- * Przemieszcza kursor do wiersza pod wierszem numer @p row
- * i wyświetla napisy podsumowujące grę dla kolejnych graczy
+ * Zaczynając od wiersza, w którym jest kursor, wyświetla napisy podsumowujące grę dla kolejnych graczy
  * (zawierające informację o numerze gracza i liczbie zajętych pól w
  * grze, której stan reprezentowany jest przez
  * strukturę wskazywaną przez @p g).
  * Napisy reprezentujące graczy wyświetlane są w kolorze zielonym.
  * @param[in] g       – wskaźnik na strukturę reprezentującą stan planszy,
  *                      różny @p NULL
- * @param[in] players – liczba wszystkich graczy w grze,
- * @param[in] row     – numer wiersza pod, którym mają zostać wyświetleni gracze.
+ * @param[in] players – liczba wszystkich graczy w grze.
  */
-static void print_players_summary(gamma_t *g, uint32_t players, int row) {
+static void print_players_summary(gamma_t *g, uint32_t players) {
     printf(GREEN);
-    move_to(row + 1, 1);
     for (uint32_t i = 0; i < players; i++) {
         erase_to_the_end_of_line();
         print_player_game_end(g, i + 1);
@@ -286,99 +275,279 @@ static void print_players_summary(gamma_t *g, uint32_t players, int row) {
 }
 
 /**
- * @brief Wyświetla napis reprezentujący gracza, którego jest teraz tura.
- * Czyści napis reprezentujący poprzedniego gracza i wyświetla nowy.
- * Napisy reprezentujące graczy wyświetlane są pod
- * napisem reprezentującym planszę, który to napis zajmuje @p row wierszy.
- * Są one zielonego koloru.
- * @param[in] g       – wskaźnik na strkutrę reprezentującą stan gry,
- *                      różny od @p NULL,
- * @param[in] p  – numer gracza, którego wyświetlany
- *                      napis ma reprezentować,
- * @param[in] row     – liczba wierszy.
+ * @brief Podświetla narysowane pole.
+ * Rysuje ponownie napis pola na kolorowym tle. Jeśli pole jest szersze niż
+ * jeden znak, ostatni znak (odstęp między polami) nie jest podświetlany.
+ * @param[in,out] screen – wskaźnik na bufor ekranu,
+ * @param[in] s          – napis reprezentujący pole,
+ * @param[in] v          – wskaźnik na opis widocznego fragmentu planszy,
+ * @param[in] row        – numer wiersza pola, licząc od górnego wiersza,
+ * @param[in] col        – numer kolumny pola,
+ * @param[in] color      – kolor podświetlenia.
+ */
+static void put_highlight(screen_t *screen, const char *s, const viewport_t *v,
+                          uint32_t row, uint32_t col, screen_color_t color) {
+    uint32_t w = v->field_width;
+    int diff = w > 1;
+    screen_put(screen, row - v->top, (col - v->left) * w, s, w - diff, color);
+}
+
+/**
+ * @brief Rysuje napis reprezentujący pole na planszy.
+ * Zapisuje w buforze @p s napis reprezentujący pole w wierszu @p row
+ * (licząc od górnego wiersza) i kolumnie @p col planszy, której stan
+ * reprezentuje struktura wskazywana przez @p g. Używa do tego funkcji
+ * @ref gamma_write_field.
+ * Zakłada, że bufor @p s jest zdolny pomieścić napis niekrótszy niż
+ * wartość zwrócona przez funkcję @ref gamma_field_width_interactive
+ * wywołaną dla paramtru @p g, i że pole jest widoczne.
+ * Napis zapisany w buforze rysuje w buforze ekranu w miejscu pola,
+ * podświetlając je, jeśli nakładka legalnych ruchów jest włączona i gracz
+ * może wykonać na to pole ruch (tło niebieskie) lub złoty ruch (tło
+ * żółte).
+ * @param[in,out] screen – wskaźnik na bufor ekranu,
+ * @param[in] g          – wskaźnik na strukturę reprezentującą stan planszy,
+ * @param[out] s         – bufor, do którego ma być zapisana napisowa
+ *                         reprezentacja pola, z założenia rozmiaru
+ *                         niemniejszego niż wartość zwracana przez funkcję
+ *                         @ref gamma_field_width_interactive wywołaną dla
+ *                         parametru @p g.
+ * @param[in] v          – wskaźnik na opis widocznego fragmentu planszy,
+ * @param[in] row        – numer wiersza pola, licząc od górnego wiersza,
+ * @param[in] col        – numer kolumny pola.
  */
-static void erase_and_print_player(gamma_t *g, uint32_t p, int row) {
-    save_cursor_position();
-    move_to(row + 1, 1);
-    erase_to_the_end_of_line();
-    print_player(g, p);
-    restore_cursor_position();
+static void put_field_no_color(screen_t *screen, gamma_t *g, char *s,
+                               const viewport_t *v, uint32_t row, uint32_t col) {
+    uint32_t y = v->board_height - row - 1;
+    gamma_write_field(g, s, col, y);
+    screen_put(screen, row - v->top, (col - v->left) * v->field_width, s,
+               v->field_width, SCREEN_DEFAULT);
+    if (v->legal == NULL)
+        return;
+    uint8_t bits = v->legal[(uint64_t) y * v->board_width + col];
+    if (bits & GAMMA_LEGAL_MOVE)
+        put_highlight(screen, s, v, row, col, SCREEN_ON_BLUE);
+    else if (bits & GAMMA_LEGAL_GOLDEN)
+        put_highlight(screen, s, v, row, col, SCREEN_ON_YELLOW);
 }
 
 /**
- * @brief Czyści wiersz o numerze @p rows @p + @p 2.
- * @param[in] rows – liczba wierszy w napisie reprezentującym planszę.
+ * @brief Rysuje napis reprezentujący "aktywne" pole na planszy.
+ * Funkcja działa podobnie do funkcji @ref put_field_no_color, ale rysuje
+ * napis pola na kolorowym tle. Kolor zależy od wartości argumentu
+ * @p is_good. Jeżeli jest ona równa @p true, tło jest koloru zielonego.
+ * W przeciwnym przypadku, napis rysowany jest na czerwonym tle.
+ * Jeśli pole jest szersze niż jeden znak, ostatni znak (odstęp między
+ * polami) nie jest podświetlany.
+ * @param[in,out] screen – wskaźnik na bufor ekranu,
+ * @param[in] g          – wskaźnik na strukturę reprezentującą stan planszy,
+ * @param[out] s         – bufor, do którego ma być zapisana napisowa
+ *                         reprezentacja pola, z założenia rozmiaru
+ *                         niemniejszego niż wartość zwracana przez funkcję
+ *                         @ref gamma_field_width_interactive wywołaną dla
+ *                         parametru @p g.
+ * @param[in] v          – wskaźnik na opis widocznego fragmentu planszy,
+ * @param[in] row        – numer wiersza pola, licząc od górnego wiersza,
+ * @param[in] col        – numer kolumny pola,
+ * @param[in] is_good    – zmienna typu @p bool.
  */
-static void erase_komunikat_line(uint32_t rows) {
-    save_cursor_position();
-    move_to(rows + 2, 1);
-    erase_to_the_end_of_line();
-    restore_cursor_position();
+static void put_field_color(screen_t *screen, gamma_t *g, char *s,
+                            const viewport_t *v, uint32_t row, uint32_t col,
+                            bool is_good) {
+    put_field_no_color(screen, g, s, v, row, col);
+    put_highlight(screen, s, v, row, col, is_good ? SCREEN_ON_GREEN : SCREEN_ON_RED);
 }
 
 /**
- * @brief Pobiera napis reprezentujący stan planszy i alokuje pamięć dla napisu
- * reprezentującego pole.
- * Alokuje pamięć dla napisu długości @p field_width i adres
- * zaalokowanej pamięci zapisuje do zmiennej wskazywanej przez @p s.
- * Wywołuje @ref gamma_board i zapisuje wynik w zmiennej
- * wskazywanej przez @p buffer.
- * Jeżeli nie uda się wykonać operacji zwalnia zaalokowaną
- * podczas wykonywania funkcji pamięć.
- * @param[out] s           – wskaźnik na zmienną mającą przechowywać
- *                           napis długosci @p field_width, różny od
- *                           @p NULL,
- * @param[out] buffer      – wskaźnik na zmienną mającą przechowywać napis
- *                           reprezentujący planszę, różny od
- *                           @p NULL,
- * @param[in] field_width  – liczba dodatnia,
- * @param[in] g            – wskaźnik na strukturę reprezentującą stan planszy,
- *                           różny od @p NULL.
- * @return Wartość @p true, jeśli alokacje zakończyły się powodzeniem,
- * Wartość @p false w przeciwnym przypadku.
+ * @brief Rysuje w buforze ekranu wiersze widocznego fragmentu planszy.
+ * Rysuje wiersze ekranu od @p first do @p last @p - @p 1, używając funkcji
+ * @ref put_field_no_color dla każdego widocznego pola.
+ * @param[in,out] screen – wskaźnik na bufor ekranu,
+ * @param[in] g          – wskaźnik na strukturę reprezentującą stan planszy,
+ * @param[out] s         – bufor na napis reprezentujący pole, rozmiaru
+ *                         niemniejszego niż szerokość pola,
+ * @param[in] v          – wskaźnik na opis widocznego fragmentu planszy,
+ * @param[in] first      – numer pierwszego rysowanego wiersza ekranu,
+ * @param[in] last       – numer wiersza ekranu za ostatnim rysowanym.
  */
-static bool alloc_strings(char **s, char **buffer, uint32_t field_width, gamma_t *g) {
-    *s = malloc((field_width + 1) * sizeof(char));
-    (*s)[field_width] = STRING_END;
-    if (*s == NULL)
-        return false;
-    *buffer = gamma_board_interactive(g);
-    if (*buffer == NULL) {
-        free(*s);
-        return false;
+static void put_window(screen_t *screen, gamma_t *g, char *s,
+                       const viewport_t *v, uint32_t first, uint32_t last) {
+    for (uint32_t row = first; row < last; row++) {
+        for (uint32_t col = 0; col < v->width; col++)
+            put_field_no_color(screen, g, s, v, v->top + row, v->left + col);
     }
-    return true;
 }
 
 /**
- * @brief Czyści ekran, wyświetla początkowy stan planszy.
- * Ustawia kursor na pole (@p 1, @p 1) i chowa go.
- * @param[in] buffer – napis reprezentujący początkowy stan planszy
- *                     (pusta plansza).
+ * @brief Wylicza początek widocznego fragmentu wzdłuż jednej osi.
+ * Fragment zostaje na miejscu, dopóki kursor jest od jego brzegów dalej niż
+ * o ćwierć jego rozmiaru. W przeciwnym przypadku fragment przesuwany jest
+ * tak, by kursor znalazł się w jego środku, czyli zwykle o pół rozmiaru,
+ * dzięki czemu przewijanie zdarza się rzadko.
+ * @param[in] pos   – położenie kursora,
+ * @param[in] first – obecny początek fragmentu,
+ * @param[in] size  – rozmiar fragmentu,
+ * @param[in] total – rozmiar planszy, niemniejszy od @p size.
+ * @return Nowy początek fragmentu.
  */
-static void tryb_start(char *buffer) {
-    clear_screen_move_to_1_1();
-    printf("%s", buffer);
-    move_to(1, 1);
-    hide_cursor();
+static uint32_t scroll_position(uint32_t pos, uint32_t first, uint32_t size,
+                                uint32_t total) {
+    uint32_t margin = size / 4;
+    bool near_start = pos < first + margin && first > 0;
+    bool near_end = pos + margin >= first + size && first + size < total;
+    if (pos >= first && pos < first + size && !near_start && !near_end)
+        return first;
+    uint32_t start = pos > size / 2 ? pos - size / 2 : 0;
+    return start + size > total ? total - size : start;
 }
 
 /**
- * @brief Sprawdza, czy na ekranie da się wyświetlic prostokąt o
- * danych wymiarach.
- * Sprawdza, czy na ekranie terminala da się wyświetlić prostokąt
- * o wysokości (liczba wierszy) @p lines i szerokości @p columns.
- * @param[in] lines   – liczba wierszy w napisie reprezentującym prostokąt,
- * @param[in] columns – liczba kolumn w napisie reprezentującym prostokąt.
- * @return Wartość @p true, jeśli się da, tzn (wartość @p lines jest mniejsza
- * od wysokości ekranu i wartość @p columns jest mniejsza od szerokości ekranu),
- * wartość @p false w przeciwnym przypadku.
+ * @brief Przesuwa widoczny fragment planszy tak, by kursor był widoczny.
+ * Przesunięcie w pionie wykonywane jest przewinięciem ekranu terminala,
+ * więc rysowane są tylko odsłonięte wiersze. Po przesunięciu w poziomie
+ * fragment rysowany jest od nowa w buforze ekranu, a do terminala trafiają
+ * tylko zmienione komórki.
+ * @param[in,out] screen – wskaźnik na bufor ekranu,
+ * @param[in] g          – wskaźnik na strukturę reprezentującą stan planszy,
+ * @param[out] s         – bufor na napis reprezentujący pole,
+ * @param[in,out] v      – wskaźnik na opis widocznego fragmentu planszy,
+ * @param[in] row        – numer wiersza kursora, licząc od górnego wiersza,
+ * @param[in] col        – numer kolumny kursora.
  */
-static bool check_screen_size(uint32_t lines, uint32_t columns) {
+static void follow_cursor(screen_t *screen, gamma_t *g, char *s, viewport_t *v,
+                          uint32_t row, uint32_t col) {
+    uint32_t top = scroll_position(row, v->top, v->height, v->board_height);
+    uint32_t left = scroll_position(col, v->left, v->width, v->board_width);
+    if (top == v->top && left == v->left)
+        return;
+    int32_t shift = (int32_t) top - (int32_t) v->top;
+    uint32_t distance = shift > 0 ? (uint32_t) shift : (uint32_t) -shift;
+    v->top = top;
+    if (left != v->left || distance >= v->height) {
+        v->left = left;
+        put_window(screen, g, s, v, 0, v->height);
+    } else {
+        screen_scroll(screen, 0, v->height - 1, shift);
+        if (shift > 0)
+            put_window(screen, g, s, v, v->height - distance, v->height);
+        else
+            put_window(screen, g, s, v, 0, distance);
+    }
+}
+
+/**
+ * @brief Dopasowuje widoczny fragment planszy do rozmiaru terminala.
+ * Fragment ma tyle wierszy i kolumn planszy, ile mieści się w terminalu
+ * obok @ref EXTRA_LINES wierszy i ostatniej kolumny (do której nie
+ * piszemy, by terminal nie przenosił kursora do następnego wiersza),
+ * ale co najmniej jeden wiersz i jedną kolumnę. Początek fragmentu
+ * jest poprawiany tak, by fragment nie wychodził poza planszę.
+ * @param[in,out] v – wskaźnik na opis widocznego fragmentu planszy
+ *                    z ustawionymi wymiarami planszy i szerokością pola.
+ * @return Wartość @p true, jeśli udało się odczytać rozmiar terminala
+ * i mieści się w nim co najmniej jedno pole, @p false w przeciwnym
+ * przypadku.
+ */
+static bool viewport_setup(viewport_t *v) {
     struct winsize w;
     if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &w) == IOCTL_ERROR)
         return false;
-    return lines < w.ws_row && columns < w.ws_col;
+    uint32_t lines = w.ws_row > EXTRA_LINES ? w.ws_row - EXTRA_LINES : 0;
+    uint32_t fields = w.ws_col > 0 ? (w.ws_col - 1u) / v->field_width : 0;
+    bool fits = lines > 0 && fields > 0;
+    v->term_cols = w.ws_col > 1 ? w.ws_col : 2;
+    v->height = lines < v->board_height ? lines : v->board_height;
+    v->width = fields < v->board_width ? fields : v->board_width;
+    if (v->height == 0)
+        v->height = 1;
+    if (v->width == 0)
+        v->width = 1;
+    if (v->top + v->height > v->board_height)
+        v->top = v->board_height - v->height;
+    if (v->left + v->width > v->board_width)
+        v->left = v->board_width - v->width;
+    return fits;
+}
+
+/**
+ * @brief Tworzy bufor ekranu dla widocznego fragmentu planszy i rysuje go.
+ * Ekran składa się z widocznych wierszy planszy, wiersza z napisem
+ * reprezentującym gracza i wiersza komunikatu.
+ * @param[in] g     – wskaźnik na strukturę reprezentującą stan planszy,
+ * @param[out] s    – bufor na napis reprezentujący pole,
+ * @param[in] v     – wskaźnik na opis widocznego fragmentu planszy.
+ * @return Wskaźnik na bufor ekranu lub @p NULL, jeśli nie udało się
+ * zaalokować pamięci.
+ */
+static screen_t *screen_start(gamma_t *g, char *s, const viewport_t *v) {
+    screen_t *screen = screen_new(v->height + 2, v->term_cols - 1);
+    if (screen != NULL)
+        put_window(screen, g, s, v, 0, v->height);
+    return screen;
+}
+
+/**
+ * @brief Włącza lub wyłącza nakładkę legalnych ruchów.
+ * Przy pierwszym włączeniu alokuje mapy. Po włączeniu mapa zostanie
+ * wyznaczona przed narysowaniem następnej klatki, po wyłączeniu widoczny
+ * fragment planszy jest rysowany od nowa bez podświetleń.
+ * @param[in,out] screen – wskaźnik na bufor ekranu,
+ * @param[in] g          – wskaźnik na strukturę reprezentującą stan planszy,
+ * @param[out] s         – bufor na napis reprezentujący pole,
+ * @param[in,out] v      – wskaźnik na opis widocznego fragmentu planszy,
+ * @param[in,out] o      – wskaźnik na nakładkę.
+ */
+static void toggle_overlay(screen_t *screen, gamma_t *g, char *s, viewport_t *v,
+                           overlay_t *o) {
+    if (o->enabled) {
+        o->enabled = false;
+        v->legal = NULL;
+        put_window(screen, g, s, v, 0, v->height);
+        return;
+    }
+    size_t cells = (size_t) v->board_width * v->board_height;
+    if (o->shown == NULL) {
+        o->shown = malloc(cells);
+        o->fresh = malloc(cells);
+        if (o->shown == NULL || o->fresh == NULL) {
+            free(o->shown);
+            free(o->fresh);
+            o->shown = o->fresh = NULL;
+            return;
+        }
+    }
+    memset(o->shown, 0, cells);
+    v->legal = o->shown;
+    o->enabled = true;
+    o->stale = true;
+}
+
+/**
+ * @brief Wyznacza ponownie mapę legalnych ruchów, jeśli jest nieaktualna,
+ * i przerysowuje widoczne pola, których podświetlenie się zmieniło.
+ * @param[in,out] screen – wskaźnik na bufor ekranu,
+ * @param[in] g          – wskaźnik na strukturę reprezentującą stan planszy,
+ * @param[out] s         – bufor na napis reprezentujący pole,
+ * @param[in,out] v      – wskaźnik na opis widocznego fragmentu planszy,
+ * @param[in,out] o      – wskaźnik na nakładkę,
+ * @param[in] player     – numer gracza, którego jest tura.
+ */
+static void refresh_overlay(screen_t *screen, gamma_t *g, char *s, viewport_t *v,
+                            overlay_t *o, uint32_t player) {
+    if (!o->enabled || !o->stale || !gamma_legal_map(g, player, o->fresh))
+        return;
+    v->legal = o->fresh;
+    for (uint32_t row = v->top; row < v->top + v->height; row++) {
+        uint64_t first = (uint64_t) (v->board_height - row - 1) * v->board_width;
+        for (uint32_t col = v->left; col < v->left + v->width; col++) {
+            if (o->fresh[first + col] != o->shown[first + col])
+                put_field_no_color(screen, g, s, v, row, col);
+        }
+    }
+    uint8_t *shown = o->fresh;
+    o->fresh = o->shown;
+    o->shown = shown;
+    o->stale = false;
 }
 
 /**
@@ -408,86 +577,6 @@ static void correct_coordinate(int *x_ptr, long long dimension) {
         *x_ptr = dimension - 1;
 }
 
-/**
- * @brief Zmienia kolor tła wyświetlanych napisów (podświetlenie)
- * poleceniem wywoływanym przez wyświetlenie kodu @p background.
- * a kolor wyświetlanych napisów na biały.
- * @param[in] background – kod wywołujący zmianę podświetlania napisów
- *                         w terminalu na określony kolor.
- */
-static void field_background(char *background) {
-    printf("%s", background);
-    printf("\033[37m");
-}
-
-/**
- * @brief Wyświetla napis reprezentujący pole na planszy.
- * Zapisuje w buforze @p s napis reprezentujący pole o współrzędnych
- * (@p x, @p y) w planszy, której stan reprezentuje struktura wskazywana
- * przez @p g. Używa do tego funkcji @ref gamma_write_field.
- * Zakłada, że bufor @p s jest zdolny pomieścić napis niekrótszy niż
- * wartość zwrócona przez funkcję @ref gamma_field_width_interactive
- * wywołaną dla paramtru @p g, i że bufor ten jest zakończony znakiem
- * końca łańcucha znaków.
- * Napis zapisany w buforze wyświetla za pomocą polecenia @p printf.
- * Na końcu przywraca kursor do początkowej pozycji.
- * @param[in] g  – wskaźnik na strukturę reprezentującą stan planszy,
- * @param[out] s – bufor, do którego ma być zapisana napisowa reprezentacja
- *                 pola, z założenia rozmiaru niemniejszego niż wartość
- *                 zwracana przez funkcję @ref gamma_field_width_interactive
- *                 wywołaną dla parametru @p g.
- * @param[in] x  – numer kolumny pola na planszy.
- * @param[in] y  – numer wiersza pola na planszy.
- */
-static void print_field_no_color(gamma_t *g, char *s, int x, int y) {
-    gamma_write_field(g, s, x, y);
-    save_cursor_position();
-    printf("%s", s);
-    restore_cursor_position();
-}
-
-/**
- * @brief Wyświetla napis reprezentujący "aktywne" pole na planszy.
- * Funkcja działa podobnie do funkcji @ref print_field_no_color.
- * Funkcja zapisuje w buforze @p s napis reprezentujący
- * pole o współrzędnych (@p x, @p y) w planszy, której stan
- * reprezentuje struktura wskazywana przez @p g. Używa do tego
- * funkcji @ref gamma_write_field.
- * Zakłada, że bufor @p s jest zdolny pomieścić napis niekrótszy niż
- * wartość zwrócona przez funkcję @ref gamma_field_width_interactive
- * wywołaną dla paramtru @p g, i że bufor ten jest zakończony znakiem
- * końca łańcucha znaków.
- * Tak nadpisany bufor funkcja wyświetla na kolorowym tle.
- * Kolor zależy od wartości argumentu @p is_good.
- * Jeżeli jest ona równa @p true, funkcja wyświetla bufor
- * @p s na tle koloru zielonego.
- * W przeciwnym przypadku, napis wyświetlany jest na czerwonym tle.
- * @param[in] g       – wskaźnik na strukturę reprezentującą stan planszy,
- * @param[out] s      – bufor, do którego ma być zapisana napisowa reprezentacja
- *                      pola, z założenia rozmiaru niemniejszego niż wartość
- *                      zwracana przez funkcję @ref gamma_field_width_interactive
- *                      wywołaną dla parametru @p g.
- * @param[in] x       – numer kolumny pola na planszy.
- * @param[in] y       – numer wiersza pola na planszy.
- * @param[in] is_good – zmienna typu @p bool.
- */
-static void print_field_color(gamma_t *g, char *s, uint32_t x, uint32_t y, bool is_good) {
-    char *col = NULL;
-    if (is_good)
-        col = GREEN_BACKGROUND;
-    else col = RED_BACKGROUND;
-    field_background(col);
-    gamma_write_field(g, s, x, y);
-    save_cursor_position();
-    uint32_t w = gamma_field_width_interactive(g);
-    int diff = w > 1;
-    for (uint32_t i = 0; i < w - diff; i++) {
-        putchar(s[i]);
-    }
-    restore_cursor_position();
-    reset_font();
-}
-
 /**
  * @brief Wykonuje funkcję @ref gamma_move i wyświetla komunikat,
  * jeśli zwróci ona wartość @p false.
@@ -500,22 +589,23 @@ static void print_field_color(gamma_t *g, char *s, uint32_t x, uint32_t y, bool
  * o numerze @p p.
  * Jeżeli wartość zwrócona przez funkcję @ref gamma_move jest równa
  * wartości @p false, funkcja wyświetla komunikat @ref WRONG_MOVE,
- * o niepoprawnej próbie wykonania ruchu w wierszu o numerze @p rows @p + @p 2.
+ * o niepoprawnej próbie wykonania ruchu w wierszu komunikatów bufora
+ * ekranu @p screen.
+ * @param[in,out] screen – wskaźnik na bufor ekranu,
  * @param[in,out] g – wskaźnik na strukturę reprezentującą stan gry,
- * @param[in] rows  – liczba wierszy w napisie reprezentującym stan gry,
+ * @param[in] v     – wskaźnik na opis widocznego fragmentu planszy
+ *                    (@p rows to liczba jej wierszy),
  * @param[in] row   – numer wiersza napisu reprezentującego pole na ekranie,
  * @param[in] col   – numer kolumny napisu reprezentującego pole na ekranie,
  * @param[in] p     – liczba odpowiadająca numerowi gracza.
  * @return Wartość zwrócona przez funkcję @ref gamma_move wywołaną
  * dla parametrów (@p g, @p p, @p col, @p rows @p - @p row @p - @p 1)
  */
-static bool move_helper(gamma_t *g, uint32_t rows, int row, int col, uint32_t p) {
-    bool ret = gamma_move(g, p, col, rows - row - 1);
-    if (!ret) {
-        printf(RED);
-        print_komunikat(WRONG_MOVE, rows);
-        reset_font();
-    }
+static bool move_helper(screen_t *screen, gamma_t *g, const viewport_t *v, int row,
+                          int col, uint32_t p) {
+    bool ret = gamma_move(g, p, col, v->board_height - row - 1);
+    if (!ret)
+        put_komunikat(screen, WRONG_MOVE, v->height);
     return ret;
 }
 
@@ -531,22 +621,26 @@ static bool move_helper(gamma_t *g, uint32_t rows, int row, int col, uint32_t p)
  * o numerze @p p.
  * Jeżeli wartość zwrócona przez funkcję @ref gamma_golden_move jest równa
  * wartości @p false, funkcja wyświetla komunikat @ref WRONG_GOLDEN_MOVE,
- * o niepoprawnej próbie wykonania ruchu w wierszu o numerze @p rows @p + @p 2.
+ * o niepoprawnej próbie wykonania ruchu w wierszu komunikatów bufora
+ * ekranu @p screen.
+ * @param[in,out] screen – wskaźnik na bufor ekranu,
  * @param[in,out] g – wskaźnik na strukturę reprezentującą stan gry,
- * @param[in] rows  – liczba wierszy w napisie reprezentującym stan gry,
+ * @param[in] v     – wskaźnik na opis widocznego fragmentu planszy
+ *                    (@p rows to liczba jej wierszy),
  * @param[in] row   – numer wiersza napisu reprezentującego pole na ekranie,
  * @param[in] col   – numer kolumny napisu reprezentującego pole na ekranie,
- * @param[in] p     – liczba odpowiadająca numerowi gracza.
+ * @param[in] p     – liczba odpowiadająca numerowi gracza,
+ * @param[out] previous – wskaźnik, pod który zostanie zapisany numer gracza
+ *                        zajmującego pole przed ruchem.
  * @return Wartość zwrócona przez funkcję @ref gamma_golden_move wywołaną
  * dla parametrów (@p g, @p p, @p col, @p rows @p - @p row @p - @p 1)
  */
-static bool golden_helper(gamma_t *g, uint32_t rows, int row, int col, uint32_t p) {
-    bool ret = gamma_golden_move(g, p, col, rows - row - 1);
-    if (!ret) {
-        printf(RED);
-        print_komunikat(WRONG_GOLDEN_MOVE, rows);
-        reset_font();
-    }
+static bool golden_helper(screen_t *screen, gamma_t *g, const viewport_t *v, int row,
+                          int col, uint32_t p, uint32_t *previous) {
+    *previous = gamma_field_owner(g, col, v->board_height - row - 1);
+    bool ret = gamma_golden_move(g, p, col, v->board_height - row - 1);
+    if (!ret)
+        put_komunikat(screen, WRONG_GOLDEN_MOVE, v->height);
     return ret;
 }
 
@@ -565,48 +659,82 @@ bool interactive(gamma_t *g, uint32_t *numbers) {
     uint32_t field_width = gamma_field_width_interactive(g);
     uint32_t columns = numbers[0], rows = numbers[1];
     uint32_t num_of_players = numbers[2], player = 1;
-    if (!check_screen_size(rows + 2, columns * field_width)) {
+    viewport_t view = {rows, columns, field_width, 0, 0, 0, 0, 0, NULL};
+    if (!viewport_setup(&view)) {
         wrong_terminal_size_message();
         return false;
     }
-    char *s, *buffer;
-    if (!alloc_strings(&s, &buffer, field_width, g))
+    char s[GAMMA_MAX_FIELD_WIDTH + 1];
+    s[field_width] = STRING_END;
+    screen_t *screen = screen_start(g, s, &view);
+    scheduler_t *sched = scheduler_new(g, num_of_players);
+    if (screen == NULL || sched == NULL) {
+        screen_delete(screen);
+        scheduler_delete(sched);
         return false;
+    }
+    uint32_t previous;
     int row_it = 0, col_it = 0;
+    player_status_t status = {NO_PLAYER, 0, 0, 0, false};
+    overlay_t overlay = {false, false, NULL, NULL};
     setup_terminal();
-    tryb_start(buffer);
     bool tryb_end = false;
     while (!tryb_end) {
-        bool is_good = gamma_move_possible(g, player, col_it, rows - row_it - 1);
-        erase_and_print_player(g, player, rows);
-        print_field_color(g, s, col_it, rows - row_it - 1, is_good);
+        if (!kbpending()) {
+            refresh_overlay(screen, g, s, &view, &overlay, player);
+            bool is_good = gamma_move_possible(g, player, col_it, rows - row_it - 1);
+            if (update_player_status(g, &status, player))
+                put_player(screen, &status, gamma_max_areas(g), view.height);
+            put_field_color(screen, g, s, &view, row_it, col_it, is_good);
+            screen_flush(screen);
+        }
         int c = kbget();
-        erase_komunikat_line(rows);
-        if (c == CTRL_D) {
+        screen_clear_line(screen, view.height + 1, 0);
+        put_field_no_color(screen, g, s, &view, row_it, col_it);
+        if (c == CTRL_D || c == EOF) {
             tryb_end = true;
+        } else if (c == KEY_RESIZE) {
+            screen_delete(screen);
+            viewport_setup(&view);
+            screen = screen_start(g, s, &view);
+            status.player = NO_PLAYER;
+            if (screen == NULL)
+                break;
         } else if (is_direction(c)) {
-            print_field_no_color(g, s, col_it, rows - row_it - 1);
             change_coordinates(c, &row_it, &col_it);
-        } else if (c == SPACE && move_helper(g, rows, row_it, col_it, player)) {
-            player = next_playing_player(g, player, num_of_players);
-        } else if (is_g(c) && golden_helper(g, rows, row_it, col_it, player)) {
-            player = next_playing_player(g, player, num_of_players);
+        } else if (c == SPACE && move_helper(screen, g, &view, row_it, col_it, player)) {
+            status.player = NO_PLAYER;
+            overlay.stale = true;
+            scheduler_moved(sched, player, NO_PLAYER);
+            player = scheduler_next(sched, player);
+        } else if (is_g(c) && golden_helper(screen, g, &view, row_it, col_it, player,
+                                            &previous)) {
+            status.player = NO_PLAYER;
+            overlay.stale = true;
+            scheduler_moved(sched, player, previous);
+            player = scheduler_next(sched, player);
         } else if (c == BIG_C || c == SMALL_C) {
-            player = next_playing_player(g, player, num_of_players);
+            overlay.stale = true;
+            player = scheduler_next(sched, player);
+        } else if (c == BIG_H || c == SMALL_H) {
+            toggle_overlay(screen, g, s, &view, &overlay);
         }
         correct_coordinate(&row_it, rows);
         correct_coordinate(&col_it, columns);
-        if (!tryb_end)
-            move_to((row_it + 1), (col_it + 1) * field_width - (field_width - 1));
+        follow_cursor(screen, g, s, &view, row_it, col_it);
         if (player == NO_PLAYER)
             tryb_end = true;
     }
-    erase_komunikat_line(rows);
-    print_field_no_color(g, s, col_it, rows - row_it - 1);
-    print_players_summary(g, num_of_players, rows);
+    bool ok = screen != NULL;
+    if (ok) {
+        screen_clear_line(screen, view.height + 1, 0);
+        screen_finish(screen, view.height);
+    }
+    print_players_summary(g, num_of_players);
     restore_terminal();
-    show_cursor();
-    free(s);
-    free(buffer);
-    return true;
+    screen_delete(screen);
+    scheduler_delete(sched);
+    free(overlay.shown);
+    free(overlay.fresh);
+    return ok;
 }
@@ -0,0 +1,600 @@
+/** @file
+ * Pomiar wydajności trybu interaktywnego w pseudoterminalu.
+ *
+ * Program uruchamia funkcję @ref interactive w procesie potomnym, którego
+ * standardowe wejście i wyjście podłączone są do pseudoterminala, i wysyła
+ * do niej deterministyczny (zależny tylko od ziarna) ciąg klawiszy:
+ * przejścia strzałkami, ruchy, złote ruchy i pominięcia tury. Wyjście
+ * procesu potomnego interpretuje prosty model terminala, który rozumie
+ * kody wysyłane przez screen.h, więc prawdziwy terminal nie jest potrzebny.
+ *
+ * Klatką nazywamy całe wyjście wypisane w odpowiedzi na jeden klawisz.
+ * Klatka kończy się, gdy przez @ref FRAME_IDLE_NS nanosekund nie pojawi się
+ * nowy bajt; klawisze, po których w ciągu @ref FIRST_BYTE_TIMEOUT_NS
+ * nanosekund nic nie zostało wypisane, liczone są jako puste klatki.
+ * Dla niepustych klatek program wypisuje rozkład czasu od wysłania
+ * klawisza do ostatniego bajtu klatki (w nanosekundach), rozkład liczby
+ * bajtów w klatce i rozkład liczby komórek ekranu zmienionych przez klatkę.
+ * Wiersze zaczynające się znakiem @p # są komentarzami, wśród nich suma
+ * kontrolna ekranu po ostatnim klawiszu, która pozwala sprawdzić, że
+ * porównywane wersje rysują to samo.
+ *
+ * Wywołanie: @p gamma_interactive_bench [@p keys [@p width @p height
+ * @p players @p areas [@p rows @p cols]]].
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#define _GNU_SOURCE ///< Makro potrzebne do prawidłowej kompilacji.
+
+#include "gamma.h"
+#include "histogram.h"
+#include "interactive.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_KEYS 2000 ///< Domyślna liczba klawiszy.
+#define DEFAULT_WIDTH 40 ///< Domyślna szerokość planszy.
+#define DEFAULT_HEIGHT 40 ///< Domyślna wysokość planszy.
+#define DEFAULT_PLAYERS 4 ///< Domyślna liczba graczy.
+#define DEFAULT_AREAS 8 ///< Domyślna maksymalna liczba obszarów.
+#define DEFAULT_ROWS 24 ///< Domyślna liczba wierszy terminala.
+#define DEFAULT_COLS 80 ///< Domyślna liczba kolumn terminala.
+#define SEED 2020 ///< Ziarno generatora klawiszy.
+#define STARTUP_TIMEOUT_NS 1000000000ull ///< Czas oczekiwania na pierwszą klatkę.
+#define FIRST_BYTE_TIMEOUT_NS 50000000ull ///< Czas oczekiwania na początek klatki.
+#define FRAME_IDLE_NS 500000ull ///< Przerwa w wyjściu kończąca klatkę.
+#define READ_BUFFER_SIZE 65536 ///< Rozmiar bufora odczytu z pseudoterminala.
+#define MAX_PARAMS 16 ///< Największa liczba parametrów sekwencji CSI.
+#define MAX_KEY_LENGTH 3 ///< Najdłuższy kod klawisza.
+#define ESC '\033' ///< Znak rozpoczynający sekwencję sterującą.
+#define CTRL_D '\004' ///< Kod klawisza kończącego tryb interaktywny.
+#define FNV_OFFSET 14695981039346656037ull ///< Początkowa wartość skrótu FNV-1a.
+#define FNV_PRIME 1099511628211ull ///< Mnożnik skrótu FNV-1a.
+
+/**
+ * @brief Stany analizatora wyjścia terminala.
+ */
+typedef enum vt_state {
+    VT_GROUND, ///< Zwykłe znaki.
+    VT_ESCAPE, ///< Po znaku @ref ESC.
+    VT_CSI     ///< Wewnątrz sekwencji @p ESC @p [.
+} vt_state_t;
+
+/**
+ * @brief Struktura przechowująca model terminala.
+ * Atrybut komórki to kod koloru tekstu (@p 30-37 lub @p 0 dla domyślnego)
+ * w młodszym bajcie i kod koloru tła (@p 40-47 lub @p 0) w starszym.
+ */
+typedef struct vt {
+    uint32_t rows;                ///< Liczba wierszy.
+    uint32_t cols;                ///< Liczba kolumn.
+    char *chars;                  ///< Znaki ekranu, wiersz po wierszu.
+    uint16_t *attrs;              ///< Atrybuty komórek ekranu.
+    uint32_t row;                 ///< Wiersz kursora.
+    uint32_t col;                 ///< Kolumna kursora.
+    uint16_t attr;                ///< Bieżący atrybut.
+    uint32_t top;                 ///< Pierwszy wiersz obszaru przewijania.
+    uint32_t bottom;              ///< Ostatni wiersz obszaru przewijania.
+    vt_state_t state;             ///< Stan analizatora.
+    uint32_t params[MAX_PARAMS];  ///< Parametry bieżącej sekwencji CSI.
+    uint32_t num_params;          ///< Liczba parametrów bieżącej sekwencji.
+    bool private_mode;            ///< Równe @p true po znaku @p ? w sekwencji.
+    uint64_t changed;             ///< Liczba zmienionych komórek.
+    uint64_t unknown;             ///< Liczba nierozpoznanych sekwencji.
+} vt_t;
+
+/**
+ * @brief Struktura przechowująca stan generatora klawiszy.
+ */
+typedef struct keys {
+    uint64_t random; ///< Stan generatora liczb pseudolosowych.
+    uint32_t rows;   ///< Liczba wierszy planszy.
+    uint32_t cols;   ///< Liczba kolumn planszy.
+    uint32_t row;    ///< Wiersz kursora na planszy, licząc od góry.
+    uint32_t col;    ///< Kolumna kursora na planszy.
+} keys_t;
+
+/**
+ * @brief Generator liczb pseudolosowych (xorshift64).
+ * @param[in,out] state – stan generatora, różny od @p 0.
+ * @return Kolejna liczba pseudolosowa.
+ */
+static uint64_t next_random(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *state = x;
+}
+
+/**
+ * @brief Zwraca bieżący czas w nanosekundach.
+ * @return Czas zegara monotonicznego w nanosekundach.
+ */
+static uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/**
+ * @brief Tworzy model terminala z pustym ekranem.
+ * @param[out] vt  – wskaźnik na model terminala,
+ * @param[in] rows – liczba wierszy,
+ * @param[in] cols – liczba kolumn.
+ * @return Wartość @p true, jeśli udało się zaalokować pamięć, @p false
+ * w przeciwnym przypadku.
+ */
+static bool vt_init(vt_t *vt, uint32_t rows, uint32_t cols) {
+    memset(vt, 0, sizeof(vt_t));
+    vt->rows = rows;
+    vt->cols = cols;
+    vt->bottom = rows - 1;
+    vt->chars = malloc((size_t) rows * cols);
+    vt->attrs = calloc((size_t) rows * cols, sizeof(uint16_t));
+    if (vt->chars == NULL || vt->attrs == NULL)
+        return false;
+    memset(vt->chars, ' ', (size_t) rows * cols);
+    return true;
+}
+
+/**
+ * @brief Zwalnia pamięć modelu terminala.
+ * @param[in,out] vt – wskaźnik na model terminala.
+ */
+static void vt_free(vt_t *vt) {
+    free(vt->chars);
+    free(vt->attrs);
+}
+
+/**
+ * @brief Zapisuje znak w komórce ekranu z bieżącym atrybutem.
+ * @param[in,out] vt – wskaźnik na model terminala,
+ * @param[in] row    – numer wiersza,
+ * @param[in] col    – numer kolumny,
+ * @param[in] c      – znak.
+ */
+static void vt_set(vt_t *vt, uint32_t row, uint32_t col, char c) {
+    size_t cell = (size_t) row * vt->cols + col;
+    if (vt->chars[cell] != c || vt->attrs[cell] != vt->attr) {
+        vt->chars[cell] = c;
+        vt->attrs[cell] = vt->attr;
+        vt->changed++;
+    }
+}
+
+/**
+ * @brief Czyści komórki od @p from do @p to (bez @p to), licząc wiersz
+ * po wierszu od początku ekranu.
+ * @param[in,out] vt – wskaźnik na model terminala,
+ * @param[in] from   – numer pierwszej komórki,
+ * @param[in] to     – numer komórki za ostatnią.
+ */
+static void vt_erase(vt_t *vt, size_t from, size_t to) {
+    for (size_t cell = from; cell < to; cell++)
+        vt_set(vt, cell / vt->cols, cell % vt->cols, ' ');
+}
+
+/**
+ * @brief Przewija obszar przewijania.
+ * @param[in,out] vt – wskaźnik na model terminala,
+ * @param[in] n      – liczba wierszy, dodatnia w górę, ujemna w dół.
+ */
+static void vt_scroll(vt_t *vt, int64_t n) {
+    uint32_t height = vt->bottom - vt->top + 1;
+    uint32_t shift = n > 0 ? n : -n;
+    if (shift > height)
+        shift = height;
+    size_t row = vt->cols;
+    char *chars = vt->chars + (size_t) vt->top * row;
+    uint16_t *attrs = vt->attrs + (size_t) vt->top * row;
+    size_t kept = (height - shift) * row;
+    if (n > 0) {
+        memmove(chars, chars + shift * row, kept);
+        memmove(attrs, attrs + shift * row, kept * sizeof(uint16_t));
+        memset(chars + kept, ' ', shift * row);
+        memset(attrs + kept, 0, shift * row * sizeof(uint16_t));
+    } else {
+        memmove(chars + shift * row, chars, kept);
+        memmove(attrs + shift * row, attrs, kept * sizeof(uint16_t));
+        memset(chars, ' ', shift * row);
+        memset(attrs, 0, shift * row * sizeof(uint16_t));
+    }
+}
+
+/**
+ * @brief Zwraca parametr sekwencji CSI.
+ * @param[in] vt   – wskaźnik na model terminala,
+ * @param[in] i    – numer parametru,
+ * @param[in] def  – wartość domyślna.
+ * @return Parametr o numerze @p i lub @p def, jeśli go nie podano lub jest
+ * równy @p 0.
+ */
+static uint32_t vt_param(const vt_t *vt, uint32_t i, uint32_t def) {
+    return i < vt->num_params && vt->params[i] != 0 ? vt->params[i] : def;
+}
+
+/**
+ * @brief Ustawia bieżący atrybut według sekwencji SGR.
+ * Pomija parametry inne niż kolory i przywrócenie ustawień domyślnych.
+ * @param[in,out] vt – wskaźnik na model terminala.
+ */
+static void vt_sgr(vt_t *vt) {
+    for (uint32_t i = 0; i < vt->num_params || i == 0; i++) {
+        uint32_t p = i < vt->num_params ? vt->params[i] : 0;
+        if (p == 0)
+            vt->attr = 0;
+        else if ((p >= 30 && p <= 37) || p == 39)
+            vt->attr = (vt->attr & 0xff00) | (p == 39 ? 0 : p);
+        else if ((p >= 40 && p <= 47) || p == 49)
+            vt->attr = (vt->attr & 0x00ff) | ((p == 49 ? 0 : p) << 8);
+    }
+}
+
+/**
+ * @brief Wykonuje sekwencję CSI zakończoną znakiem @p final.
+ * @param[in,out] vt – wskaźnik na model terminala,
+ * @param[in] final  – ostatni znak sekwencji.
+ */
+static void vt_csi(vt_t *vt, char final) {
+    size_t cursor = (size_t) vt->row * vt->cols + vt->col;
+    switch (final) {
+        case 'H':
+        case 'f':
+            vt->row = vt_param(vt, 0, 1) - 1;
+            vt->col = vt_param(vt, 1, 1) - 1;
+            break;
+        case 'A':
+            vt->row -= vt_param(vt, 0, 1) > vt->row ? vt->row : vt_param(vt, 0, 1);
+            break;
+        case 'B':
+            vt->row += vt_param(vt, 0, 1);
+            break;
+        case 'C':
+            vt->col += vt_param(vt, 0, 1);
+            break;
+        case 'D':
+            vt->col -= vt_param(vt, 0, 1) > vt->col ? vt->col : vt_param(vt, 0, 1);
+            break;
+        case 'J':
+            if (vt->num_params > 0 && vt->params[0] == 2)
+                vt_erase(vt, 0, (size_t) vt->rows * vt->cols);
+            else
+                vt_erase(vt, cursor, (size_t) vt->rows * vt->cols);
+            break;
+        case 'K':
+            vt_erase(vt, cursor, (size_t) (vt->row + 1) * vt->cols);
+            break;
+        case 'm':
+            vt_sgr(vt);
+            break;
+        case 'r':
+            vt->top = vt_param(vt, 0, 1) - 1;
+            vt->bottom = vt_param(vt, 1, vt->rows) - 1;
+            if (vt->bottom >= vt->rows || vt->top > vt->bottom) {
+                vt->top = 0;
+                vt->bottom = vt->rows - 1;
+            }
+            vt->row = 0;
+            vt->col = 0;
+            break;
+        case 'S':
+            vt_scroll(vt, vt_param(vt, 0, 1));
+            break;
+        case 'T':
+            vt_scroll(vt, -(int64_t) vt_param(vt, 0, 1));
+            break;
+        case 'h':
+        case 'l':
+            if (!vt->private_mode)
+                vt->unknown++;
+            break;
+        default:
+            vt->unknown++;
+    }
+    if (vt->row >= vt->rows)
+        vt->row = vt->rows - 1;
+    if (vt->col >= vt->cols)
+        vt->col = vt->cols - 1;
+}
+
+/**
+ * @brief Przetwarza znak wypisany poza sekwencjami sterującymi.
+ * @param[in,out] vt – wskaźnik na model terminala,
+ * @param[in] c      – znak.
+ */
+static void vt_ground(vt_t *vt, char c) {
+    if (c == ESC) {
+        vt->state = VT_ESCAPE;
+    } else if (c == '\r') {
+        vt->col = 0;
+    } else if (c == '\n') {
+        if (vt->row == vt->bottom)
+            vt_scroll(vt, 1);
+        else if (vt->row + 1 < vt->rows)
+            vt->row++;
+    } else if (c == '\b') {
+        if (vt->col > 0)
+            vt->col--;
+    } else if ((unsigned char) c >= ' ') {
+        vt_set(vt, vt->row, vt->col, c);
+        if (vt->col + 1 < vt->cols)
+            vt->col++;
+    }
+}
+
+/**
+ * @brief Przetwarza bajty wypisane na terminal.
+ * @param[in,out] vt – wskaźnik na model terminala,
+ * @param[in] data   – bajty,
+ * @param[in] len    – liczba bajtów.
+ */
+static void vt_feed(vt_t *vt, const char *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        char c = data[i];
+        switch (vt->state) {
+            case VT_GROUND:
+                vt_ground(vt, c);
+                break;
+            case VT_ESCAPE:
+                if (c == '[') {
+                    vt->state = VT_CSI;
+                    vt->num_params = 0;
+                    vt->private_mode = false;
+                } else {
+                    vt->state = VT_GROUND;
+                    vt->unknown++;
+                }
+                break;
+            case VT_CSI:
+                if (c == '?') {
+                    vt->private_mode = true;
+                } else if (c >= '0' && c <= '9') {
+                    if (vt->num_params == 0)
+                        vt->params[vt->num_params++] = 0;
+                    uint32_t *p = &vt->params[vt->num_params - 1];
+                    *p = *p * 10 + (c - '0');
+                } else if (c == ';') {
+                    if (vt->num_params == 0)
+                        vt->params[vt->num_params++] = 0;
+                    if (vt->num_params < MAX_PARAMS)
+                        vt->params[vt->num_params++] = 0;
+                } else if (c >= '@' && c <= '~') {
+                    vt_csi(vt, c);
+                    vt->state = VT_GROUND;
+                }
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Liczy sumę kontrolną ekranu.
+ * @param[in] vt – wskaźnik na model terminala.
+ * @return Skrót FNV-1a znaków i atrybutów ekranu.
+ */
+static uint64_t vt_checksum(const vt_t *vt) {
+    uint64_t hash = FNV_OFFSET;
+    for (size_t cell = 0; cell < (size_t) vt->rows * vt->cols; cell++) {
+        hash = (hash ^ (unsigned char) vt->chars[cell]) * FNV_PRIME;
+        hash = (hash ^ vt->attrs[cell]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Generuje kod kolejnego klawisza.
+ * Siedem na dziesięć klawiszy to strzałki przesuwające kursor w losowym
+ * kierunku, w którym nie opuści on planszy; pozostałe to ruchy, złote
+ * ruchy i pominięcia tury.
+ * @param[in,out] k – wskaźnik na stan generatora,
+ * @param[out] key  – bufor na co najmniej @ref MAX_KEY_LENGTH bajtów.
+ * @return Długość kodu klawisza.
+ */
+static size_t next_key(keys_t *k, char *key) {
+    uint64_t r = next_random(&k->random) % 100;
+    if (r >= 70) {
+        key[0] = r < 90 ? ' ' : r < 95 ? 'g' : 'c';
+        return 1;
+    }
+    char dirs[4];
+    uint32_t n = 0;
+    if (k->row > 0)
+        dirs[n++] = 'A';
+    if (k->row + 1 < k->rows)
+        dirs[n++] = 'B';
+    if (k->col + 1 < k->cols)
+        dirs[n++] = 'C';
+    if (k->col > 0)
+        dirs[n++] = 'D';
+    if (n == 0) {
+        key[0] = ' ';
+        return 1;
+    }
+    char dir = dirs[next_random(&k->random) % n];
+    k->row += dir == 'B' ? 1 : dir == 'A' ? -1 : 0;
+    k->col += dir == 'C' ? 1 : dir == 'D' ? -1 : 0;
+    key[0] = ESC;
+    key[1] = '[';
+    key[2] = dir;
+    return MAX_KEY_LENGTH;
+}
+
+/**
+ * @brief Odczytuje jedną klatkę z pseudoterminala.
+ * @param[in] fd          – deskryptor strony nadrzędnej pseudoterminala,
+ * @param[in,out] vt      – wskaźnik na model terminala,
+ * @param[in] first_wait  – czas oczekiwania na pierwszy bajt klatki
+ *                          w nanosekundach,
+ * @param[out] bytes      – wskaźnik, pod który zostanie zapisana liczba
+ *                          bajtów klatki,
+ * @param[out] last       – wskaźnik, pod który zostanie zapisany czas
+ *                          odczytu ostatniego bajtu klatki.
+ * @return Wartość @p false, jeśli proces potomny zamknął terminal,
+ * @p true w przeciwnym przypadku.
+ */
+static bool read_frame(int fd, vt_t *vt, uint64_t first_wait, uint64_t *bytes,
+                       uint64_t *last) {
+    static char buffer[READ_BUFFER_SIZE];
+    struct pollfd pfd = {fd, POLLIN, 0};
+    *bytes = 0;
+    while (true) {
+        uint64_t wait = *bytes == 0 ? first_wait : FRAME_IDLE_NS;
+        struct timespec ts = {wait / 1000000000ull, wait % 1000000000ull};
+        int ready = ppoll(&pfd, 1, &ts, NULL);
+        if (ready < 0 && errno == EINTR)
+            continue;
+        if (ready <= 0)
+            return ready == 0;
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        *last = now_ns();
+        *bytes += n;
+        vt_feed(vt, buffer, n);
+    }
+}
+
+/**
+ * @brief Uruchamia tryb interaktywny w procesie potomnym.
+ * Podłącza standardowe wejście i wyjście do podrzędnej strony
+ * pseudoterminala i kończy proces po wyjściu z trybu interaktywnego.
+ * @param[in] slave   – ścieżka podrzędnej strony pseudoterminala,
+ * @param[in] numbers – parametry gry: szerokość, wysokość, liczba graczy
+ *                      i maksymalna liczba obszarów.
+ */
+static void run_child(const char *slave, uint32_t *numbers) {
+    setsid();
+    int fd = open(slave, O_RDWR);
+    if (fd < 0)
+        _exit(1);
+    ioctl(fd, TIOCSCTTY, 0);
+    dup2(fd, STDIN_FILENO);
+    dup2(fd, STDOUT_FILENO);
+    dup2(fd, STDERR_FILENO);
+    if (fd > STDERR_FILENO)
+        close(fd);
+    gamma_t *g = gamma_new(numbers[0], numbers[1], numbers[2], numbers[3]);
+    bool ok = g != NULL && interactive(g, numbers);
+    gamma_delete(g);
+    fflush(stdout);
+    _exit(ok ? 0 : 1);
+}
+
+/**
+ * @brief Otwiera pseudoterminal o zadanym rozmiarze.
+ * @param[in] rows   – liczba wierszy,
+ * @param[in] cols   – liczba kolumn,
+ * @param[out] slave – wskaźnik, pod który zostanie zapisana ścieżka
+ *                     podrzędnej strony pseudoterminala.
+ * @return Deskryptor nadrzędnej strony pseudoterminala lub @p -1 w przypadku
+ * błędu.
+ */
+static int open_terminal(uint32_t rows, uint32_t cols, const char **slave) {
+    int fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (fd < 0)
+        return -1;
+    struct winsize ws = {rows, cols, 0, 0};
+    if (grantpt(fd) != 0 || unlockpt(fd) != 0 || (*slave = ptsname(fd)) == NULL
+        || ioctl(fd, TIOCSWINSZ, &ws) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int main(int argc, char *argv[]) {
+    uint64_t keys = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_KEYS;
+    uint32_t numbers[4] = {DEFAULT_WIDTH, DEFAULT_HEIGHT, DEFAULT_PLAYERS,
+                           DEFAULT_AREAS};
+    uint32_t rows = argc > 7 ? strtoul(argv[6], NULL, 10) : DEFAULT_ROWS;
+    uint32_t cols = argc > 7 ? strtoul(argv[7], NULL, 10) : DEFAULT_COLS;
+    for (int i = 0; i < 4 && argc > 5; i++)
+        numbers[i] = strtoul(argv[i + 2], NULL, 10);
+    if (numbers[0] == 0 || numbers[1] == 0 || numbers[2] == 0 || numbers[3] == 0
+        || rows == 0 || cols == 0 || rows > UINT16_MAX || cols > UINT16_MAX) {
+        fprintf(stderr, "usage: %s [keys [width height players areas [rows cols]]]\n",
+                argv[0]);
+        return 1;
+    }
+
+    vt_t vt;
+    const char *slave = NULL;
+    int fd = open_terminal(rows, cols, &slave);
+    if (!vt_init(&vt, rows, cols) || fd < 0) {
+        fprintf(stderr, "cannot open pseudo-terminal\n");
+        return 1;
+    }
+    fflush(stdout);
+    uint64_t start = now_ns(), bytes, last = start;
+    pid_t pid = fork();
+    if (pid < 0) {
+        fprintf(stderr, "fork failed\n");
+        return 1;
+    }
+    if (pid == 0)
+        run_child(slave, numbers);
+
+    bool alive = read_frame(fd, &vt, STARTUP_TIMEOUT_NS, &bytes, &last);
+    printf("# first frame %lu bytes in %lu ns\n", bytes, last - start);
+
+    histogram_t latency, frame_bytes, cells;
+    histogram_init(&latency);
+    histogram_init(&frame_bytes);
+    histogram_init(&cells);
+    uint64_t empty = 0;
+    keys_t k = {SEED, numbers[1], numbers[0], 0, 0};
+    char key[MAX_KEY_LENGTH];
+    for (uint64_t i = 0; i < keys && alive; i++) {
+        size_t len = next_key(&k, key);
+        vt.changed = 0;
+        uint64_t sent = now_ns();
+        if (write(fd, key, len) != (ssize_t) len)
+            break;
+        alive = read_frame(fd, &vt, FIRST_BYTE_TIMEOUT_NS, &bytes, &last);
+        if (bytes == 0) {
+            empty++;
+            continue;
+        }
+        histogram_record(&latency, last - sent);
+        histogram_record(&frame_bytes, bytes);
+        histogram_record(&cells, vt.changed);
+    }
+    uint64_t checksum = vt_checksum(&vt);
+
+    char end = CTRL_D;
+    if (alive && write(fd, &end, 1) == 1) {
+        while (read_frame(fd, &vt, STARTUP_TIMEOUT_NS, &bytes, &last) && bytes > 0)
+            ;
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+
+    histogram_print(&latency, "latency", stdout);
+    histogram_print(&frame_bytes, "bytes", stdout);
+    histogram_print(&cells, "cells", stdout);
+    printf("# %lu empty frames, %lu unknown sequences\n", empty, vt.unknown);
+    printf("# screen checksum %016lx\n", checksum);
+    close(fd);
+    vt_free(&vt);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        fprintf(stderr, "interactive mode failed\n");
+        return 1;
+    }
+    return 0;
+}
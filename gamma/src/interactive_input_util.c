@@ -9,8 +9,13 @@
  * @date 12.05.2020
  */
 
+#define _GNU_SOURCE ///< Makro potrzebne do prawidłowej kompilacji.
+
 #include "interactive_input_util.h"
 #include <termios.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -21,6 +26,18 @@
 #define C 'C' ///< Reprezentuje znak @p 'C'.
 #define D 'D' ///< Reprezentuje znak @p 'D'.
 #define BRACKET '[' ///< Reprezentuje znak @p '['.
+#define BIG_O 'O' /**< Reprezentuje znak @p 'O', od którego zaczynają się
+                   * sekwencje strzałek w trybie aplikacji terminala.
+                   */
+#define FINAL_BYTE_MIN 0x40 ///< Najmniejszy kod znaku kończącego sekwencję.
+#define FINAL_BYTE_MAX 0x7e ///< Największy kod znaku kończącego sekwencję.
+#define ESCAPE_TIMEOUT_MS 5 /**< Czas w milisekundach, przez który czekamy na
+                             * kolejny znak sekwencji zaczętej znakiem
+                             * @ref KEY_ESCAPE, zanim uznamy, że wciśnięto
+                             * sam klawisz @p ESCAPE.
+                             */
+#define NO_TIMEOUT -1 ///< Czas oczekiwania oznaczający czekanie bez limitu.
+#define INPUT_BUFFER_SIZE 256 ///< Rozmiar bufora wczytanych znaków.
 #define TERMINAL_FAILURE -1 /**< Kod zwracany przez funkcje @p tcgetattr i @p tcsetattr
                              * w razie niepowodzonia.
                              */
@@ -33,6 +50,37 @@ static struct termios term; /**< Przechowuje ustawienia terminala
                              */
 static struct termios oterm; ///< Przechowuje domyślne ustawienia terminala.
 
+/**
+ * @brief Bufor znaków wczytanych z wejścia, ale jeszcze nie rozpoznanych.
+ * Znaki nieprzetworzone leżą na pozycjach od @ref input_start do
+ * @ref input_end @p - @p 1.
+ */
+static unsigned char input[INPUT_BUFFER_SIZE];
+static size_t input_start = 0; ///< Pozycja pierwszego nieprzetworzonego znaku.
+static size_t input_end = 0;   ///< Pozycja za ostatnim wczytanym znakiem.
+
+/**
+ * @brief Flaga ustawiana po otrzymaniu sygnału @p SIGWINCH (zmiana rozmiaru
+ * terminala).
+ */
+static volatile sig_atomic_t resized = 0;
+
+static struct sigaction old_action; ///< Poprzednia obsługa sygnału @p SIGWINCH.
+static sigset_t old_mask; ///< Maska sygnałów sprzed trybu interaktywnego.
+static sigset_t wait_mask; /**< Maska sygnałów używana podczas czekania na
+                            * znaki, z odblokowanym sygnałem @p SIGWINCH;
+                            * poza czekaniem sygnał jest zablokowany.
+                            */
+
+/**
+ * @brief Obsługuje sygnał @p SIGWINCH.
+ * @param[in] sig – numer sygnału.
+ */
+static void on_resize(int sig) {
+    (void) sig;
+    resized = 1;
+}
+
 /**
  * @brief Kończy program z kodem @p 1.
  */
@@ -45,95 +93,214 @@ void setup_terminal() {
         terminate();
     memcpy(&term, &oterm, sizeof(term));
     term.c_lflag &= ~(ICANON | ECHO);
+    term.c_cc[VMIN] = 1;
+    term.c_cc[VTIME] = 0;
+    if (tcsetattr(STDIN_FILENO, TCSANOW, &term) == TERMINAL_FAILURE)
+        terminate();
+    input_start = input_end = 0;
+    resized = 0;
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = on_resize;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGWINCH, &action, &old_action);
+    sigset_t block;
+    sigemptyset(&block);
+    sigaddset(&block, SIGWINCH);
+    sigprocmask(SIG_BLOCK, &block, &old_mask);
+    wait_mask = old_mask;
+    sigdelset(&wait_mask, SIGWINCH);
 }
 
 void restore_terminal() {
     if (tcsetattr(STDIN_FILENO, TCSANOW, &oterm) == TERMINAL_FAILURE)
         terminate();
+    sigaction(SIGWINCH, &old_action, NULL);
+    sigprocmask(SIG_SETMASK, &old_mask, NULL);
 }
 
 /**
- * @brief Wczytuje jeden znak w trybie niekanonicznym.
- * Czeka dopóki znak nie pojawi się w strumieniu wejściowym.
- * @return Kod reprezentujący wczytany znak.
+ * @brief Wczytuje do bufora znaki dostępne na wejściu.
+ * Czeka na znaki co najwyżej @p timeout milisekund, a potem wczytuje
+ * jednym wywołaniem @p read wszystkie, które mieszczą się w buforze.
+ * Czekanie przerywa sygnał @p SIGWINCH, który jest odblokowany tylko na
+ * czas czekania, więc nie może zostać przegapiony między sprawdzeniem
+ * flagi @ref resized a rozpoczęciem czekania.
+ * Nieprzetworzone znaki zostają w buforze; jeśli brakuje miejsca za nimi,
+ * są przesuwane na jego początek.
+ * Tryb interaktywny zaczyna się po wczytaniu całej linii polecenia w trybie
+ * kanonicznym, więc bufor strumienia @p stdin nie przechowuje wtedy żadnych
+ * znaków i można czytać bezpośrednio z deskryptora.
+ * @param[in] timeout – maksymalny czas oczekiwania w milisekundach lub
+ *                      @ref NO_TIMEOUT.
+ * @return Liczba wczytanych znaków, wartość @p 0, jeśli w tym czasie nie
+ * pojawił się żaden znak lub zmienił się rozmiar terminala, lub wartość
+ * @p EOF, jeśli wejście się skończyło lub wystąpił błąd.
  */
-static int getch() {
-    term.c_cc[VMIN] = 1;
-    term.c_cc[VTIME] = 0;
-    if (tcsetattr(STDIN_FILENO, TCSANOW, &term) == TERMINAL_FAILURE)
-        terminate();
-    int c = getchar();
-    return c;
+static int fill_input(int timeout) {
+    struct pollfd p = {.fd = STDIN_FILENO, .events = POLLIN};
+    struct timespec ts = {timeout / 1000, (timeout % 1000) * 1000000L};
+    int ready;
+    while ((ready = ppoll(&p, 1, timeout == NO_TIMEOUT ? NULL : &ts,
+                          &wait_mask)) < 0 && errno == EINTR) {
+        if (resized)
+            return 0;
+    }
+    if (ready <= 0)
+        return ready < 0 ? EOF : 0;
+    if (input_start == input_end) {
+        input_start = input_end = 0;
+    } else if (input_end == INPUT_BUFFER_SIZE) {
+        memmove(input, input + input_start, input_end - input_start);
+        input_end -= input_start;
+        input_start = 0;
+    }
+    ssize_t n;
+    while ((n = read(STDIN_FILENO, input + input_end,
+                     INPUT_BUFFER_SIZE - input_end)) < 0 && errno == EINTR)
+        ;
+    if (n <= 0)
+        return EOF;
+    input_end += n;
+    return n;
 }
 
 /**
- * @brief Wczytuje znak i umieszcza go z powrotem w strumieniu wejściowym.
- * Wczytuje w trybie niekanonicznym znak z flagą @p VTIME ustawioną
- * na wartość @p 1 (to sprawia, że czeka tylko jedną dziesiątą sekundy na dane ze
- * strumienia wejściowego). Jeżeli uda się taki znak wczytać, umieszcza go
- * z powrotem w strumieniu wejściowym używając @p ungetc.
- * @return Wartość @p 1, jeśli udało się wczytać znak, wartość
- * @p 0 w przeciwnym przypadku.
+ * @brief Odczytuje nieprzetworzony znak wejścia, nie usuwając go z bufora.
+ * Jeśli w buforze brakuje znaku, czeka na kolejne znaki co najwyżej
+ * @p timeout milisekund (przy każdym wczytaniu).
+ * @param[in] offset  – pozycja znaku liczona od pierwszego
+ *                      nieprzetworzonego znaku, mniejsza od
+ *                      @ref INPUT_BUFFER_SIZE,
+ * @param[in] timeout – maksymalny czas oczekiwania w milisekundach lub
+ *                      @ref NO_TIMEOUT,
+ * @param[out] c      – wskaźnik na zmienną, do której zostanie zapisany
+ *                      kod znaku lub wartość @p EOF, jeśli wejście się
+ *                      skończyło.
+ * @return Wartość @p true, jeśli udało się odczytać znak lub wejście się
+ * skończyło, @p false, jeśli minął czas oczekiwania lub czekanie przerwała
+ * zmiana rozmiaru terminala (wtedy flaga @ref resized jest ustawiona).
  */
-static int kbhit() {
-    term.c_cc[VMIN] = 0;
-    term.c_cc[VTIME] = 1;
-    if (tcsetattr(STDIN_FILENO, TCSANOW, &term) == TERMINAL_FAILURE)
-        terminate();
-    int c = getchar();
-    if (c != -1) ungetc(c, stdin);
-    return ((c != -1) ? 1 : 0);
+static bool peek_byte(size_t offset, int timeout, int *c) {
+    while (input_end - input_start <= offset) {
+        int n = fill_input(timeout);
+        if (n == 0)
+            return false;
+        if (n == EOF) {
+            *c = EOF;
+            return true;
+        }
+    }
+    *c = input[input_start + offset];
+    return true;
+}
+
+/**
+ * @brief Zamienia ostatni znak sekwencji strzałki na kod klawisza.
+ * @param[in] c – kod ostatniego znaku sekwencji.
+ * @return Kod strzałki lub wartość @p 0, jeśli sekwencja nie reprezentuje
+ * strzałki.
+ */
+static int arrow_key(int c) {
+    switch (c) {
+        case A:
+            return KEY_UP;
+        case B:
+            return KEY_DOWN;
+        case C:
+            return KEY_LEFT;
+        case D:
+            return KEY_RIGHT;
+        default:
+            return 0;
+    }
 }
 
 /**
  * @brief Rozpoznaje klawisz kryjący się za sekwencją znaków.
- * Funkcja powinna być wywoływana, gdy wczytany został znak o kodzie
- * @ref KEY_ESCAPE. Funkcja sprawdza, czy następny wczytany znak
- * jest wczytywany "od razu". Jeżeli nie, to znak @ref KEY_ESCAPE
- * nie jest początkiem sekwencji znaków reprezentującej wciśnięcie
- * innego klawisza, więc funkcja zwraca wartość @ref KEY_ESCAPE.
- * Następnie funkcja sprawdza, czy następny
- * (wczytany od razu) znak ma kod @ref BRACKET.
- * Jeżeli tak, funkcja sprawdza, czy kodem znaku następującym po nim
- * jest któryś z @ref A, @ref B, @ref C lub @ref D. Jeżeli tak, to
- * wciśnięty został klawisz strzałki, i zwracany jest odpowiedni kod.
- * Jeżeli znak wczytany od razu po znaku o kodzie @ref KEY_ESCAPE
- * nie ma kodu równego @ref BRACKET funkcja wczytuje wszystkie
- * 'wczytywane od razu' znaki i zwraca wartość @p 0.
- * @return Kod odpowiadający klawiszowi kryjącemu się za sekwencją znaków
- * następującą po wczytanym znaku @ref KEY_ESCAPE lub wartość @p 0,
- * jeżeli nie rozpoznano żadnego klawisza.
+ * Funkcja powinna być wywoływana, gdy pierwszym nieprzetworzonym znakiem
+ * jest znak o kodzie @ref KEY_ESCAPE. Jeżeli następny znak nie pojawi się
+ * w ciągu @ref ESCAPE_TIMEOUT_MS milisekund, wciśnięty został sam klawisz
+ * @p ESCAPE. Jeżeli następny znak to @ref BRACKET lub @ref BIG_O,
+ * funkcja wczytuje sekwencję do znaku kończącego ją (o kodzie od
+ * @ref FINAL_BYTE_MIN do @ref FINAL_BYTE_MAX) i jeśli jest nim któryś
+ * z @ref A, @ref B, @ref C lub @ref D, zwraca kod odpowiedniej strzałki.
+ * Każdy inny znak po @ref KEY_ESCAPE (np. klawisz wciśnięty razem
+ * z @p ALT) jest pomijany.
+ * Sekwencja usuwana jest z bufora dopiero po rozpoznaniu, więc jeśli
+ * czekanie na jej kolejny znak przerwie zmiana rozmiaru terminala, można
+ * ją rozpoznać od nowa.
+ * @param[out] key – wskaźnik na zmienną, do której zostanie zapisany kod
+ *                   odpowiadający klawiszowi, wartość @p 0, jeżeli nie
+ *                   rozpoznano żadnego klawisza, lub wartość @p EOF, jeśli
+ *                   wejście się skończyło.
+ * @return Wartość @p true, jeśli rozpoznano sekwencję, @p false, jeśli
+ * czekanie przerwała zmiana rozmiaru terminala (sekwencja zostaje wtedy
+ * w buforze).
  */
-static int kbesc() {
-    if (!kbhit()) return KEY_ESCAPE;
-    int c = getch();
-    if (c == BRACKET) {
-        switch (getch()) {
-            case A:
-                c = KEY_UP;
-                break;
-            case B:
-                c = KEY_DOWN;
-                break;
-            case C:
-                c = KEY_LEFT;
-                break;
-            case D:
-                c = KEY_RIGHT;
-                break;
-            default:
-                c = 0;
-                break;
+static bool kbesc(int *key) {
+    int c;
+    if (!peek_byte(1, ESCAPE_TIMEOUT_MS, &c)) {
+        if (resized)
+            return false;
+        input_start++;
+        *key = KEY_ESCAPE;
+        return true;
+    }
+    if (c == EOF) {
+        input_start = input_end;
+        *key = EOF;
+        return true;
+    }
+    if (c != BRACKET && c != BIG_O) {
+        input_start += 2;
+        *key = 0;
+        return true;
+    }
+    bool csi = c == BRACKET;
+    for (size_t i = 2; i < INPUT_BUFFER_SIZE; i++) {
+        if (!peek_byte(i, ESCAPE_TIMEOUT_MS, &c)) {
+            if (resized)
+                return false;
+            input_start += i;
+            *key = 0;
+            return true;
+        }
+        if (c == EOF) {
+            input_start = input_end;
+            *key = EOF;
+            return true;
+        }
+        if (!csi || (c >= FINAL_BYTE_MIN && c <= FINAL_BYTE_MAX)) {
+            input_start += i + 1;
+            *key = arrow_key(c);
+            return true;
         }
-    } else {
-        c = 0;
     }
-    if (c == 0) while (kbhit()) getch();
-    return c;
+    input_start = input_end;
+    *key = 0;
+    return true;
 }
 
 int kbget() {
     int c;
-    c = getch();
-    return (c == KEY_ESCAPE) ? kbesc() : c;
+    while (true) {
+        if (resized) {
+            resized = 0;
+            return KEY_RESIZE;
+        }
+        if (!peek_byte(0, NO_TIMEOUT, &c))
+            continue;
+        if (c != KEY_ESCAPE) {
+            if (c != EOF)
+                input_start++;
+            return c;
+        }
+        if (kbesc(&c))
+            return c;
+    }
+}
+
+bool kbpending() {
+    return input_start < input_end || fill_input(0) > 0;
 }
@@ -13,23 +13,44 @@
 #ifndef GAMMA_INTERACTIVE_INPUT_UTIL_H
 #define GAMMA_INTERACTIVE_INPUT_UTIL_H
 
+#include <stdbool.h>
+
 #define KEY_ESCAPE  0x001b ///< Kod klawisza @p ESCAPE.
 #define KEY_UP      0x0105 ///< Kod reprezentujący strzałkę w górę, @p 261.
 #define KEY_DOWN    0x0106 ///< Kod reprezentujący strzałkę w dół, @p 262.
 #define KEY_LEFT    0x0107 ///< Kod reprezentujący strzałkę w lewo, @p 263.
 #define KEY_RIGHT   0x0108 ///< Kod reprezentujący strzałkę w prawo, @p 264.
+#define KEY_RESIZE  0x0109 ///< Kod reprezentujący zmianę rozmiaru terminala, @p 265.
 
 /**
  * @brief Wczytuje klawisz.
- * Rozpoznaje i zwraca kod reprezentujący wczytany klawisz.
+ * Czeka na klawisz, rozpoznaje i zwraca kod reprezentujący go.
+ * Znaki czytane są z wejścia paczkami do bufora, więc kolejne klawisze
+ * wciśnięte szybko po sobie nie wymagają wywołań systemowych.
+ * Zmiana rozmiaru terminala zgłoszona od poprzedniego wywołania
+ * (również w trakcie @ref kbpending lub w trakcie czekania na dalszą
+ * część sekwencji klawisza) jest zwracana przed kolejnym klawiszem, bez
+ * czekania.
  * @return Kod reprezentujący wczytany klawisz,
- * lub wartość @p 0, jeśli nie udało się go rozpoznać.
+ * wartość @p 0, jeśli nie udało się go rozpoznać, wartość @ref KEY_RESIZE,
+ * jeśli podczas czekania zmienił się rozmiar terminala, lub wartość
+ * @p EOF, jeśli wejście się skończyło.
  */
 int kbget();
 
+/**
+ * @brief Sprawdza, czy na wejściu czeka kolejny klawisz.
+ * Nie blokuje. Pozwala pominąć wyświetlanie stanów pośrednich, gdy
+ * użytkownik wcisnął kilka klawiszy naraz.
+ * @return Wartość @p true, jeśli na wejściu czekają znaki, @p false
+ * w przeciwnym przypadku. Zmiana rozmiaru terminala nie jest zgłaszana
+ * przez tę funkcję, tylko przez @ref kbget.
+ */
+bool kbpending();
+
 /**
  * @brief Przywraca ustawienia terminala zapisane w podczas wywołania funkcji
- * @ref setup_terminal.
+ * @ref setup_terminal i poprzednią obsługę sygnału @p SIGWINCH.
  */
 void restore_terminal();
 
@@ -39,7 +60,10 @@ void restore_terminal();
  * Zapisuje w zmiennej globalnej obecne ustawienia terminala.
  * Jeżeli nie uda się tego zrobić, kończy program z kodem
  * @p 1. Przechodzi do wczytywania bez czekania na @p ENTER
- * i bez wyświetlania wczytywanych znaków.
+ * i bez wyświetlania wczytywanych znaków. Ustawienia zmieniane są raz
+ * na cały tryb interaktywny, a nie przy każdym wczytywanym znaku.
+ * Instaluje obsługę sygnału @p SIGWINCH, dzięki której @ref kbget
+ * zgłasza zmianę rozmiaru terminala.
  */
 void setup_terminal();
 
@@ -0,0 +1,193 @@
+/** @file
+ * Test obsługi zmiany rozmiaru terminala w trybie interaktywnym.
+ *
+ * Program uruchamia funkcję @ref interactive w procesie potomnym
+ * podłączonym do pseudoterminala i zmienia rozmiar terminala (co wysyła
+ * sygnał @p SIGWINCH) w chwilach, w których tryb interaktywny nie czeka
+ * na klawisz: tuż po samym znaku @p ESCAPE, gdy trwa czekanie na dalszą
+ * część sekwencji, i tuż po strzałce, gdy rysowana jest klatka. Po każdej
+ * zmianie sprawdza, że kolejne strzałki wciąż przesuwają kursor, czyli że
+ * proces potomny coś wypisuje.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#define _GNU_SOURCE ///< Makro potrzebne do prawidłowej kompilacji.
+
+// CMake w wersji release wyłącza asercje.
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include "gamma.h"
+#include "interactive.h"
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define ROUNDS 20 ///< Liczba powtórzeń każdego scenariusza.
+#define ROWS 24 ///< Liczba wierszy terminala.
+#define COLS 80 ///< Liczba kolumn terminala.
+#define STARTUP_TIMEOUT_MS 1000 ///< Czas oczekiwania na pierwszą klatkę.
+#define FRAME_TIMEOUT_MS 200 ///< Czas oczekiwania na początek klatki.
+#define FRAME_IDLE_MS 5 ///< Przerwa w wyjściu kończąca klatkę.
+#define ESCAPE_GAP_NS 1000000L ///< Odstęp między znakiem ESCAPE a zmianą rozmiaru.
+#define SETTLE_NS 20000000L /**< Czas, po którym tryb interaktywny na pewno
+                             * przestał czekać na dalszą część sekwencji.
+                             */
+#define CTRL_D '\004' ///< Kod klawisza kończącego tryb interaktywny.
+
+/**
+ * @brief Odczytuje jedną klatkę z pseudoterminala.
+ * @param[in] fd         – deskryptor strony nadrzędnej pseudoterminala,
+ * @param[in] first_wait – czas oczekiwania na pierwszy bajt klatki
+ *                         w milisekundach.
+ * @return Liczba bajtów klatki.
+ */
+static size_t read_frame(int fd, int first_wait) {
+    char buffer[4096];
+    struct pollfd pfd = {fd, POLLIN, 0};
+    size_t bytes = 0;
+    while (true) {
+        int ready = poll(&pfd, 1, bytes == 0 ? first_wait : FRAME_IDLE_MS);
+        if (ready < 0 && errno == EINTR)
+            continue;
+        if (ready <= 0)
+            return bytes;
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return bytes;
+        bytes += n;
+    }
+}
+
+/**
+ * @brief Zapisuje do pseudoterminala napis.
+ * @param[in] fd  – deskryptor strony nadrzędnej pseudoterminala,
+ * @param[in] key – napis.
+ */
+static void send_key(int fd, const char *key) {
+    size_t len = strlen(key);
+    assert(write(fd, key, len) == (ssize_t) len);
+}
+
+/**
+ * @brief Zmienia rozmiar pseudoterminala, przełączając się między dwoma
+ * rozmiarami.
+ * @param[in] fd      – deskryptor strony nadrzędnej pseudoterminala,
+ * @param[in,out] big – wskaźnik na zmienną mówiącą, czy terminal ma
+ *                      obecnie większy rozmiar.
+ */
+static void resize(int fd, bool *big) {
+    *big = !*big;
+    struct winsize ws = {ROWS + *big, COLS, 0, 0};
+    assert(ioctl(fd, TIOCSWINSZ, &ws) == 0);
+}
+
+/**
+ * @brief Czeka zadaną liczbę nanosekund.
+ * @param[in] ns – liczba nanosekund, mniejsza od miliarda.
+ */
+static void sleep_ns(long ns) {
+    struct timespec ts = {0, ns};
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR)
+        ;
+}
+
+/**
+ * @brief Sprawdza, że strzałki w prawo i w lewo wciąż rysują klatki.
+ * @param[in] fd – deskryptor strony nadrzędnej pseudoterminala.
+ */
+static void assert_responsive(int fd) {
+    send_key(fd, "\033[C");
+    assert(read_frame(fd, FRAME_TIMEOUT_MS) > 0);
+    send_key(fd, "\033[D");
+    assert(read_frame(fd, FRAME_TIMEOUT_MS) > 0);
+}
+
+/**
+ * @brief Uruchamia tryb interaktywny w procesie potomnym.
+ * @param[in] slave – ścieżka podrzędnej strony pseudoterminala.
+ */
+static void run_child(const char *slave) {
+    setsid();
+    int fd = open(slave, O_RDWR);
+    if (fd < 0)
+        _exit(1);
+    ioctl(fd, TIOCSCTTY, 0);
+    dup2(fd, STDIN_FILENO);
+    dup2(fd, STDOUT_FILENO);
+    dup2(fd, STDERR_FILENO);
+    if (fd > STDERR_FILENO)
+        close(fd);
+    uint32_t numbers[4] = {10, 10, 2, 4};
+    gamma_t *g = gamma_new(numbers[0], numbers[1], numbers[2], numbers[3]);
+    bool ok = g != NULL && interactive(g, numbers);
+    gamma_delete(g);
+    fflush(stdout);
+    _exit(ok ? 0 : 1);
+}
+
+/** @brief Testuje obsługę zmiany rozmiaru terminala.
+ * @return Zero, gdy test przebiegł poprawnie, a w przeciwnym przypadku
+ * kod zakończenia programu jest kodem błędu.
+ */
+int main() {
+    int fd = posix_openpt(O_RDWR | O_NOCTTY);
+    assert(fd >= 0);
+    struct winsize ws = {ROWS, COLS, 0, 0};
+    const char *slave;
+    assert(grantpt(fd) == 0 && unlockpt(fd) == 0);
+    assert((slave = ptsname(fd)) != NULL);
+    assert(ioctl(fd, TIOCSWINSZ, &ws) == 0);
+    pid_t pid = fork();
+    assert(pid >= 0);
+    if (pid == 0)
+        run_child(slave);
+
+    bool big = false;
+    assert(read_frame(fd, STARTUP_TIMEOUT_MS) > 0);
+    assert_responsive(fd);
+    for (int i = 0; i < ROUNDS; i++) {
+        // Zmiana rozmiaru w trakcie czekania na dalszą część sekwencji.
+        send_key(fd, "\033");
+        sleep_ns(ESCAPE_GAP_NS);
+        resize(fd, &big);
+        read_frame(fd, FRAME_TIMEOUT_MS);
+        sleep_ns(SETTLE_NS);
+        read_frame(fd, FRAME_IDLE_MS);
+        assert_responsive(fd);
+
+        // Zmiana rozmiaru w trakcie rysowania klatki.
+        send_key(fd, "\033[C");
+        resize(fd, &big);
+        read_frame(fd, FRAME_TIMEOUT_MS);
+        send_key(fd, "\033[D");
+        read_frame(fd, FRAME_TIMEOUT_MS);
+        assert_responsive(fd);
+    }
+
+    char end = CTRL_D;
+    assert(write(fd, &end, 1) == 1);
+    while (read_frame(fd, STARTUP_TIMEOUT_MS) > 0)
+        ;
+    int status = 0;
+    assert(waitpid(pid, &status, 0) == pid);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    close(fd);
+    return 0;
+}
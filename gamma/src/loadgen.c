@@ -0,0 +1,324 @@
+/** @file
+ * Generator obciążenia dla serwera gier (patrz server.h).
+ *
+ * Program otwiera @p sessions jednoczesnych połączeń z serwerem, w każdym
+ * tworzy grę poleceniem @p B, a następnie wysyła @p commands
+ * pseudolosowych poleceń, każde dopiero po otrzymaniu odpowiedzi na
+ * poprzednie. Połączenia rozdzielone są pomiędzy @p threads wątków, z których
+ * każdy obsługuje swoje połączenia za pomocą @p epoll. Na koniec wypisuje
+ * liczbę poleceń na sekundę oraz rozkład czasu od wysłania polecenia do
+ * otrzymania odpowiedzi (w nanosekundach).
+ *
+ * Wywołanie: @p gamma_loadgen @p socket [@p sessions [@p commands
+ * [@p threads]]].
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#define _GNU_SOURCE ///< Makro potrzebne do prawidłowej kompilacji.
+
+#include "histogram.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_SESSIONS 1000 ///< Domyślna liczba połączeń.
+#define DEFAULT_COMMANDS 1000 ///< Domyślna liczba poleceń w połączeniu.
+#define DEFAULT_THREADS 1 ///< Domyślna liczba wątków.
+#define BOARD_SIZE 32 ///< Wymiar planszy gry w każdym połączeniu.
+#define PLAYERS 4 ///< Liczba graczy w każdej grze.
+#define AREAS 16 ///< Maksymalna liczba obszarów gracza.
+#define MAX_EVENTS 256 ///< Liczba zdarzeń odbieranych jednym wywołaniem @p epoll_wait.
+#define RESPONSE_SIZE 64 ///< Rozmiar bufora na odpowiedź serwera.
+#define COMMAND_SIZE 48 ///< Rozmiar bufora na polecenie.
+
+/**
+ * @brief Struktura przechowująca stan połączenia.
+ */
+typedef struct client {
+    int fd;                      ///< Deskryptor gniazda.
+    uint64_t random;             ///< Stan generatora poleceń.
+    uint32_t sent;               ///< Liczba wysłanych poleceń.
+    bool started;                ///< Równe @p true po utworzeniu gry.
+    uint64_t sent_at;            ///< Czas wysłania ostatniego polecenia.
+    char buf[RESPONSE_SIZE];     ///< Niepełna odpowiedź serwera.
+    size_t len;                  ///< Długość niepełnej odpowiedzi.
+} client_t;
+
+/**
+ * @brief Struktura przechowująca stan i wynik wątku generatora.
+ */
+typedef struct thread_state {
+    pthread_t thread;            ///< Wątek.
+    const char *path;            ///< Ścieżka gniazda serwera.
+    uint32_t sessions;           ///< Liczba połączeń wątku.
+    uint32_t first_session;      ///< Numer pierwszego połączenia wątku.
+    uint32_t commands;           ///< Liczba poleceń w połączeniu.
+    pthread_barrier_t *barrier;  ///< Bariera rozpoczynająca pomiar.
+    histogram_t latency;         ///< Rozkład czasów odpowiedzi.
+    uint64_t errors;             ///< Liczba odpowiedzi @p ERROR.
+    bool failed;                 ///< Równe @p true, jeśli wątek nie zakończył pracy.
+} thread_state_t;
+
+/**
+ * @brief Generator liczb pseudolosowych (xorshift64).
+ * @param[in,out] state – stan generatora, różny od @p 0.
+ * @return Kolejna liczba pseudolosowa.
+ */
+static uint64_t next_random(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *state = x;
+}
+
+/**
+ * @brief Zwraca bieżący czas w nanosekundach.
+ * @return Czas zegara monotonicznego w nanosekundach.
+ */
+static uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/**
+ * @brief Wysyła cały bufor przez gniazdo.
+ * Gniazdo klienta jest nieblokujące, ale polecenia są krótkie, a klient
+ * wysyła kolejne dopiero po odebraniu odpowiedzi, więc zapis się nie blokuje.
+ * @param[in] fd  – deskryptor gniazda,
+ * @param[in] buf – dane,
+ * @param[in] len – długość danych.
+ * @return Wartość @p true, jeśli wysłano wszystkie dane.
+ */
+static bool send_all(int fd, const char *buf, size_t len) {
+    return send(fd, buf, len, MSG_NOSIGNAL) == (ssize_t) len;
+}
+
+/**
+ * @brief Wysyła kolejne pseudolosowe polecenie.
+ * Większość poleceń to ruchy, pozostałe to złote ruchy i zapytania
+ * @p b, @p f i @p q, na które serwer odpowiada jednym wierszem.
+ * @param[in,out] c – połączenie.
+ * @return Wartość @p true, jeśli udało się wysłać polecenie.
+ */
+static bool send_command(client_t *c) {
+    static const char queries[] = {'g', 'b', 'f', 'q'};
+    char cmd[COMMAND_SIZE];
+    uint64_t r = next_random(&c->random);
+    uint32_t player = r % PLAYERS + 1;
+    uint32_t x = (r >> 8) % BOARD_SIZE, y = (r >> 16) % BOARD_SIZE;
+    char type = (r >> 24) % 5 == 0 ? queries[(r >> 32) % 4] : 'm';
+    int len;
+    if (type == 'm' || type == 'g')
+        len = sprintf(cmd, "%c %u %u %u\n", type, player, x, y);
+    else
+        len = sprintf(cmd, "%c %u\n", type, player);
+    c->sent_at = now_ns();
+    c->sent++;
+    return send_all(c->fd, cmd, len);
+}
+
+/**
+ * @brief Łączy się z serwerem.
+ * @param[in] path – ścieżka gniazda serwera.
+ * @return Deskryptor nieblokującego gniazda lub @p -1.
+ */
+static int connect_to(const char *path) {
+    struct sockaddr_un addr = {.sun_family = AF_UNIX};
+    if (strlen(path) >= sizeof(addr.sun_path))
+        return -1;
+    strcpy(addr.sun_path, path);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+    if (connect(fd, (struct sockaddr *) &addr, sizeof(addr)) != 0
+        || fcntl(fd, F_SETFL, O_NONBLOCK) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Obsługuje odpowiedzi serwera w połączeniu.
+ * Dla każdej pełnej odpowiedzi zapisuje czas jej oczekiwania i wysyła
+ * kolejne polecenie.
+ * @param[in,out] t – stan wątku,
+ * @param[in,out] c – połączenie.
+ * @return Wartość @p true, jeśli połączenie zakończyło pracę (wysłało
+ * wszystkie polecenia lub wystąpił błąd).
+ */
+static bool client_read(thread_state_t *t, client_t *c) {
+    ssize_t n = read(c->fd, c->buf + c->len, RESPONSE_SIZE - c->len);
+    if (n < 0 && (errno == EAGAIN || errno == EINTR))
+        return false;
+    if (n <= 0) {
+        t->failed = true;
+        return true;
+    }
+    c->len += n;
+    char *nl;
+    while ((nl = memchr(c->buf, '\n', c->len)) != NULL) {
+        size_t line_len = nl - c->buf + 1;
+        if (!c->started) {
+            c->started = true;
+        } else {
+            histogram_record(&t->latency, now_ns() - c->sent_at);
+            if (strncmp(c->buf, "ERROR", 5) == 0)
+                t->errors++;
+        }
+        memmove(c->buf, c->buf + line_len, c->len - line_len);
+        c->len -= line_len;
+        if (c->sent == t->commands)
+            return true;
+        if (!send_command(c)) {
+            t->failed = true;
+            return true;
+        }
+    }
+    if (c->len == RESPONSE_SIZE) {
+        t->failed = true;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Główna funkcja wątku generatora.
+ * Nawiązuje połączenia, czeka na pozostałe wątki, a następnie prowadzi
+ * gry we wszystkich swoich połączeniach jednocześnie.
+ * @param[in] arg – wskaźnik na stan wątku.
+ * @return Wartość @p NULL.
+ */
+static void *thread_main(void *arg) {
+    thread_state_t *t = arg;
+    client_t *clients = calloc(t->sessions, sizeof(client_t));
+    int epoll_fd = epoll_create1(0);
+    uint32_t connected = 0;
+    if (clients != NULL && epoll_fd >= 0) {
+        for (; connected < t->sessions; connected++) {
+            client_t *c = &clients[connected];
+            c->random = t->first_session + connected + 1;
+            c->fd = connect_to(t->path);
+            if (c->fd < 0)
+                break;
+            struct epoll_event ev = {.events = EPOLLIN, .data.ptr = c};
+            epoll_ctl(epoll_fd, EPOLL_CTL_ADD, c->fd, &ev);
+        }
+    }
+    if (connected < t->sessions)
+        t->failed = true;
+    pthread_barrier_wait(t->barrier);
+
+    char start[COMMAND_SIZE];
+    int len = sprintf(start, "B %d %d %d %d\n", BOARD_SIZE, BOARD_SIZE, PLAYERS, AREAS);
+    uint32_t active = 0;
+    for (uint32_t i = 0; i < connected; i++)
+        if (send_all(clients[i].fd, start, len))
+            active++;
+        else
+            t->failed = true;
+    struct epoll_event events[MAX_EVENTS];
+    while (active > 0) {
+        int n = epoll_wait(epoll_fd, events, MAX_EVENTS, -1);
+        if (n < 0 && errno != EINTR)
+            break;
+        for (int i = 0; i < n; i++) {
+            client_t *c = events[i].data.ptr;
+            if (client_read(t, c)) {
+                epoll_ctl(epoll_fd, EPOLL_CTL_DEL, c->fd, NULL);
+                active--;
+            }
+        }
+    }
+    for (uint32_t i = 0; i < connected; i++)
+        close(clients[i].fd);
+    if (epoll_fd >= 0)
+        close(epoll_fd);
+    free(clients);
+    return NULL;
+}
+
+/**
+ * @brief Podnosi limit otwartych deskryptorów do maksymalnej dozwolonej
+ * wartości, by można było otworzyć tysiące połączeń.
+ */
+static void raise_file_limit() {
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t sessions = argc > 2 ? strtoul(argv[2], NULL, 10) : DEFAULT_SESSIONS;
+    uint32_t commands = argc > 3 ? strtoul(argv[3], NULL, 10) : DEFAULT_COMMANDS;
+    uint32_t threads = argc > 4 ? strtoul(argv[4], NULL, 10) : DEFAULT_THREADS;
+    if (argc < 2 || argc > 5 || sessions == 0 || commands == 0
+        || threads == 0 || threads > sessions) {
+        fprintf(stderr, "usage: %s socket [sessions [commands [threads]]]\n", argv[0]);
+        return 1;
+    }
+    raise_file_limit();
+
+    thread_state_t *states = calloc(threads, sizeof(thread_state_t));
+    if (states == NULL)
+        return 1;
+    pthread_barrier_t barrier;
+    pthread_barrier_init(&barrier, NULL, threads + 1);
+    uint32_t first = 0;
+    for (uint32_t i = 0; i < threads; i++) {
+        thread_state_t *t = &states[i];
+        t->path = argv[1];
+        t->sessions = sessions / threads + (i < sessions % threads);
+        t->first_session = first;
+        t->commands = commands;
+        t->barrier = &barrier;
+        histogram_init(&t->latency);
+        first += t->sessions;
+        if (pthread_create(&t->thread, NULL, thread_main, t) != 0) {
+            fprintf(stderr, "cannot create thread\n");
+            return 1;
+        }
+    }
+    pthread_barrier_wait(&barrier);
+    uint64_t start = now_ns();
+    histogram_t latency;
+    histogram_init(&latency);
+    uint64_t errors = 0;
+    bool failed = false;
+    for (uint32_t i = 0; i < threads; i++) {
+        pthread_join(states[i].thread, NULL);
+        histogram_merge(&latency, &states[i].latency);
+        errors += states[i].errors;
+        failed |= states[i].failed;
+    }
+    uint64_t elapsed = now_ns() - start;
+    pthread_barrier_destroy(&barrier);
+    free(states);
+
+    printf("sessions %u commands %lu errors %lu elapsed %.3f s\n",
+           sessions, latency.total, errors, elapsed / 1e9);
+    printf("throughput %.0f cmd/s\n", latency.total * 1e9 / elapsed);
+    histogram_print(&latency, "latency", stdout);
+    if (failed) {
+        fprintf(stderr, "some sessions failed\n");
+        return 1;
+    }
+    return 0;
+}
@@ -9,42 +9,199 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 #include "memory_util.h"
 
-bool init_arr_2D(void ***data_ptr, size_t type, uint64_t width, uint64_t height) {
+static _Atomic uint64_t allocs = 0;   ///< Liczba udanych alokacji.
+static _Atomic uint64_t frees = 0;    ///< Liczba zwolnień.
+static _Atomic uint64_t bytes = 0;    ///< Łączna liczba zaalokowanych bajtów.
+static _Atomic uint64_t live = 0;     ///< Liczba bajtów obecnie zajętych.
+static _Atomic uint64_t peak = 0;     ///< Największa wartość @ref live.
+static _Atomic uint64_t failures = 0; ///< Liczba nieudanych alokacji.
+static _Atomic uint64_t limit = 0;    ///< Limit zajętej pamięci lub @p 0.
+
+/** @brief Rezerwuje bajty w liczniku zajętej pamięci.
+ * @param[in] size – liczba bajtów.
+ * @return Wartość @p true, jeśli rezerwacja nie przekracza limitu, @p false
+ * w przeciwnym przypadku (wtedy licznik nie zmienia się).
+ */
+static bool reserve(uint64_t size) {
+    uint64_t max = atomic_load_explicit(&limit, memory_order_relaxed);
+    uint64_t now = atomic_fetch_add_explicit(&live, size, memory_order_relaxed) + size;
+    if (max != 0 && now > max) {
+        atomic_fetch_sub_explicit(&live, size, memory_order_relaxed);
+        atomic_fetch_add_explicit(&failures, 1, memory_order_relaxed);
+        return false;
+    }
+    uint64_t old = atomic_load_explicit(&peak, memory_order_relaxed);
+    while (now > old && !atomic_compare_exchange_weak_explicit(
+            &peak, &old, now, memory_order_relaxed, memory_order_relaxed))
+        ;
+    return true;
+}
+
+/** @brief Zwalnia bajty w liczniku zajętej pamięci.
+ * @param[in] size – liczba bajtów.
+ */
+static void release(uint64_t size) {
+    atomic_fetch_sub_explicit(&live, size, memory_order_relaxed);
+}
+
+/** @brief Zlicza wynik alokacji zarezerwowanych wcześniej bajtów.
+ * Jeśli alokacja się nie udała, zwalnia rezerwację.
+ * @param[in] ptr  – wynik alokacji,
+ * @param[in] size – liczba zarezerwowanych bajtów.
+ * @return Wskaźnik @p ptr.
+ */
+static void *account(void *ptr, uint64_t size) {
+    if (ptr == NULL) {
+        release(size);
+        atomic_fetch_add_explicit(&failures, 1, memory_order_relaxed);
+        return NULL;
+    }
+    atomic_fetch_add_explicit(&allocs, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&bytes, size, memory_order_relaxed);
+    return ptr;
+}
+
+void *mem_alloc(const gamma_allocator_t *a, size_t size) {
+    if (!reserve(size))
+        return NULL;
+    if (a == NULL)
+        return account(malloc(size), size);
+    return account(a->alloc(a->ctx, size), size);
+}
+
+void *mem_calloc(const gamma_allocator_t *a, size_t count, size_t size) {
+    if (size != 0 && count > SIZE_MAX / size)
+        return NULL;
+    if (a == NULL) {
+        if (!reserve(count * size))
+            return NULL;
+        return account(calloc(count, size), count * size);
+    }
+    void *data = mem_alloc(a, count * size);
+    if (data != NULL)
+        memset(data, 0, count * size);
+    return data;
+}
+
+void *mem_realloc(const gamma_allocator_t *a, void *ptr, size_t old_size,
+                  size_t new_size) {
+    if (new_size > old_size && !reserve(new_size - old_size))
+        return NULL;
+    void *data;
+    if (a == NULL)
+        data = realloc(ptr, new_size);
+    else
+        data = a->realloc(a->ctx, ptr, old_size, new_size);
+    if (data == NULL) {
+        if (new_size > old_size)
+            release(new_size - old_size);
+        atomic_fetch_add_explicit(&failures, 1, memory_order_relaxed);
+        return NULL;
+    }
+    if (new_size < old_size)
+        release(old_size - new_size);
+    atomic_fetch_add_explicit(&allocs, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&bytes, new_size, memory_order_relaxed);
+    return data;
+}
+
+void *mem_alloc_detached(size_t size) {
+    void *data = mem_alloc(NULL, size);
+    if (data != NULL)
+        release(size);
+    return data;
+}
+
+void mem_free(const gamma_allocator_t *a, void *ptr, size_t size) {
+    if (ptr == NULL)
+        return;
+    if (a == NULL)
+        free(ptr);
+    else
+        a->free(a->ctx, ptr, size);
+    release(size);
+    atomic_fetch_add_explicit(&frees, 1, memory_order_relaxed);
+}
+
+void mem_set_limit(uint64_t bytes_limit) {
+    atomic_store(&limit, bytes_limit);
+}
+
+void mem_get_stats(mem_stats_t *stats) {
+    stats->allocs = atomic_load(&allocs);
+    stats->frees = atomic_load(&frees);
+    stats->bytes = atomic_load(&bytes);
+    stats->live = atomic_load(&live);
+    stats->peak = atomic_load(&peak);
+    stats->failures = atomic_load(&failures);
+    stats->limit = atomic_load(&limit);
+}
+
+uint64_t arr_2D_size(size_t type, uint64_t width, uint64_t height) {
+    return sizeof(void *) * width + type * width * height;
+}
+
+/** @brief Ustawia wskaźniki na kolumny tablicy dwuwymiarowej.
+ * Kolumny leżą kolejno w jednym bloku pamięci, wskazywanym przez
+ * @p data[0].
+ * @param[in,out] data      – tablica wskaźników na kolumny,
+ * @param[in] type          – rozmiar typu danych, który przechowuje tablica,
+ * @param[in] width, height – wymiary tablicy dwuwymiarowej (@p [width][height])
+ */
+static void set_columns(void **data, size_t type, uint64_t width, uint64_t height) {
+    for (uint64_t i = 1; i < width; i++)
+        data[i] = (char *) data[0] + type * height * i;
+}
+
+bool init_arr_2D(const gamma_allocator_t *a, void ***data_ptr, size_t type,
+                 uint64_t width, uint64_t height) {
     void **data = NULL;
-    data = malloc(sizeof(int *) * width);
+    data = mem_alloc(a, sizeof(void *) * width);
     if (data == NULL)
         return false;
-    bool is_ok = true;
-    for (uint64_t i = 0; i < width; i++) {
-        data[i] = NULL;
-        if (!init_array_1D(&data[i], type, height))
-            is_ok = false;
+    if (!init_array_1D(a, &data[0], type * height, width)) {
+        mem_free(a, data, sizeof(void *) * width);
+        return false;
     }
-    if (!is_ok) {
-        free_array(data, width);
+    set_columns(data, type, width, height);
+    *data_ptr = data;
+    return true;
+}
+
+bool copy_arr_2D(const gamma_allocator_t *a, void ***data_ptr, void **src,
+                 size_t type, uint64_t width, uint64_t height) {
+    void **data = NULL;
+    data = mem_alloc(a, sizeof(void *) * width);
+    if (data == NULL)
+        return false;
+    data[0] = mem_alloc(a, type * width * height);
+    if (data[0] == NULL) {
+        mem_free(a, data, sizeof(void *) * width);
         return false;
     }
+    memcpy(data[0], src[0], type * width * height);
+    set_columns(data, type, width, height);
     *data_ptr = data;
     return true;
 }
 
-bool init_array_1D(void **data_ptr, size_t type, uint64_t len) {
+bool init_array_1D(const gamma_allocator_t *a, void **data_ptr, size_t type,
+                   uint64_t len) {
     void *data = NULL;
-    data = calloc(len, type);
+    data = mem_calloc(a, len, type);
     if (data == NULL)
         return false;
     *data_ptr = data;
     return true;
 }
 
-void free_array(void **arr, uint64_t width) {
+void free_array(const gamma_allocator_t *a, void **arr, size_t type,
+                uint64_t width, uint64_t height) {
     if (arr == NULL)
         return;
-    for (uint64_t i = 0; i < width; i++) {
-        if (arr[i] != NULL)
-            free(arr[i]);
-    }
-    free(arr);
+    mem_free(a, arr[0], type * width * height);
+    mem_free(a, arr, sizeof(void *) * width);
 }
\ No newline at end of file
@@ -1,6 +1,14 @@
 /** @file
  * Interfejs udostępniający metody pomagające alokować
  * i zwalniać pamięć dla dynamicznych tablic.
+ *
+ * Wszystkie alokacje silnika gry przechodzą przez funkcje @p mem_*, które
+ * zliczają wywołania i bajty (wspólnie dla wszystkich wątków) i pozwalają
+ * ustawić górny limit zajętej pamięci (patrz @ref mem_set_limit). Zwalniając
+ * pamięć należy podać rozmiar, z jakim została zaalokowana. Każda funkcja
+ * dostaje alokator gry (patrz gamma_allocator.h); wartość @p NULL oznacza
+ * funkcje biblioteki standardowej. Blok należy zwolnić lub realokować tym
+ * samym alokatorem, którym został zaalokowany.
  * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
  * @copyright Uniwersytet Warszawski
  * @date 07.04.2020
@@ -13,11 +21,98 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include "gamma_allocator.h"
+
+/**
+ * @brief Struktura przechowująca liczniki alokacji.
+ */
+typedef struct mem_stats {
+    uint64_t allocs;   ///< Liczba udanych alokacji i realokacji.
+    uint64_t frees;    ///< Liczba zwolnień.
+    uint64_t bytes;    ///< Łączna liczba zaalokowanych bajtów.
+    uint64_t live;     ///< Liczba bajtów obecnie zajętych.
+    uint64_t peak;     ///< Największa liczba jednocześnie zajętych bajtów.
+    uint64_t failures; /**< Liczba alokacji odrzuconych przez limit lub
+                        * nieudanych z braku pamięci.
+                        */
+    uint64_t limit;    ///< Limit zajętej pamięci, @p 0 oznacza brak limitu.
+} mem_stats_t;
+
+/** @brief Alokuje pamięć.
+ * Alokacja nie udaje się, jeśli przekroczyłaby limit zajętej pamięci.
+ * @param[in] a    – alokator lub @p NULL,
+ * @param[in] size – liczba bajtów.
+ * @return Wskaźnik na zaalokowaną pamięć lub @p NULL, jeśli się nie udało.
+ */
+void *mem_alloc(const gamma_allocator_t *a, size_t size);
+
+/** @brief Alokuje wyzerowaną pamięć dla tablicy.
+ * Alokacja nie udaje się, jeśli przekroczyłaby limit zajętej pamięci.
+ * @param[in] a     – alokator lub @p NULL,
+ * @param[in] count – liczba elementów,
+ * @param[in] size  – rozmiar elementu.
+ * @return Wskaźnik na zaalokowaną pamięć lub @p NULL, jeśli się nie udało.
+ */
+void *mem_calloc(const gamma_allocator_t *a, size_t count, size_t size);
+
+/** @brief Zmienia rozmiar zaalokowanej pamięci.
+ * Jeśli się nie udało, pamięć wskazywana przez @p ptr pozostaje bez zmian.
+ * @param[in] a        – alokator, którym zaalokowano pamięć, lub @p NULL,
+ * @param[in] ptr      – wskaźnik na pamięć zaalokowaną funkcją @p mem_*,
+ * @param[in] old_size – dotychczasowy rozmiar w bajtach,
+ * @param[in] new_size – nowy rozmiar w bajtach.
+ * @return Wskaźnik na pamięć o nowym rozmiarze lub @p NULL, jeśli się nie
+ * udało.
+ */
+void *mem_realloc(const gamma_allocator_t *a, void *ptr, size_t old_size,
+                  size_t new_size);
+
+/** @brief Alokuje pamięć, którą zwolni wywołujący funkcją @p free.
+ * Tak jak @ref mem_alloc sprawdza limit i zlicza alokację, ale nie wlicza
+ * jej do pamięci obecnie zajętej, bo jej zwolnienie nie przechodzi przez
+ * @ref mem_free. Służy do alokowania napisów zwracanych użytkownikowi.
+ * @param[in] size – liczba bajtów.
+ * @return Wskaźnik na zaalokowaną pamięć lub @p NULL, jeśli się nie udało.
+ */
+void *mem_alloc_detached(size_t size);
+
+/** @brief Zwalnia pamięć zaalokowaną funkcją @p mem_*.
+ * Jeżeli @p ptr jest równe @p NULL, funkcja nic nie robi.
+ * @param[in] a       – alokator, którym zaalokowano pamięć, lub @p NULL,
+ * @param[in,out] ptr – wskaźnik na pamięć,
+ * @param[in] size    – rozmiar pamięci w bajtach.
+ */
+void mem_free(const gamma_allocator_t *a, void *ptr, size_t size);
+
+/** @brief Ustawia limit zajętej pamięci.
+ * Alokacje, po których liczba zajętych bajtów przekroczyłaby limit, nie
+ * udają się. Limit nie dotyczy już zajętej pamięci.
+ * @param[in] limit – limit w bajtach, @p 0 oznacza brak limitu.
+ */
+void mem_set_limit(uint64_t limit);
+
+/** @brief Odczytuje liczniki alokacji.
+ * @param[out] stats – wskaźnik na strukturę, do której zostaną zapisane
+ *                     liczniki.
+ */
+void mem_get_stats(mem_stats_t *stats);
+
+/** @brief Zwraca liczbę bajtów zajmowanych przez tablicę dwuwymiarową.
+ * @param[in] type          – rozmiar typu danych, który przechowuje tablica,
+ * @param[in] width, height – wymiary tablicy dwuwymiarowej (@p [width][height])
+ * @return Liczba bajtów zajmowanych przez tablicę zaalokowaną przez
+ * @ref init_arr_2D.
+ */
+uint64_t arr_2D_size(size_t type, uint64_t width, uint64_t height);
 
 /** @brief Alokuje pamięć dla tablicy dwuwymiarowej.
  * Dokonuje alokacji pamięci dla dynamicznej tablicy dwuwymiarowej o wymiarach
  * @p [width][height], przechowującej dane typu o rozmiarze @p type, w miejscu
- * w pamięci wskazywanym przez @p data_ptr.
+ * w pamięci wskazywanym przez @p data_ptr. Wszystkie kolumny leżą kolejno
+ * w jednym wyzerowanym bloku, wskazywanym przez pierwszy wskaźnik tablicy,
+ * więc element @p [x][y] jest też elementem @p x @p * @p height @p + @p y
+ * tego bloku.
+ * @param[in] a             – alokator lub @p NULL,
  * @param[out] data_ptr     – adres zmiennej, będącej wskaźnikiem na wskaźnik
  *                            pewnego typu,
  * @param[in] type          – rozmiar typu danych, który ma przechowywać tablica,
@@ -25,28 +120,50 @@
  * @return Wartosć @p true, jeśli udało się zaalokować pamięć, @p false w
  * w przeciwnym przypadku.
  */
-bool init_arr_2D(void ***data_ptr, size_t type, uint64_t width, uint64_t height);
+bool init_arr_2D(const gamma_allocator_t *a, void ***data_ptr, size_t type,
+                 uint64_t width, uint64_t height);
+
+/** @brief Tworzy kopię tablicy dwuwymiarowej.
+ * Alokuje pamięć dla dynamicznej tablicy dwuwymiarowej o wymiarach
+ * @p [width][height] (patrz @ref init_arr_2D) i kopiuje do niej zawartość
+ * tablicy @p src o tych samych wymiarach.
+ * @param[in] a             – alokator kopii lub @p NULL,
+ * @param[out] data_ptr     – adres zmiennej, będącej wskaźnikiem na wskaźnik
+ *                            pewnego typu,
+ * @param[in] src           – kopiowana tablica dwuwymiarowa,
+ * @param[in] type          – rozmiar typu danych, który przechowuje tablica,
+ * @param[in] width, height – wymiary tablicy dwuwymiarowej (@p [width][height])
+ * @return Wartosć @p true, jeśli udało się zaalokować pamięć, @p false w
+ * w przeciwnym przypadku.
+ */
+bool copy_arr_2D(const gamma_allocator_t *a, void ***data_ptr, void **src,
+                 size_t type, uint64_t width, uint64_t height);
 
 /** @brief Alokuje pamięć dla tablicy jednowymiarowej.
  * Dokonuje alokacji pamięci dla dynamicznej tablicy o długosci
  * @p len, przechowującej dane typu o rozmiarze @p type, w miejscu
  * w pamięci wskazywanym przez @p data_ptr.
+ * @param[in] a          – alokator lub @p NULL,
  * @param[out] data_ptr  – adres zmiennej, będącej wskaźnikiem pewnego typu,
  * @param[in] type       – rozmiar typu danych, który ma przechowywać tablica,
  * @param[in] len        – długość tablicy.
  * @return Wartosć @p true, jeśli udało się zaalokować pamięć, @p false w
  * w przeciwnym przypadku.
  */
-bool init_array_1D(void **data_ptr, size_t type, uint64_t len);
+bool init_array_1D(const gamma_allocator_t *a, void **data_ptr, size_t type,
+                   uint64_t len);
 
 /** @brief Zwalnia pamięć zaalokowaną dla tablicy dwuwymiarowej.
- * Dla @p i należącego od @p 0 do @p width @p - @p 1, zwalnia pamięć
- * pod adresem @p arr[i] (Jeżeli @p arr[i] funkcja nic nie zmienia). 
- * Na koniec zwalnia pamięć zaalokowaną pod adresem
- * @p arr. Jeżeli @p arr jest równe @p NULL, funkcja nic nie robi.
- * @param[in,out] arr – dynamiczna tablica dwuwymiarowa,
- * @param[in] width   – ilość kolumn (pierwsza współrzędna) w tablicy.
- */
-void free_array(void **arr, uint64_t width);
+ * Zwalnia blok kolumn wskazywany przez @p arr[0], a na koniec pamięć
+ * zaalokowaną pod adresem @p arr. Jeżeli @p arr jest równe @p NULL, funkcja
+ * nic nie robi.
+ * @param[in] a         – alokator, którym zaalokowano tablicę, lub @p NULL,
+ * @param[in,out] arr   – dynamiczna tablica dwuwymiarowa,
+ * @param[in] type      – rozmiar typu danych, który przechowuje tablica,
+ * @param[in] width     – ilość kolumn (pierwsza współrzędna) w tablicy,
+ * @param[in] height    – ilość wierszy (druga współrzędna) w tablicy.
+ */
+void free_array(const gamma_allocator_t *a, void **arr, size_t type,
+                uint64_t width, uint64_t height);
 
 #endif //GAMMA_MEMORY_UTIL_H
@@ -0,0 +1,210 @@
+/** @file
+ * Pętle przeglądające planszę w wersji dla jednego rozmiaru komórki
+ * tablicy właścicieli pól.
+ * Plik celowo nie ma strażnika: gamma.c dołącza go raz dla każdego
+ * rozmiaru komórki, definiując wcześniej makra @p OWNER_T (typ komórki)
+ * i @p OWNER_BITS (liczba bitów komórki, dopisywana do nazw funkcji).
+ * Każde dołączenie tworzy funkcje @p count_neighbours_N,
+ * @p next_golden_candidate_N, @p board_rows_N, @p relabel_area_N
+ * i @p cut_search_area_N, które czytają komórki wprost, bez wybierania
+ * ich rozmiaru przy każdym dostępie.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#ifndef OWNER_FN
+/** @brief Dopisuje do nazwy funkcji liczbę bitów komórki. */
+#define OWNER_FN(name) OWNER_PASTE(name, OWNER_BITS)
+/** @brief Rozwija argumenty przed sklejeniem ich w @ref OWNER_GLUE. */
+#define OWNER_PASTE(name, bits) OWNER_GLUE(name, bits)
+/** @brief Skleja nazwę funkcji z liczbą bitów komórki. */
+#define OWNER_GLUE(name, bits) name##_##bits
+#endif
+
+/** @brief Liczy sąsiednie pola zajęte przez gracza.
+ * Wersja @ref count_neighbours dla komórek typu @p OWNER_T.
+ * @param[in] g      – wskaźnik na strukturę przechowującą stan gry,
+ *                     różny od @p NULL,
+ * @param[in] x      – numer kolumny, liczba nieujemna mniejsza od
+ *                     @p g->width,
+ * @param[in] y      – numer wiersza, liczba nieujemna mniejsza od
+ *                     @p g->height,
+ * @param[in] player – numer gracza.
+ * @return Liczba pól sąsiadujących z polem (@p x, @p y) zajętych przez
+ * gracza @p player.
+ */
+static int OWNER_FN(count_neighbours)(gamma_t *g, uint32_t x, uint32_t y,
+                                      uint32_t player) {
+    const OWNER_T *owners = g->owners;
+    int l = 0;
+    for (int i = 0; i < DIRECTIONS; ++i) {
+        uint32_t x_i = x + x_dir[i];
+        uint32_t y_i = y + y_dir[i];
+        if (!wrong_field(x_i, y_i, g)
+            && owners[(uint64_t) x_i * g->height + y_i] == player)
+            l++;
+    }
+    return l;
+}
+
+/** @brief Szuka następnego pola, na którym trzeba sprawdzić złoty ruch.
+ * Przegląda pola kolumnami, zaczynając od pola (@p *x, @p *y), i
+ * zatrzymuje się na pierwszym polu zajętym przez innego gracza niż
+ * @p player, które, gdy @p at_limit jest równe @p true, sąsiaduje
+ * z polem gracza @p player.
+ * @param[in] g        – wskaźnik na strukturę przechowującą stan gry,
+ *                       różny od @p NULL,
+ * @param[in] player   – numer gracza wykonującego złoty ruch,
+ * @param[in] at_limit – czy gracz ma już maksymalną liczbę obszarów,
+ * @param[in,out] x    – numer kolumny pola, od którego zaczyna się
+ *                       przeglądanie, a po powrocie kolumna znalezionego
+ *                       pola,
+ * @param[in,out] y    – numer wiersza pola, od którego zaczyna się
+ *                       przeglądanie (może być równy @p g->height), a po
+ *                       powrocie wiersz znalezionego pola.
+ * @return Wartość @p true, jeśli znaleziono pole, @p false, jeśli
+ * przejrzano całą resztę planszy.
+ */
+static bool OWNER_FN(next_golden_candidate)(gamma_t *g, uint32_t player,
+                                            bool at_limit, uint32_t *x,
+                                            uint32_t *y) {
+    const OWNER_T *owners = g->owners;
+    for (uint32_t i = *x, j = *y; i < g->width; i++, j = 0) {
+        const OWNER_T *column = owners + (uint64_t) i * g->height;
+        for (; j < g->height; j++) {
+            OWNER_T owner = column[j];
+            if (owner == NO_PLAYER || owner == player
+                || (at_limit && OWNER_FN(count_neighbours)(g, i, j, player) == 0))
+                continue;
+            *x = i;
+            *y = j;
+            return true;
+        }
+    }
+    return false;
+}
+
+/** @brief Zapisuje do bufora fragment planszy.
+ * Wersja @ref gamma_board_helper dla komórek typu @p OWNER_T.
+ * @param[in] g          – wskaźnik na strukturę reprezentującą stan gry,
+ *                         różny od @p NULL,
+ * @param[in] max_width  – szerokosć pola w napisowej reprezentacji planszy,
+ * @param[in] x0         – numer pierwszej kolumny fragmentu,
+ * @param[in] x1         – numer kolumny za ostatnią kolumną fragmentu,
+ * @param[in] y0         – numer pierwszego wiersza fragmentu,
+ * @param[in] y1         – numer wiersza za ostatnim wierszem fragmentu,
+ * @param[out] buffer    – bufor na napisową reprezentację fragmentu.
+ */
+static void OWNER_FN(board_rows)(gamma_t *g, uint32_t max_width, uint32_t x0,
+                                 uint32_t x1, uint32_t y0, uint32_t y1,
+                                 char *buffer) {
+    const OWNER_T *owners = g->owners;
+    uint64_t it = 0;
+    for (uint32_t i = g->height - y1; i < g->height - y0; ++i) {
+        uint32_t y = g->height - i - 1;
+        for (uint32_t j = x0; j < x1; ++j) {
+            uint64_t old_it = it;
+            OWNER_T owner = owners[(uint64_t) j * g->height + y];
+            if (owner == NO_PLAYER) {
+                buffer[it] = NO_PLAYER_CHAR;
+                it++;
+            } else {
+                it = write_int(buffer, it, owner);
+            }
+            while (it - old_it < max_width) {
+                buffer[it] = SPACE;
+                it++;
+            }
+        }
+        buffer[it] = '\n';
+        it++;
+    }
+    buffer[it] = '\0';
+}
+
+/** @brief Ustawia reprezentanta obszaru.
+ * Wersja @ref set_parent_dfs dla komórek typu @p OWNER_T.
+ * @param[in,out] g  – wskaźnik na strukturę reprezentującą stan gry,
+ *                     różny od @p NULL,
+ * @param[in] parent – pole, od którego zaczyna się przeszukiwanie i które
+ *                     zostanie reprezentantem obszaru,
+ * @param[in] p      – numer gracza, do którego należy obszar.
+ * @return Wielkość obszaru.
+ */
+static uint64_t OWNER_FN(relabel_area)(gamma_t *g, field_t parent, uint32_t p) {
+    const OWNER_T *owners = g->owners;
+    uint64_t count = 0;
+    stack_push(g->stack, parent.x, parent.y);
+    g->visited[parent.x][parent.y] = g->visit_epoch;
+    while (!is_stack_empty(g->stack)) {
+        STAT_ADD(g, dfs_cells, 1);
+        count++;
+        field_t f = stack_pop(g->stack);
+        g->parents[f.x][f.y] = parent;
+        for (int i = 0; i < DIRECTIONS; ++i) {
+            uint32_t x_i = f.x + x_dir[i];
+            uint32_t y_i = f.y + y_dir[i];
+            if (!wrong_field(x_i, y_i, g)
+                && g->visited[x_i][y_i] != g->visit_epoch
+                && owners[(uint64_t) x_i * g->height + y_i] == p) {
+                g->visited[x_i][y_i] = g->visit_epoch;
+                stack_push(g->stack, x_i, y_i);
+            }
+        }
+    }
+    return count;
+}
+
+/** @brief Przeszukuje obszar algorytmem Tarjana.
+ * Wersja @ref cut_search_area dla komórek typu @p OWNER_T.
+ * @param[in] g     – wskaźnik na strukturę reprezentującą stan gry,
+ *                    różny od @p NULL,
+ * @param[in,out] c – wskaźnik na stan przeszukiwania z zaalokowanymi
+ *                    tablicami,
+ * @param[in] root  – indeks zajętego, nieodwiedzonego pola obszaru.
+ */
+static void OWNER_FN(cut_search_area)(gamma_t *g, cut_search_t *c, uint64_t root) {
+    const OWNER_T *owners = g->owners;
+    OWNER_T owner = owners[(uint64_t) (root % g->width) * g->height + root / g->width];
+    uint64_t top = 0;
+    c->stack[top++] = root;
+    c->order[root] = c->low[root] = ++c->time;
+    c->parent_dir[root] = DIRECTIONS;
+    while (top > 0) {
+        uint64_t v = c->stack[top - 1];
+        uint32_t x = v % g->width;
+        uint32_t y = v / g->width;
+        if (c->next_dir[v] < DIRECTIONS) {
+            int d = c->next_dir[v]++;
+            uint32_t x_i = x + x_dir[d];
+            uint32_t y_i = y + y_dir[d];
+            if (wrong_field(x_i, y_i, g)
+                || owners[(uint64_t) x_i * g->height + y_i] != owner)
+                continue;
+            uint64_t w = (uint64_t) y_i * g->width + x_i;
+            if (c->order[w] == 0) {
+                c->order[w] = c->low[w] = ++c->time;
+                c->parent_dir[w] = (d + DIRECTIONS / 2) % DIRECTIONS;
+                c->stack[top++] = w;
+            } else if (d != c->parent_dir[v] && c->order[w] < c->low[v]) {
+                c->low[v] = c->order[w];
+            }
+            continue;
+        }
+        top--;
+        int d = c->parent_dir[v];
+        if (d == DIRECTIONS)
+            continue;
+        uint64_t u = (uint64_t) (y + y_dir[d]) * g->width + (x + x_dir[d]);
+        c->pieces[v]++;
+        if (c->low[v] < c->low[u])
+            c->low[u] = c->low[v];
+        if (c->low[v] >= c->order[u])
+            c->pieces[u]++;
+    }
+}
+
+#undef OWNER_T
+#undef OWNER_BITS
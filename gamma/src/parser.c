@@ -11,35 +11,92 @@
 #include "parser.h"
 #include "gamma.h"
 #include "interactive.h"
+#include "command.h"
+#include "batch_preparse.h"
+#include "binary_protocol.h"
+#include "game_map.h"
+#include "query_offload.h"
+#include "histogram.h"
+#include "trace.h"
+#include <signal.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
-#include <ctype.h>
-#include <errno.h>
+#include <time.h>
 
 #define GETLINE_FAILURE -1 /**< Stała zwracana przez @p getline,
                             * gdy nie uda się wczytać linii.
                             */
-#define IGNORE_LINE '#' /**< Znak oznaczający ignorowanie linii,
-                         * w której jest pierwszym znakiem.
-                         */
-#define M 'm' ///< Pierwszy znak w poleceniu wywołującym @ref gamma_move.
-#define G 'g' ///< Pierwszy znak w poleceniu wywołującym @ref gamma_golden_move.
-#define P 'p' ///< Pierwszy znak w poleceniu wywołującym @ref gamma_board.
-#define F 'f' ///< Pierwszy znak w poleceniu wywołującym @ref gamma_free_fields.
-#define Q 'q' ///< Pierwszy znak w poleceniu wywołującym @ref gamma_golden_possible.
-#define SMALL_B 'b' ///< Pierwszy znak w poleceniu wywołującym @ref gamma_busy_fields.
 #define B 'B' ///< Pierwszy znak w poleceniu rozpoczynającym tryb wsadowy.
 #define I 'I' ///< Pierwszy znak w poleceniu rozpoczynającym tryb interaktywny.
 #define ULL unsigned long long ///< Makro definiujące typ @p unsigned @p long @p long.
 #define DEAFULT_LINE_SIZE 2 ///< Początkowy rozmiar bufora.
-#define MAX_PARAMETER_COUNT 4 ///< Maksymalna liczba parametrów w poleceniu
-#define END_LINE '\n' ///< Znak nowej linii.
-#define CHAR_INCORRECT -1 /**< Zwracana przez @ref get_parameters_count_from_char,
-                           * gdy znak jest niepoprawnym pierwszym znakiem polecenia.
-                           */
+#define ERROR_LINE '\0' /**< Pierwszy znak zapisywany w kolejce wyników dla
+                         * wiersza, którego nie udało się rozebrać.
+                         */
+#define OUTPUT_QUEUE_SIZE 4096 /**< Maksymalna liczba wyników trybu wsadowego
+                                * czekających na wypisanie.
+                                */
+
+#define TIMED_COMMANDS 6 ///< Liczba rodzajów poleceń, których czas jest mierzony.
+
+/**
+ * @brief Pierwsze znaki poleceń, których czas jest mierzony, w kolejności
+ * wypisywania histogramów.
+ */
+static const char timed_commands[TIMED_COMMANDS] = {M, G, SMALL_B, F, Q, P};
+
+/**
+ * @brief Równe @p 1, jeśli od ostatniego wypisania histogramów nadszedł
+ * sygnał @p SIGUSR1.
+ */
+static volatile sig_atomic_t timing_dump_requested = 0;
+
+/**
+ * @brief Równe @p 1, jeśli od ostatniego zapisu śladu nadszedł sygnał
+ * @p SIGUSR2.
+ */
+static volatile sig_atomic_t trace_dump_requested = 0;
+
+/**
+ * @brief Struktura przechowująca wynik polecenia trybu wsadowego
+ * czekający na wypisanie.
+ */
+typedef struct pending_output {
+    char type;               ///< Pierwszy znak polecenia.
+    ULL line;                ///< Numer wiersza, w którym wystąpiło polecenie.
+    command_result_t result; /**< Wynik polecenia, jeśli @p job ma wartość
+                              * @p NULL.
+                              */
+    query_job_t *job;        ///< Zlecone zapytanie lub @p NULL.
+} pending_output_t;
+
+/**
+ * @brief Struktura przechowująca stan trybu wsadowego.
+ * Jeśli włączono asynchroniczne zapytania, kosztowne zapytania wykonywane są
+ * w puli wątków, a wyniki kolejnych poleceń czekają w kolejce cyklicznej, aż
+ * wszystkie wcześniejsze wyniki zostaną wypisane. Dzięki temu wyjście jest
+ * takie samo jak przy wykonywaniu poleceń po kolei.
+ */
+typedef struct batch {
+    gamma_t *g;              ///< Wskaźnik na strukturę przechowującą stan gry.
+    query_pool_t *pool;      /**< Pula wątków odpowiadających na zapytania lub
+                              * @p NULL, jeśli wszystkie polecenia wykonywane
+                              * są na bieżąco.
+                              */
+    pending_output_t *queue; ///< Kolejka wyników czekających na wypisanie.
+    size_t head;             ///< Indeks najstarszego wyniku w kolejce.
+    size_t count;            ///< Liczba wyników w kolejce.
+    histogram_t *timing;     /**< Histogramy czasów wykonania poleceń
+                              * kolejnych rodzajów z @ref timed_commands lub
+                              * @p NULL, jeśli czas nie jest mierzony.
+                              */
+    const char *trace_path;  /**< Plik, do którego zapisywany jest ślad
+                              * (patrz trace.h), lub @p NULL.
+                              */
+} batch_t;
 
 /**
  * @brief Wyświetla komunikat @p ERROR @p line.
@@ -60,69 +117,6 @@ static void show_ok_message(ULL line) {
     printf("OK %llu\n", line);
 }
 
-/**
- * @brief Sprawdza obecność niepoprawnych znaków.
- * Iteruje po znakach łańcucha znaków @p line zakończnonego
- * znakiem @ref END_LINE. Szuka, czy w łańcuchu występują znaki niebędące
- * białymi znakami lub cyframi.
- * @param line – łańcuch znaków zakończony znakiem @ref END_LINE.
- * @return Wartość @p true, jeśli wszystkie znaki w łańcuchu są poprawne
- * (tzn wszystkie znaki są białymi znakami lub cyframi), wartość
- * @p false w przeciwnym przypadku.
- */
-static bool check_for_broken_chars(char *line) {
-    int it = 0;
-    while (line[it] != END_LINE) {
-        if (!isdigit(line[it]) && !isspace(line[it]))
-            return false;
-        it++;
-    }
-    return true;
-}
-
-/**
- * @brief Wczytuje liczby, których zapis dziesiętny występuje w łańcuchu.
- * Odczytane liczby zapisuje w tablicy @p numbers.
- * Zakłada, że występuje dokładnie @p parameters_count liczb w łańcuchu i że
- * oddzielone są one białymi znakami. Pierwszy znak w łańcuchu musi być biały.
- * Liczby występujące w łańcuchu powinny być nieujemne i mieścić się w
- * zakresie zmiennej typu @p uint32_t.
- * @param[in] line              – łańcuch znaków zawierający zapis
- *                                dziesiętny liczb,
- * @param[in] parameters_count  – spodziewana liczba liczb w łańcuchu,
- * @param[out] numbers          – dynamiczna tablica, do której zapisywane będą
- *                                wczytane liczby, o rozmiarze niemniejszym niż
- *                                @p parameters_count.
- * @return Wartość @p true jeśli konwersja się udała i wszystkie założenia były
- * spełnione, wartość @p false w przeciwnym przypadku.
- */
-static bool read_numbers(char *line, int parameters_count, uint32_t *numbers) {
-    if (!isspace(line[0]))
-        return false;
-    if (!check_for_broken_chars(line))
-        return false;
-    char delimit[] = " \t\r\n\v\f";
-    char *token = NULL;
-    token = strtok(line, delimit);
-    int it = 0;
-    while (token != NULL) {
-        if (it > parameters_count - 1) {
-            return false;
-        } else {
-            errno = 0;
-            uint64_t wynik = strtoul(token, NULL, 10);
-            if (errno == ERANGE || wynik > UINT32_MAX)
-                return false;
-            numbers[it] = wynik;
-            it++;
-            token = strtok(NULL, delimit);
-        }
-    }
-    if (it != parameters_count)
-        return false;
-    return true;
-}
-
 /**
  * @brief Tworzy grę dla danych parametrów.
  * Wywołuje polecenie @ref gamma_new z parametrami przechowywanymi
@@ -131,37 +125,11 @@ static bool read_numbers(char *line, int parameters_count, uint32_t *numbers) {
  *                      niemniejszego niż 4.
  * @return Wynik polecenia @ref gamma_new dla podanych parametrów.
  */
-static gamma_t *create_gamma_from_numbers(uint32_t *numbers) {
+static gamma_t *create_gamma_from_numbers(const uint32_t *numbers) {
     gamma_t *g = gamma_new(numbers[0], numbers[1], numbers[2], numbers[3]);
     return g;
 }
 
-/**
- * @brief Znajduje liczbę parametrów dla danego pierwszego znaku polecenia.
- * Rozważa poprawne pierwsze znaki poleceń w trybie wsadowym (czyli znak 'B'
- * nie jest poprawnym pierwszym znakiem).
- * @param[in] c – pierwszy znak polecenia.
- * @return Liczba parametrów w poleceniu, którego pierwszym znakiem jest @p c,
- * jeżeli @p c jest pierwszym znakiem polecenia akceptowanego po przejściu w 
- * tryb wsadowy, wartość @ref CHAR_INCORRECT w przeciwnym przypadku.
- */
-static int get_parameters_count_from_char(char c) {
-    switch (c) {
-        case M:
-            return 3;
-        case G:
-            return 3;
-        case SMALL_B:
-        case F:
-        case Q:
-            return 1;
-        case P:
-            return 0;
-        default:
-            return CHAR_INCORRECT;
-    }
-}
-
 /**
  * @brief Wypisuje zmienną typu @p bool.
  * Jeżeli wartość zmiennej to @p true, wypisuje @p 1, w przeciwnym wypadku
@@ -182,58 +150,179 @@ static void print_uint64_t(uint64_t u) {
 }
 
 /**
- * @brief Wypisuje planszę.
- * Wywołuje @ref gamma_board na parametrze @p g i zapisuje wynik do zmiennej.
- * Jeśli wywołanie @p gamma_board zwróciło wartość @p NULL, wypisuje
- * komunikat o błędzie (@p ERROR @p line), w przeciwnym wypadku wypisuje
- * wynik @p gamma_board i zwalnia zaalokowaną pamięć.
- * @param[in] g          – wskaźnik na strukturę reprezentującą stan gry,
- * @param[in] line_count – numer linijki, w której wystąpiło polecenie,
- *                         wywołujące @p gamma_board (polecenie @p p w trybie
- *                         wsadowym).
+ * @brief Wypisuje wynik polecenia trybu wsadowego.
+ * Wypisuje odpowiedni napis na ekranie. Jeśli polecenie nie dało wyniku
+ * (np. nie udało się zaalokować pamięci dla napisu opisującego planszę),
+ * wypisuje komunikat o błędzie (@p ERROR @p line). Zwalnia napis opisujący
+ * planszę.
+ * @param[in] type        – pierwszy znak polecenia,
+ * @param[in] line_count  – numer linii, w której wystąpiło polecenie,
+ * @param[in] result      – wynik polecenia.
  */
-static void print_board(gamma_t *g, ULL line_count) {
-    char *s = gamma_board(g);
-    if (s == NULL) {
+static void print_result(char type, ULL line_count, const command_result_t *result) {
+    if (!result->ok) {
         show_error_message(line_count);
         return;
     }
-    printf("%s", s);
-    free(s);
+    switch (type) {
+        case M:
+        case G:
+        case Q:
+            print_bool(result->value);
+            break;
+        case SMALL_B:
+        case F:
+            print_uint64_t(result->value);
+            break;
+        case P:
+        case STATS:
+        case MEMORY:
+            printf("%s", result->board);
+            free(result->board);
+    }
 }
 
 /**
  * @brief Wykonuje polecenie w trybie wsadowym.
- * Wykonuje polecenie, którego pierwszym znakiem jest @p c, po którym
- * to znaku wystąpiły liczby opisane w tablicy @p num. Polecenie ma być
- * wykonane na grze, której stan reprezentuje struktura wskazywana przez @p g.
- * Wypisuje odpowiedni napis na ekranie.
- * @param[in] c           – pierwszy znak polecenia,
- * @param[in] num         – liczby występujące po znaku,
+ * Wykonuje polecenie @p cmd za pomocą funkcji @ref command_execute na grze,
+ * której stan reprezentuje struktura wskazywana przez @p g, i wypisuje jego
+ * wynik (patrz @ref print_result).
+ * @param[in] cmd         – polecenie o poprawnym pierwszym znaku,
  * @param[in,out] g       – wskaźnik na strukturę reprezentującą stan gry, różny
  *                          od @p NULL.
  * @param[in] line_count  – numer linii, w której wystąpiło polecenie.
  */
-static void deal_with_query(char c, uint32_t *num, gamma_t *g, ULL line_count) {
-    switch (c) {
-        case M:
-            print_bool(gamma_move(g, num[0], num[1], num[2]));
-            break;
-        case G:
-            print_bool(gamma_golden_move(g, num[0], num[1], num[2]));
-            break;
-        case SMALL_B:
-            print_uint64_t(gamma_busy_fields(g, num[0]));
-            break;
-        case F:
-            print_uint64_t(gamma_free_fields(g, num[0]));
-            break;
-        case Q:
-            print_bool(gamma_golden_possible(g, num[0]));
+static void deal_with_query(const command_t *cmd, gamma_t *g, ULL line_count) {
+    command_result_t result;
+    command_execute(g, cmd, &result);
+    print_result(cmd->type, line_count, &result);
+}
+
+/**
+ * @brief Zwraca bieżący czas w nanosekundach.
+ * @return Czas zegara monotonicznego w nanosekundach.
+ */
+static uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/**
+ * @brief Obsługuje sygnał @p SIGUSR1, zlecając wypisanie histogramów.
+ * @param[in] sig – numer sygnału.
+ */
+static void handle_timing_signal(int sig) {
+    (void) sig;
+    timing_dump_requested = 1;
+}
+
+/**
+ * @brief Obsługuje sygnał @p SIGUSR2, zlecając zapis śladu.
+ * @param[in] sig – numer sygnału.
+ */
+static void handle_trace_signal(int sig) {
+    (void) sig;
+    trace_dump_requested = 1;
+}
+
+/**
+ * @brief Zapisuje ślad trybu wsadowego do pliku.
+ * Jeśli się nie udało, wypisuje komunikat na @p stderr.
+ * @param[in] b – wskaźnik na stan trybu wsadowego z ustawionym plikiem
+ *                śladu.
+ */
+static void trace_write(const batch_t *b) {
+    if (!trace_dump(b->trace_path))
+        perror(b->trace_path);
+}
+
+/**
+ * @brief Zapisuje czas wykonania polecenia w histogramie jego rodzaju.
+ * @param[in,out] b – wskaźnik na stan trybu wsadowego z włączonym pomiarem
+ *                    czasu,
+ * @param[in] type  – pierwszy znak polecenia,
+ * @param[in] ns    – czas wykonania polecenia w nanosekundach.
+ */
+static void timing_record(batch_t *b, char type, uint64_t ns) {
+    for (int i = 0; i < TIMED_COMMANDS; i++) {
+        if (timed_commands[i] == type) {
+            histogram_record(&b->timing[i], ns);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Wypisuje na @p stderr percentyle czasów wykonania poleceń.
+ * @param[in] b – wskaźnik na stan trybu wsadowego z włączonym pomiarem
+ *                czasu.
+ */
+static void timing_print(const batch_t *b) {
+    fprintf(stderr, "# command latency [ns]\n");
+    for (int i = 0; i < TIMED_COMMANDS; i++) {
+        char name[2] = {timed_commands[i], '\0'};
+        histogram_print(&b->timing[i], name, stderr);
+    }
+}
+
+/**
+ * @brief Wypisuje najstarszy wynik z kolejki trybu wsadowego i usuwa go
+ * z kolejki.
+ * Jeśli wynik jest wynikiem zleconego zapytania, najpierw czeka na jego
+ * wykonanie.
+ * @param[in,out] b – wskaźnik na stan trybu wsadowego z niepustą kolejką.
+ */
+static void output_pop(batch_t *b) {
+    pending_output_t *out = &b->queue[b->head];
+    if (out->job != NULL)
+        query_job_wait(b->pool, out->job, &out->result);
+    print_result(out->type, out->line, &out->result);
+    b->head = (b->head + 1) % OUTPUT_QUEUE_SIZE;
+    b->count--;
+}
+
+/**
+ * @brief Wypisuje wyniki z początku kolejki trybu wsadowego.
+ * @param[in,out] b – wskaźnik na stan trybu wsadowego,
+ * @param[in] all   – równe @p true, jeśli należy wypisać wszystkie wyniki,
+ *                    czekając na wykonanie zleconych zapytań, @p false,
+ *                    jeśli należy zatrzymać się na pierwszym niegotowym
+ *                    wyniku.
+ */
+static void output_flush(batch_t *b, bool all) {
+    while (b->count > 0) {
+        query_job_t *job = b->queue[b->head].job;
+        if (!all && job != NULL && !query_job_done(job))
             break;
-        case P:
-            print_board(g, line_count);
+        output_pop(b);
+    }
+}
+
+/**
+ * @brief Wypisuje wynik polecenia trybu wsadowego lub dodaje go do kolejki.
+ * Wynik jest wypisywany od razu, jeśli jest gotowy, a kolejka jest pusta.
+ * Jeśli kolejka jest pełna, najpierw wypisuje najstarszy wynik.
+ * @param[in,out] b   – wskaźnik na stan trybu wsadowego,
+ * @param[in] type    – pierwszy znak polecenia,
+ * @param[in] line    – numer wiersza, w którym wystąpiło polecenie,
+ * @param[in] result  – wynik polecenia, jeśli @p job ma wartość @p NULL,
+ * @param[in] job     – zlecone zapytanie lub @p NULL.
+ */
+static void output_push(batch_t *b, char type, ULL line,
+                        const command_result_t *result, query_job_t *job) {
+    if (b->count == 0 && job == NULL) {
+        print_result(type, line, result);
+        return;
     }
+    if (b->count == OUTPUT_QUEUE_SIZE)
+        output_pop(b);
+    pending_output_t *out = &b->queue[(b->head + b->count) % OUTPUT_QUEUE_SIZE];
+    out->type = type;
+    out->line = line;
+    out->result = *result;
+    out->job = job;
+    b->count++;
 }
 
 /**
@@ -259,6 +348,155 @@ static gamma_t *create_gamma_from_line(char *line, uint32_t *numbers) {
     return g;
 }
 
+/**
+ * @brief Wykonuje rozebrany wiersz wejścia w trybie wsadowym.
+ * Jeśli wiersz jest poprawnym poleceniem, wykonuje je, w przeciwnym
+ * przypadku wypisuje komunikat o błędzie. Jeśli włączono asynchroniczne
+ * zapytania, kosztowne zapytania (patrz @ref query_pool_worth_offloading)
+ * zlecane są puli wątków, a wynik trafia do kolejki. Jeśli włączono pomiar
+ * czasu, zapisuje czas wykonania polecenia (dla zleconych zapytań czas
+ * zlecenia) w histogramie. Wykonanie polecenia i wypisanie wyników
+ * mierzone są jako przedziały śladu (patrz trace.h). Zignorowanych wierszy
+ * nie wolno przekazywać do tej funkcji.
+ * @param[in] status      – wynik rozbioru wiersza, różny od @ref LINE_IGNORE,
+ * @param[in] cmd         – rozebrane polecenie,
+ * @param[in,out] b       – wskaźnik na stan trybu wsadowego,
+ * @param[in] line_count  – numer wiersza.
+ */
+static void execute_line(line_status_t status, const command_t *cmd,
+                         batch_t *b, ULL line_count) {
+    command_result_t result = {false, 0, NULL};
+    query_job_t *job = NULL;
+    if (status != LINE_OK) {
+        output_push(b, ERROR_LINE, line_count, &result, NULL);
+        return;
+    }
+    uint64_t start = b->timing != NULL ? now_ns() : 0;
+    TRACE_BEGIN(execute_span);
+    if (b->pool != NULL && query_pool_worth_offloading(b->g, cmd))
+        job = query_pool_submit(b->pool, b->g, cmd);
+    if (job == NULL) {
+        command_execute(b->g, cmd, &result);
+        if (b->pool != NULL && (cmd->type == M || cmd->type == G)
+            && result.ok && result.value)
+            query_pool_state_changed(b->pool);
+    }
+    TRACE_END(execute_span, "execute", line_count);
+    if (b->timing != NULL) {
+        timing_record(b, cmd->type, now_ns() - start);
+        if (timing_dump_requested) {
+            timing_dump_requested = 0;
+            timing_print(b);
+        }
+    }
+    if (trace_dump_requested && b->trace_path != NULL) {
+        trace_dump_requested = 0;
+        trace_write(b);
+    }
+    TRACE_BEGIN(output_span);
+    output_push(b, cmd->type, line_count, &result, job);
+    if (b->count > 0)
+        output_flush(b, false);
+    TRACE_END(output_span, "output", line_count);
+}
+
+/**
+ * @brief Wczytuje i wykonuje kolejne polecenia trybu wsadowego ze
+ * standardowego wejścia, wiersz po wierszu.
+ * Kończy działanie, gdy skończy się strumień wejściowy.
+ * @param[in,out] b        – wskaźnik na stan trybu wsadowego,
+ * @param[in,out] line_ptr – wskaźnik na bufor, do którego wczytywane są wiersze,
+ * @param[in] line_count   – numer pierwszego wczytywanego wiersza.
+ */
+static void tryb_wsadowy_sequential(batch_t *b, char **line_ptr, ULL line_count) {
+    bool czy_koniec_programu = false;
+    size_t rozmiar = DEAFULT_LINE_SIZE;
+    command_t cmd;
+    while (!czy_koniec_programu) {
+        ssize_t len = getline(line_ptr, &rozmiar, stdin);
+        if (len == GETLINE_FAILURE) {
+            czy_koniec_programu = true;
+        } else {
+            TRACE_BEGIN(span);
+            line_status_t status = command_parse_line(*line_ptr, len, &cmd);
+            TRACE_END(span, "parse", line_count);
+            if (status != LINE_IGNORE)
+                execute_line(status, &cmd, b, line_count);
+            line_count++;
+        }
+    }
+}
+
+/**
+ * @brief Wykonuje polecenia trybu wsadowego rozbierane równolegle.
+ * Jeśli standardowe wejście jest zwykłym plikiem, rozbiera jego pozostałą
+ * część równolegle (patrz @ref preparse_start) i wykonuje rozebrane
+ * polecenia w kolejności występowania w pliku.
+ * @param[in,out] b       – wskaźnik na stan trybu wsadowego,
+ * @param[in] line_count  – numer pierwszego nierozebranego wiersza,
+ * @param[in] options     – opcje trybu wsadowego.
+ * @return Wartość @p false, jeśli nie udało się rozpocząć równoległego
+ * rozbioru (wejście nie zostało wtedy zmienione), wartość @p true, jeśli
+ * wszystkie polecenia zostały wykonane.
+ */
+static bool tryb_wsadowy_parallel(batch_t *b, ULL line_count,
+                                  const parser_options_t *options) {
+    long offset = ftell(stdin);
+    if (offset < 0)
+        return false;
+    preparse_t *p = preparse_start(fileno(stdin), offset, options->parse_threads);
+    if (p == NULL)
+        return false;
+    const parsed_chunk_t *chunk;
+    while ((chunk = preparse_next(p)) != NULL) {
+        for (uint64_t i = 0; i < chunk->count; i++) {
+            const parsed_line_t *l = &chunk->lines[i];
+            execute_line(l->status, &l->cmd, b, line_count + l->line);
+        }
+        line_count += chunk->line_count;
+    }
+    preparse_finish(p);
+    return true;
+}
+
+/**
+ * @brief Włącza pomiar czasu wykonania poleceń trybu wsadowego.
+ * Tworzy histogramy i ustawia obsługę sygnału @p SIGUSR1, po którym
+ * histogramy są wypisywane przy wykonaniu następnego polecenia. Jeśli nie
+ * udało się zaalokować pamięci, czas nie jest mierzony.
+ * @param[in,out] b – wskaźnik na stan trybu wsadowego.
+ */
+static void timing_start(batch_t *b) {
+    b->timing = malloc(TIMED_COMMANDS * sizeof(histogram_t));
+    if (b->timing == NULL)
+        return;
+    for (int i = 0; i < TIMED_COMMANDS; i++)
+        histogram_init(&b->timing[i]);
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = handle_timing_signal;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGUSR1, &sa, NULL);
+}
+
+/**
+ * @brief Włącza zapis śladu trybu wsadowego.
+ * Ustawia obsługę sygnału @p SIGUSR2, po którym ślad jest zapisywany przy
+ * wykonaniu następnego polecenia.
+ * @param[in,out] b  – wskaźnik na stan trybu wsadowego,
+ * @param[in] path   – plik, do którego zapisywany jest ślad.
+ */
+static void trace_start(batch_t *b, const char *path) {
+    b->trace_path = path;
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = handle_trace_signal;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGUSR2, &sa, NULL);
+}
+
 /**
  * @brief Przeprowadza tryb wsadowy.
  * Zakłada, że bufor wskazywany przez @p line_ptr ma pierwszy
@@ -273,49 +511,169 @@ static gamma_t *create_gamma_from_line(char *line, uint32_t *numbers) {
  * wypisuje odpowiednie napisy na wyjściu.
  * Gdy skończy się strumień wejściowy funkcja wywołuje
  * funkcję @ref gamma_delete na zmiennej wskazującej na strukturę gry i zwraca
- * @p true.
+ * @p true. Jeśli w @p options włączono równoległy rozbiór, a wejście jest
+ * zwykłym plikiem, polecenia rozbierane są równolegle
+ * (patrz @ref tryb_wsadowy_parallel). Jeśli w @p options włączono
+ * asynchroniczne zapytania, kosztowne zapytania wykonywane są w puli wątków
+ * (patrz query_offload.h), a wyniki wypisywane w kolejności poleceń.
+ * Jeśli włączono pomiar czasu, po zakończeniu wejścia wypisuje na
+ * @p stderr percentyle czasów wykonania poleceń każdego rodzaju. Jeśli
+ * podano plik śladu, po zakończeniu wejścia i po sygnale @p SIGUSR2 zapisuje
+ * w nim ślad (patrz trace.h).
  * @param[in,out] line_ptr   – wskaźnik na bufor przechowujący wczytane polecenie,
  *                             mające powodować przejście do trybu wsadowego;
  *                             bufor powinien mieć pierwszy znak równy @ref B
  *                             i być zakończony znakiem nowej linii.
  * @param[in] line_count     – numer wiersza, w którym wystąpiło polecenie
- *                             @p line.
+ *                             @p line,
+ * @param[in] options        – opcje trybu wsadowego.
  * @return Wartość @p false, jeśli nie udało się przejść do trybu wsadowego,
  * wartość @p true w przeciwnym przypadku.
  */
-static bool tryb_wsadowy(char **line_ptr, ULL line_count) {
+static bool tryb_wsadowy(char **line_ptr, ULL line_count,
+                         const parser_options_t *options) {
     uint32_t numbers[MAX_PARAMETER_COUNT];
     gamma_t *g = create_gamma_from_line(&(*line_ptr)[1], numbers);
     if (g == NULL)
         return false;
     show_ok_message(line_count);
-    bool czy_koniec_programu = false;
     line_count++;
-    size_t rozmiar = DEAFULT_LINE_SIZE;
-    while (!czy_koniec_programu) {
-        ssize_t len = getline(line_ptr, &rozmiar, stdin);
-        if (len == GETLINE_FAILURE) {
-            czy_koniec_programu = true;
-        } else {
-            bool good_line = true, ignore = false;
-            char c = (*line_ptr)[0];
-            if (c == IGNORE_LINE || c == END_LINE) {
-                good_line = false;
-                ignore = true;
-            }
-            if (good_line && (*line_ptr)[len - 1] != END_LINE)
-                good_line = false;
-            int param_count = get_parameters_count_from_char(c);
-            if (good_line && param_count == CHAR_INCORRECT)
-                good_line = false;
-            if (good_line && read_numbers(&(*line_ptr)[1], param_count, numbers))
-                deal_with_query(c, numbers, g, line_count);
-            else good_line = false;
-            if (!good_line && !ignore)
-                show_error_message(line_count);
-            line_count++;
+    batch_t b = {g, NULL, NULL, 0, 0, NULL, NULL};
+    if (options->async_queries) {
+        b.queue = malloc(OUTPUT_QUEUE_SIZE * sizeof(pending_output_t));
+        if (b.queue != NULL)
+            b.pool = query_pool_new(options->query_threads);
+    }
+    if (options->command_timing)
+        timing_start(&b);
+    if (options->trace_path != NULL)
+        trace_start(&b, options->trace_path);
+    if (!options->parallel_parse || !tryb_wsadowy_parallel(&b, line_count, options))
+        tryb_wsadowy_sequential(&b, line_ptr, line_count);
+    output_flush(&b, true);
+    if (b.timing != NULL) {
+        fflush(stdout);
+        timing_print(&b);
+        free(b.timing);
+    }
+    query_pool_delete(b.pool);
+    if (b.trace_path != NULL)
+        trace_write(&b);
+    trace_free();
+    free(b.queue);
+    gamma_delete(g);
+    return true;
+}
+
+/**
+ * @brief Wykonuje rozebrany wiersz wejścia w trybie wielu gier.
+ * Polecenie @ref NEW_GAME tworzy grę o nowym identyfikatorze, a polecenie
+ * @ref DELETE_GAME usuwa grę i zwalnia jej pamięć; po powodzeniu obu
+ * wypisywany jest komunikat @p OK @p line. Pozostałe polecenia wykonywane
+ * są na grze o podanym identyfikatorze tak jak w trybie wsadowym.
+ * Komunikat o błędzie wypisywany jest dla niepoprawnych wierszy, poleceń
+ * dotyczących nieistniejących gier i prób utworzenia gry o zajętym
+ * identyfikatorze. Zignorowanych wierszy nie wolno przekazywać do tej
+ * funkcji.
+ * @param[in] status      – wynik rozbioru wiersza, różny od @ref LINE_IGNORE,
+ * @param[in] mc          – rozebrane polecenie,
+ * @param[in,out] games   – wskaźnik na słownik gier, różny od @p NULL,
+ * @param[in] line_count  – numer wiersza.
+ */
+static void execute_multi_line(line_status_t status, const multi_command_t *mc,
+                               game_map_t *games, ULL line_count) {
+    gamma_t *g = NULL;
+    bool ok = false;
+    if (status == LINE_OK) {
+        switch (mc->cmd.type) {
+            case NEW_GAME:
+                if (game_map_get(games, mc->game) == NULL)
+                    g = create_gamma_from_numbers(mc->cmd.params);
+                ok = g != NULL && game_map_insert(games, mc->game, g);
+                if (!ok)
+                    gamma_delete(g);
+                break;
+            case DELETE_GAME:
+                g = game_map_remove(games, mc->game);
+                ok = g != NULL;
+                gamma_delete(g);
+                break;
+            default:
+                g = game_map_get(games, mc->game);
+                if (g != NULL) {
+                    deal_with_query(&mc->cmd, g, line_count);
+                    return;
+                }
         }
     }
+    if (ok)
+        show_ok_message(line_count);
+    else
+        show_error_message(line_count);
+}
+
+/**
+ * @brief Przeprowadza tryb wielu gier.
+ * Zakłada, że wiersz wskazywany przez @p line_ptr, o długości @p len, ma
+ * pierwszy znak równy @ref NEW_GAME. Wykonuje zapisane w nim polecenie
+ * utworzenia gry; jeśli się nie udało, zwraca wartość @p false.
+ * W przeciwnym przypadku wczytuje i wykonuje kolejne wiersze (patrz
+ * @ref execute_multi_line) do końca strumienia wejściowego, po czym usuwa
+ * wszystkie pozostałe gry.
+ * @param[in,out] line_ptr – wskaźnik na bufor przechowujący wczytany wiersz,
+ * @param[in] len          – długość wiersza,
+ * @param[in] line_count   – numer wiersza.
+ * @return Wartość @p false, jeśli nie udało się przejść do trybu wielu gier,
+ * wartość @p true w przeciwnym przypadku.
+ */
+static bool tryb_wielu_gier(char **line_ptr, ssize_t len, ULL line_count) {
+    multi_command_t mc;
+    game_map_t *games = game_map_new();
+    if (games == NULL || command_parse_multi_line(*line_ptr, len, &mc) != LINE_OK) {
+        game_map_delete(games);
+        return false;
+    }
+    gamma_t *g = create_gamma_from_numbers(mc.cmd.params);
+    if (g == NULL || !game_map_insert(games, mc.game, g)) {
+        gamma_delete(g);
+        game_map_delete(games);
+        return false;
+    }
+    show_ok_message(line_count);
+    line_count++;
+
+    size_t rozmiar = DEAFULT_LINE_SIZE;
+    while ((len = getline(line_ptr, &rozmiar, stdin)) != GETLINE_FAILURE) {
+        line_status_t status = command_parse_multi_line(*line_ptr, len, &mc);
+        if (status != LINE_IGNORE)
+            execute_multi_line(status, &mc, games, line_count);
+        line_count++;
+    }
+    game_map_delete(games);
+    return true;
+}
+
+/**
+ * @brief Przeprowadza tryb binarny.
+ * Zakłada, że bufor wskazywany przez @p line_ptr ma pierwszy
+ * znak równy @ref BINARY_MODE i jest zakończony znakiem nowej linii.
+ * Tworzy grę opisaną poleceniem wskazywanym przez @p line_ptr
+ * występującym w liniii numer @p line_count. Jeżeli nie udało się tego
+ * zrobić, zwraca wartość @p false. W przeciwnym wypadku wypisuje komunikat
+ * @p OK @p line i przeprowadza tryb binarny (patrz @ref binary_mode).
+ * @param[in] line_ptr   – wskaźnik na bufor przechowujący wczytane polecenie,
+ * @param[in] line_count – numer wiersza, w którym wystąpiło polecenie.
+ * @return Wartość @p false, jeśli nie udało się przejść do trybu binarnego,
+ * wartość @p true w przeciwnym przypadku.
+ */
+static bool tryb_binarny(char **line_ptr, ULL line_count) {
+    uint32_t numbers[MAX_PARAMETER_COUNT];
+    gamma_t *g = create_gamma_from_line(&(*line_ptr)[1], numbers);
+    if (g == NULL)
+        return false;
+    show_ok_message(line_count);
+    fflush(stdout);
+    binary_mode(g, stdin, stdout);
     gamma_delete(g);
     return true;
 }
@@ -350,7 +708,7 @@ static bool tryb_interaktywny(char **line_ptr) {
     return true;
 }
 
-void read_input() {
+void read_input(const parser_options_t *options) {
     bool czy_wybrany_tryb = false;
     char *line = NULL;
     size_t rozmiar = 0;
@@ -370,9 +728,13 @@ void read_input() {
         if (good_line && line[len - 1] != END_LINE)
             good_line = false;
         if (good_line && c == B)
-            czy_wybrany_tryb = tryb_wsadowy(&line, line_count);
+            czy_wybrany_tryb = tryb_wsadowy(&line, line_count, options);
         if (good_line && c == I)
             czy_wybrany_tryb = tryb_interaktywny(&line);
+        if (good_line && c == BINARY_MODE)
+            czy_wybrany_tryb = tryb_binarny(&line, line_count);
+        if (good_line && c == NEW_GAME)
+            czy_wybrany_tryb = tryb_wielu_gier(&line, len, line_count);
         if ((!good_line || !czy_wybrany_tryb) && !ignore)
             show_error_message(line_count);
         line_count++;
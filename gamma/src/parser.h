@@ -11,9 +11,41 @@
 #ifndef GAMMA_PARSER_H
 #define GAMMA_PARSER_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Opcje wczytywania wejścia, ustawiane z linii poleceń.
+ */
+typedef struct parser_options {
+    bool parallel_parse;    /**< Równe @p true, jeśli polecenia trybu
+                             * wsadowego wczytywane ze zwykłego pliku mają być
+                             * rozbierane równolegle.
+                             */
+    uint32_t parse_threads; /**< Liczba wątków rozbierających polecenia,
+                             * wartość @p 0 oznacza wszystkie dostępne rdzenie.
+                             */
+    bool async_queries;     /**< Równe @p true, jeśli kosztowne zapytania
+                             * trybu wsadowego mają być wykonywane w puli
+                             * wątków na kopiach stanu gry.
+                             */
+    uint32_t query_threads; /**< Liczba wątków odpowiadających na zapytania,
+                             * wartość @p 0 oznacza wszystkie dostępne rdzenie.
+                             */
+    bool command_timing;    /**< Równe @p true, jeśli czas wykonania poleceń
+                             * trybu wsadowego ma być mierzony i wypisywany
+                             * na końcu wejścia oraz po sygnale @p SIGUSR1.
+                             */
+    const char *trace_path; /**< Plik, do którego na końcu wejścia trybu
+                             * wsadowego oraz po sygnale @p SIGUSR2 zapisywany
+                             * jest ślad (patrz trace.h), lub @p NULL.
+                             */
+} parser_options_t;
+
 /**
- * Główna metoda wczytująca i interpretująca wejście.
+ * @brief Główna metoda wczytująca i interpretująca wejście.
+ * @param[in] options – wskaźnik na opcje wczytywania, różny od @p NULL.
  */
-void read_input();
+void read_input(const parser_options_t *options);
 
 #endif //GAMMA_PARSER_H
@@ -0,0 +1,79 @@
+/** @file
+ * Zawiera implementację interfejsu perf_counters.h
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#define _GNU_SOURCE ///< Makro potrzebne do prawidłowej kompilacji.
+
+#include "perf_counters.h"
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * @brief Konfiguracje kolejnych liczników.
+ */
+static const struct {
+    const char *name; ///< Nazwa licznika.
+    uint64_t config;  ///< Zdarzenie typu @p PERF_TYPE_HARDWARE.
+} events[PERF_COUNTERS] = {
+    {"cycles", PERF_COUNT_HW_CPU_CYCLES},
+    {"instructions", PERF_COUNT_HW_INSTRUCTIONS},
+    {"cache_misses", PERF_COUNT_HW_CACHE_MISSES},
+    {"branch_misses", PERF_COUNT_HW_BRANCH_MISSES}
+};
+
+const char *perf_counter_name(int i) {
+    return events[i].name;
+}
+
+/**
+ * @brief Otwiera jeden licznik.
+ * @param[in] config   – zdarzenie typu @p PERF_TYPE_HARDWARE,
+ * @param[in] group_fd – deskryptor lidera grupy lub @p -1 dla lidera.
+ * @return Deskryptor licznika lub @p -1, jeśli się nie udało.
+ */
+static int open_counter(uint64_t config, int group_fd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = group_fd == -1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+bool perf_counters_open(perf_counters_t *pc) {
+    for (int i = 0; i < PERF_COUNTERS; i++) {
+        pc->fd[i] = open_counter(events[i].config, i == 0 ? -1 : pc->fd[0]);
+        if (pc->fd[i] < 0) {
+            while (i-- > 0)
+                close(pc->fd[i]);
+            return false;
+        }
+    }
+    ioctl(pc->fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(pc->fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+}
+
+bool perf_counters_read(const perf_counters_t *pc, uint64_t *values) {
+    uint64_t buf[1 + PERF_COUNTERS];
+    if (read(pc->fd[0], buf, sizeof(buf)) != sizeof(buf) || buf[0] != PERF_COUNTERS)
+        return false;
+    memcpy(values, &buf[1], PERF_COUNTERS * sizeof(uint64_t));
+    return true;
+}
+
+void perf_counters_close(perf_counters_t *pc) {
+    for (int i = 0; i < PERF_COUNTERS; i++)
+        close(pc->fd[i]);
+}
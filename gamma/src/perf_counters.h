@@ -0,0 +1,64 @@
+/** @file
+ * Interfejs odczytu sprzętowych liczników wydajności procesora.
+ *
+ * Liczniki (cykle, instrukcje, chybienia w pamięci podręcznej i błędne
+ * przewidywania skoków) otwierane są przez @p perf_event_open jako jedna
+ * grupa, zliczająca tylko w przestrzeni użytkownika bieżącego wątku, i
+ * odczytywane jednym wywołaniem @p read. Jeśli jądro nie pozwala na dostęp
+ * do liczników, otwarcie się nie udaje, a korzystający z nich program może
+ * ograniczyć się do pomiaru czasu.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#ifndef GAMMA_PERF_COUNTERS_H
+#define GAMMA_PERF_COUNTERS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define PERF_COUNTERS 4 ///< Liczba odczytywanych liczników.
+
+/**
+ * @brief Struktura przechowująca otwartą grupę liczników.
+ */
+typedef struct perf_counters {
+    int fd[PERF_COUNTERS]; ///< Deskryptory liczników, pierwszy to lider grupy.
+} perf_counters_t;
+
+/**
+ * @brief Zwraca nazwę licznika.
+ * @param[in] i – numer licznika, mniejszy niż @ref PERF_COUNTERS.
+ * @return Nazwa licznika.
+ */
+const char *perf_counter_name(int i);
+
+/**
+ * @brief Otwiera i włącza grupę liczników.
+ * @param[out] pc – wskaźnik na strukturę, w której zostaną zapisane
+ *                  deskryptory liczników.
+ * @return Wartość @p true, jeśli udało się otworzyć wszystkie liczniki,
+ * @p false w przeciwnym przypadku (wtedy @p errno opisuje błąd, a żaden
+ * licznik nie pozostaje otwarty).
+ */
+bool perf_counters_open(perf_counters_t *pc);
+
+/**
+ * @brief Odczytuje bieżące wartości liczników.
+ * @param[in] pc      – wskaźnik na otwartą grupę liczników,
+ * @param[out] values – tablica, do której zostaną zapisane wartości
+ *                      liczników, o rozmiarze @ref PERF_COUNTERS.
+ * @return Wartość @p true, jeśli odczyt się udał, @p false w przeciwnym
+ * przypadku.
+ */
+bool perf_counters_read(const perf_counters_t *pc, uint64_t *values);
+
+/**
+ * @brief Zamyka grupę liczników.
+ * @param[in,out] pc – wskaźnik na otwartą grupę liczników.
+ */
+void perf_counters_close(perf_counters_t *pc);
+
+#endif //GAMMA_PERF_COUNTERS_H
@@ -0,0 +1,225 @@
+/** @file
+ * Zawiera implementację interfejsu query_offload.h
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#define _GNU_SOURCE ///< Makro potrzebne do prawidłowej kompilacji.
+
+#include "query_offload.h"
+#include "trace.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * @brief Struktura przechowująca migawkę stanu gry.
+ */
+typedef struct snapshot {
+    gamma_t *g;           ///< Kopia stanu gry.
+    pthread_mutex_t lock; ///< Blokada szeregująca zapytania na migawce.
+    uint32_t refs;        /**< Liczba odwołań do migawki (zleconych zapytań
+                           * i bieżącej migawki puli), chroniona blokadą
+                           * puli.
+                           */
+} snapshot_t;
+
+/**
+ * @brief Struktura przechowująca zlecone zapytanie.
+ */
+struct query_job {
+    command_t cmd;           ///< Zapytanie.
+    snapshot_t *s;           ///< Migawka, na której wykonywane jest zapytanie.
+    command_result_t result; ///< Wynik zapytania.
+    atomic_bool done;        ///< Równe @p true, gdy wynik jest gotowy.
+    struct query_job *next;  ///< Następne zapytanie w kolejce.
+};
+
+/**
+ * @brief Struktura przechowująca stan puli wątków.
+ */
+struct query_pool {
+    pthread_t *threads;    ///< Tablica wątków.
+    uint32_t count;        ///< Liczba wątków.
+    pthread_mutex_t mutex; ///< Blokada chroniąca kolejkę i liczniki odwołań.
+    pthread_cond_t work;   ///< Zmienna warunkowa sygnalizująca nowe zapytanie.
+    pthread_cond_t done;   ///< Zmienna warunkowa sygnalizująca wykonanie zapytania.
+    query_job_t *head;     ///< Najstarsze niepobrane zapytanie.
+    query_job_t *tail;     ///< Najmłodsze niepobrane zapytanie.
+    snapshot_t *current;   ///< Migawka bieżącego stanu gry lub @p NULL.
+    bool stop;             ///< Równe @p true, gdy wątki mają zakończyć pracę.
+};
+
+/**
+ * @brief Zwalnia odwołanie do migawki, a po zwolnieniu ostatniego
+ * usuwa migawkę.
+ * @param[in,out] p – pula,
+ * @param[in] s     – migawka.
+ */
+static void snapshot_release(query_pool_t *p, snapshot_t *s) {
+    pthread_mutex_lock(&p->mutex);
+    bool last = --s->refs == 0;
+    pthread_mutex_unlock(&p->mutex);
+    if (last) {
+        gamma_delete(s->g);
+        pthread_mutex_destroy(&s->lock);
+        free(s);
+    }
+}
+
+/**
+ * @brief Główna pętla wątku puli.
+ * @param[in] arg – wskaźnik na pulę.
+ * @return Wartość @p NULL.
+ */
+static void *worker_main(void *arg) {
+    query_pool_t *p = arg;
+    pthread_mutex_lock(&p->mutex);
+    while (true) {
+        while (p->head == NULL && !p->stop)
+            pthread_cond_wait(&p->work, &p->mutex);
+        if (p->head == NULL)
+            break;
+        query_job_t *job = p->head;
+        p->head = job->next;
+        pthread_mutex_unlock(&p->mutex);
+
+        pthread_mutex_lock(&job->s->lock);
+        TRACE_BEGIN(span);
+        command_execute(job->s->g, &job->cmd, &job->result);
+        TRACE_END(span, "query", (uint64_t) job->cmd.type);
+        pthread_mutex_unlock(&job->s->lock);
+        snapshot_release(p, job->s);
+
+        pthread_mutex_lock(&p->mutex);
+        atomic_store(&job->done, true);
+        pthread_cond_broadcast(&p->done);
+    }
+    pthread_mutex_unlock(&p->mutex);
+    return NULL;
+}
+
+/**
+ * @brief Zwraca liczbę dostępnych rdzeni.
+ * @return Liczba dostępnych rdzeni, co najmniej @p 1.
+ */
+static uint32_t available_cores() {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores > 0 ? cores : 1;
+}
+
+query_pool_t *query_pool_new(uint32_t threads) {
+    if (threads == 0)
+        threads = available_cores();
+    query_pool_t *p = calloc(1, sizeof(query_pool_t));
+    if (p == NULL)
+        return NULL;
+    p->threads = malloc(threads * sizeof(pthread_t));
+    if (p->threads == NULL) {
+        free(p);
+        return NULL;
+    }
+    pthread_mutex_init(&p->mutex, NULL);
+    pthread_cond_init(&p->work, NULL);
+    pthread_cond_init(&p->done, NULL);
+    for (p->count = 0; p->count < threads; p->count++) {
+        if (pthread_create(&p->threads[p->count], NULL, worker_main, p) != 0) {
+            query_pool_delete(p);
+            return NULL;
+        }
+    }
+    return p;
+}
+
+void query_pool_delete(query_pool_t *p) {
+    if (p == NULL)
+        return;
+    pthread_mutex_lock(&p->mutex);
+    p->stop = true;
+    pthread_cond_broadcast(&p->work);
+    pthread_mutex_unlock(&p->mutex);
+    for (uint32_t i = 0; i < p->count; i++)
+        pthread_join(p->threads[i], NULL);
+    query_pool_state_changed(p);
+    pthread_mutex_destroy(&p->mutex);
+    pthread_cond_destroy(&p->work);
+    pthread_cond_destroy(&p->done);
+    free(p->threads);
+    free(p);
+}
+
+bool query_pool_worth_offloading(gamma_t *g, const command_t *cmd) {
+    if (cmd->type != F && cmd->type != Q)
+        return false;
+    uint32_t player = cmd->params[0];
+    return player >= 1 && gamma_busy_fields(g, player) > 0
+           && gamma_player_areas(g, player) >= gamma_max_areas(g);
+}
+
+void query_pool_state_changed(query_pool_t *p) {
+    if (p->current != NULL) {
+        snapshot_release(p, p->current);
+        p->current = NULL;
+    }
+}
+
+/**
+ * @brief Tworzy migawkę stanu gry.
+ * @param[in] g – wskaźnik na strukturę przechowującą stan gry.
+ * @return Wskaźnik na migawkę z jednym odwołaniem lub @p NULL, gdy nie udało
+ * się zaalokować pamięci.
+ */
+static snapshot_t *snapshot_new(gamma_t *g) {
+    snapshot_t *s = malloc(sizeof(snapshot_t));
+    if (s == NULL)
+        return NULL;
+    s->g = gamma_copy(g);
+    if (s->g == NULL) {
+        free(s);
+        return NULL;
+    }
+    pthread_mutex_init(&s->lock, NULL);
+    s->refs = 1;
+    return s;
+}
+
+query_job_t *query_pool_submit(query_pool_t *p, gamma_t *g, const command_t *cmd) {
+    if (p->current == NULL && (p->current = snapshot_new(g)) == NULL)
+        return NULL;
+    query_job_t *job = malloc(sizeof(query_job_t));
+    if (job == NULL)
+        return NULL;
+    job->cmd = *cmd;
+    job->s = p->current;
+    job->next = NULL;
+    atomic_init(&job->done, false);
+
+    pthread_mutex_lock(&p->mutex);
+    job->s->refs++;
+    if (p->head == NULL)
+        p->head = job;
+    else
+        p->tail->next = job;
+    p->tail = job;
+    pthread_cond_signal(&p->work);
+    pthread_mutex_unlock(&p->mutex);
+    return job;
+}
+
+bool query_job_done(query_job_t *job) {
+    return atomic_load(&job->done);
+}
+
+void query_job_wait(query_pool_t *p, query_job_t *job, command_result_t *result) {
+    if (!atomic_load(&job->done)) {
+        pthread_mutex_lock(&p->mutex);
+        while (!atomic_load(&job->done))
+            pthread_cond_wait(&p->done, &p->mutex);
+        pthread_mutex_unlock(&p->mutex);
+    }
+    *result = job->result;
+    free(job);
+}
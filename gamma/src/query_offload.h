@@ -0,0 +1,100 @@
+/** @file
+ * Interfejs puli wątków odpowiadających na kosztowne zapytania
+ * (@p q i @p f) trybu wsadowego na kopiach stanu gry.
+ *
+ * Zapytanie wykonywane jest na migawce, czyli kopii stanu gry z chwili
+ * zlecenia (patrz @ref gamma_copy). Dopóki stan gry się nie zmieni,
+ * kolejne zapytania korzystają z tej samej migawki; zapytania dotyczące
+ * jednej migawki wykonywane są po kolei, bo @ref gamma_golden_possible
+ * tymczasowo ją modyfikuje. Migawka jest zwalniana po wykonaniu ostatniego
+ * korzystającego z niej zapytania.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#ifndef GAMMA_QUERY_OFFLOAD_H
+#define GAMMA_QUERY_OFFLOAD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "command.h"
+#include "gamma.h"
+
+/**
+ * Struktura przechowująca stan puli wątków.
+ */
+typedef struct query_pool query_pool_t;
+
+/**
+ * Struktura przechowująca zlecone zapytanie.
+ */
+typedef struct query_job query_job_t;
+
+/**
+ * @brief Tworzy pulę wątków.
+ * @param[in] threads – liczba wątków, wartość @p 0 oznacza liczbę dostępnych
+ *                      rdzeni.
+ * @return Wskaźnik na utworzoną pulę lub @p NULL, gdy nie udało się
+ * zaalokować pamięci lub uruchomić wątków.
+ */
+query_pool_t *query_pool_new(uint32_t threads);
+
+/**
+ * @brief Usuwa pulę wątków.
+ * Zakłada, że na wszystkie zlecone zapytania już zaczekano
+ * (patrz @ref query_job_wait).
+ * @param[in] p – wskaźnik na usuwaną pulę lub @p NULL.
+ */
+void query_pool_delete(query_pool_t *p);
+
+/**
+ * @brief Sprawdza, czy zapytanie warto wykonać w puli wątków.
+ * Zapytania @p f i @p q są kosztowne tylko wtedy, gdy gracz osiągnął
+ * maksymalną liczbę obszarów; w pozostałych przypadkach odpowiedź jest
+ * natychmiastowa i kopiowanie stanu gry byłoby droższe niż samo zapytanie.
+ * @param[in] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] cmd – polecenie o poprawnym pierwszym znaku.
+ * @return Wartość @p true, jeśli polecenie jest kosztownym zapytaniem,
+ * @p false w przeciwnym przypadku.
+ */
+bool query_pool_worth_offloading(gamma_t *g, const command_t *cmd);
+
+/**
+ * @brief Informuje pulę, że stan gry się zmienił.
+ * Kolejne zapytanie będzie wykonane na nowej migawce.
+ * @param[in,out] p – wskaźnik na pulę, różny od @p NULL.
+ */
+void query_pool_state_changed(query_pool_t *p);
+
+/**
+ * @brief Zleca wykonanie zapytania na migawce bieżącego stanu gry.
+ * Stan gry @p g nie może zmieniać się pomiędzy kolejnymi zleceniami bez
+ * wywołania @ref query_pool_state_changed.
+ * @param[in,out] p – wskaźnik na pulę, różny od @p NULL,
+ * @param[in] g     – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] cmd   – zapytanie @p f lub @p q.
+ * @return Wskaźnik na zlecone zapytanie lub @p NULL, gdy nie udało się
+ * zaalokować pamięci (wtedy należy wykonać zapytanie samodzielnie).
+ */
+query_job_t *query_pool_submit(query_pool_t *p, gamma_t *g, const command_t *cmd);
+
+/**
+ * @brief Sprawdza, czy zapytanie zostało już wykonane.
+ * @param[in] job – wskaźnik na zlecone zapytanie.
+ * @return Wartość @p true, jeśli wynik jest gotowy.
+ */
+bool query_job_done(query_job_t *job);
+
+/**
+ * @brief Czeka na wykonanie zapytania, odczytuje jego wynik i zwalnia
+ * zlecenie.
+ * @param[in,out] p   – wskaźnik na pulę, której zlecono zapytanie,
+ * @param[in] job     – wskaźnik na zlecone zapytanie,
+ * @param[out] result – wskaźnik na strukturę, do której zostanie zapisany
+ *                      wynik.
+ */
+void query_job_wait(query_pool_t *p, query_job_t *job, command_result_t *result);
+
+#endif //GAMMA_QUERY_OFFLOAD_H
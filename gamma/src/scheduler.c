@@ -0,0 +1,221 @@
+/** @file
+ * Zawiera implementację interfejsu scheduler.h
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#include "scheduler.h"
+#include <stdbool.h>
+#include <stdlib.h>
+
+#define NO_PLAYER 0 ///< Reprezentuje brak gracza.
+
+/**
+ * @brief Struktura przechowująca zbiór numerów graczy jako drzewo potęgowe.
+ */
+typedef struct player_set {
+    uint32_t size;   ///< Największy możliwy element zbioru.
+    uint32_t high;   ///< Największa potęga dwójki niewiększa od @p size.
+    uint32_t count;  ///< Liczba elementów zbioru.
+    uint32_t *tree;  /**< Drzewo potęgowe: element o indeksie @p i jest
+                      * liczbą elementów zbioru z przedziału
+                      * (@p i @p - @p lowbit(i), @p i].
+                      */
+    bool *member;    ///< Element o indeksie @p i równy @p true, jeśli @p i należy do zbioru.
+} player_set_t;
+
+/**
+ * @brief Struktura przechowująca harmonogram tur.
+ */
+struct scheduler {
+    gamma_t *g;             ///< Gra, której dotyczy harmonogram.
+    uint32_t players;       ///< Liczba graczy.
+    uint64_t moves;         ///< Liczba ruchów zapisanych w harmonogramie.
+    player_set_t movers;    /**< Gracze, którzy mogą zrobić zwykły ruch,
+                             * oraz być może gracze, którzy stracili tę
+                             * możliwość, a nie zostali jeszcze usunięci.
+                             */
+    player_set_t golden;    ///< Gracze, którzy nie zagrali złotego ruchu.
+    uint64_t *golden_fail;  /**< Element o indeksie @p i równy jest liczbie
+                             * ruchów powiększonej o @p 1 w chwili, gdy
+                             * ostatnio okazało się, że gracz @p i nie może
+                             * zrobić złotego ruchu, lub @p 0.
+                             */
+};
+
+/**
+ * @brief Tworzy zbiór zawierający wszystkie liczby od @p 1 do @p size.
+ * @param[out] set – wskaźnik na zbiór,
+ * @param[in] size – największy element zbioru.
+ * @return Wartość @p true, jeśli udało się zaalokować pamięć, @p false
+ * w przeciwnym przypadku.
+ */
+static bool set_init_full(player_set_t *set, uint32_t size) {
+    set->size = size;
+    set->count = size;
+    set->high = 1;
+    while (set->high <= size / 2)
+        set->high *= 2;
+    set->tree = malloc(((size_t) size + 1) * sizeof(uint32_t));
+    set->member = malloc(((size_t) size + 1) * sizeof(bool));
+    if (set->tree == NULL || set->member == NULL)
+        return false;
+    for (uint64_t i = 1; i <= size; i++) {
+        set->tree[i] = i & (~i + 1);
+        set->member[i] = true;
+    }
+    return true;
+}
+
+/**
+ * @brief Zwalnia pamięć zbioru.
+ * @param[in,out] set – wskaźnik na zbiór.
+ */
+static void set_free(player_set_t *set) {
+    free(set->tree);
+    free(set->member);
+}
+
+/**
+ * @brief Dodaje do zbioru liczbę lub ją z niego usuwa.
+ * Nic nie robi, jeśli liczba już jest (odpowiednio nie jest) w zbiorze.
+ * @param[in,out] set – wskaźnik na zbiór,
+ * @param[in] i       – liczba dodatnia niewiększa od @p set->size,
+ * @param[in] present – @p true, jeśli liczba ma należeć do zbioru.
+ */
+static void set_change(player_set_t *set, uint32_t i, bool present) {
+    if (set->member[i] == present)
+        return;
+    set->member[i] = present;
+    if (present)
+        set->count++;
+    else
+        set->count--;
+    for (uint64_t j = i; j <= set->size; j += j & (~j + 1)) {
+        if (present)
+            set->tree[j]++;
+        else
+            set->tree[j]--;
+    }
+}
+
+/**
+ * @brief Znajduje najmniejszy element zbioru niemniejszy od @p i.
+ * @param[in] set – wskaźnik na zbiór,
+ * @param[in] i   – liczba dodatnia.
+ * @return Znaleziony element lub @ref NO_PLAYER, jeśli takiego nie ma.
+ */
+static uint32_t set_next(const player_set_t *set, uint32_t i) {
+    if (i > set->size)
+        return NO_PLAYER;
+    uint32_t below = 0;
+    for (uint32_t j = i - 1; j > 0; j -= j & (~j + 1))
+        below += set->tree[j];
+    if (below == set->count)
+        return NO_PLAYER;
+    uint32_t k = below + 1, pos = 0;
+    for (uint32_t step = set->high; step > 0; step /= 2) {
+        if (pos + step <= set->size && set->tree[pos + step] < k) {
+            pos += step;
+            k -= set->tree[pos];
+        }
+    }
+    return pos + 1;
+}
+
+scheduler_t *scheduler_new(gamma_t *g, uint32_t players) {
+    scheduler_t *s = calloc(1, sizeof(scheduler_t));
+    if (s == NULL)
+        return NULL;
+    s->g = g;
+    s->players = players;
+    s->golden_fail = calloc((size_t) players + 1, sizeof(uint64_t));
+    if (!set_init_full(&s->movers, players) || !set_init_full(&s->golden, players)
+        || s->golden_fail == NULL) {
+        scheduler_delete(s);
+        return NULL;
+    }
+    return s;
+}
+
+void scheduler_delete(scheduler_t *s) {
+    if (s == NULL)
+        return;
+    set_free(&s->movers);
+    set_free(&s->golden);
+    free(s->golden_fail);
+    free(s);
+}
+
+void scheduler_moved(scheduler_t *s, uint32_t player, uint32_t previous) {
+    s->moves++;
+    set_change(&s->movers, player, true);
+    if (previous != NO_PLAYER) {
+        set_change(&s->golden, player, false);
+        set_change(&s->movers, previous, true);
+    }
+}
+
+/**
+ * @brief Sprawdza, czy gracz wybrany ze zbiorów może wykonać ruch.
+ * Usuwa go ze zbioru graczy mogących zrobić zwykły ruch, jeśli okaże się,
+ * że nie może go zrobić, i zapamiętuje, że nie może zrobić złotego ruchu.
+ * @param[in,out] s  – wskaźnik na harmonogram,
+ * @param[in] player – numer gracza należącego do któregoś ze zbiorów.
+ * @return Wartość @p true, jeśli gracz może wykonać ruch, @p false
+ * w przeciwnym przypadku.
+ */
+static bool can_move(scheduler_t *s, uint32_t player) {
+    if (s->movers.member[player]) {
+        if (gamma_free_fields(s->g, player) > 0)
+            return true;
+        set_change(&s->movers, player, false);
+    }
+    if (!s->golden.member[player] || s->golden_fail[player] == s->moves + 1)
+        return false;
+    if (gamma_golden_possible(s->g, player))
+        return true;
+    s->golden_fail[player] = s->moves + 1;
+    return false;
+}
+
+/**
+ * @brief Znajduje najmniejszy numer gracza z któregoś ze zbiorów,
+ * niemniejszy od @p i.
+ * @param[in] s – wskaźnik na harmonogram,
+ * @param[in] i – liczba dodatnia.
+ * @return Numer gracza lub @ref NO_PLAYER, jeśli takiego nie ma.
+ */
+static uint32_t next_candidate(const scheduler_t *s, uint32_t i) {
+    uint32_t a = set_next(&s->movers, i);
+    uint32_t b = set_next(&s->golden, i);
+    if (a == NO_PLAYER)
+        return b;
+    if (b == NO_PLAYER)
+        return a;
+    return a < b ? a : b;
+}
+
+uint32_t scheduler_next(scheduler_t *s, uint32_t curr) {
+    uint32_t i = curr + 1;
+    while (i <= s->players) {
+        uint32_t c = next_candidate(s, i);
+        if (c == NO_PLAYER)
+            break;
+        if (can_move(s, c))
+            return c;
+        i = c + 1;
+    }
+    i = 1;
+    while (i <= curr) {
+        uint32_t c = next_candidate(s, i);
+        if (c == NO_PLAYER || c > curr)
+            break;
+        if (can_move(s, c))
+            return c;
+        i = c + 1;
+    }
+    return NO_PLAYER;
+}
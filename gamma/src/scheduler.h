@@ -0,0 +1,74 @@
+/** @file
+ * Interfejs wybierania gracza, którego jest tura, w trybie interaktywnym.
+ *
+ * Harmonogram pamięta zbiór graczy, którzy mogą zrobić zwykły ruch, i zbiór
+ * graczy, którzy nie zagrali jeszcze złotego ruchu. Zbiory są drzewami
+ * potęgowymi (Fenwicka), więc następny gracz po danym znajdowany jest
+ * w czasie @p O(log @p players) bez sprawdzania po kolei wszystkich graczy.
+ * Zbiór graczy mogących zrobić zwykły ruch jest aktualizowany leniwie:
+ * gracz, którego wszystkie wolne sąsiednie pola zostały zajęte, jest
+ * usuwany dopiero wtedy, gdy przyjdzie jego kolej (sprawdzenie kosztuje
+ * @p O(1)), a ponownie dodawany po złotym ruchu, który mógł zmniejszyć
+ * liczbę jego obszarów.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#ifndef GAMMA_SCHEDULER_H
+#define GAMMA_SCHEDULER_H
+
+#include "gamma.h"
+#include <stdint.h>
+
+/**
+ * @brief Struktura przechowująca harmonogram tur.
+ */
+typedef struct scheduler scheduler_t;
+
+/**
+ * @brief Tworzy harmonogram tur dla gry.
+ * Zakłada, że żaden gracz nie zagrał jeszcze złotego ruchu.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] players – liczba graczy w grze.
+ * @return Wskaźnik na harmonogram lub @p NULL, jeśli nie udało się
+ * zaalokować pamięci.
+ */
+scheduler_t *scheduler_new(gamma_t *g, uint32_t players);
+
+/**
+ * @brief Usuwa harmonogram.
+ * Nic nie robi, jeśli @p s ma wartość @p NULL.
+ * @param[in,out] s – wskaźnik na harmonogram.
+ */
+void scheduler_delete(scheduler_t *s);
+
+/**
+ * @brief Zapisuje w harmonogramie wykonany ruch.
+ * Należy ją wywołać po każdym udanym wywołaniu @ref gamma_move lub
+ * @ref gamma_golden_move.
+ * @param[in,out] s   – wskaźnik na harmonogram,
+ * @param[in] player  – numer gracza, który wykonał ruch,
+ * @param[in] previous – numer gracza, do którego należało pole przed złotym
+ *                       ruchem, lub @p 0, jeśli ruch był zwykły.
+ */
+void scheduler_moved(scheduler_t *s, uint32_t player, uint32_t previous);
+
+/**
+ * @brief Znajduje następnego gracza, który może wykonać ruch.
+ * Sprawdza graczy po kolei, zaczynając od gracza po graczu @p curr,
+ * a kończąc na graczu @p curr, i zwraca pierwszego, który może zrobić
+ * zwykły lub złoty ruch. Pomija graczy, którzy nie mogą zrobić zwykłego
+ * ruchu i zagrali już złoty ruch. Jeśli od ostatniego sprawdzenia nikt nie
+ * wykonał ruchu, możliwość złotego ruchu gracza nie jest sprawdzana
+ * ponownie.
+ * @param[in,out] s – wskaźnik na harmonogram,
+ * @param[in] curr  – numer gracza, liczba dodatnia niewiększa od liczby
+ *                    graczy.
+ * @return Numer gracza lub wartość @p 0, jeśli żaden gracz nie może
+ * wykonać ruchu.
+ */
+uint32_t scheduler_next(scheduler_t *s, uint32_t curr);
+
+#endif //GAMMA_SCHEDULER_H
@@ -0,0 +1,269 @@
+/** @file
+ * Zawiera implementację interfejsu screen.h
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#include "screen.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define SPACE ' ' ///< Znak spacji.
+#define INITIAL_OUTPUT_SIZE 4096 ///< Początkowy rozmiar bufora wyjścia.
+#define CLEAR_SCREEN "\033[2J" ///< Kod czyszczący ekran.
+#define HIDE_CURSOR "\033[?25l" ///< Kod chowający kursor.
+#define SHOW_CURSOR "\033[?25h" ///< Kod pokazujący kursor.
+
+/**
+ * @brief Kody ustawiające kolejne kolory z @ref screen_color_t.
+ * Każdy kod najpierw przywraca domyślne ustawienia, więc nie zależy od
+ * poprzedniego koloru.
+ */
+static const char *const color_codes[SCREEN_COLORS] = {
+    "\033[0m",
+    "\033[0;32m",
+    "\033[0;33m",
+    "\033[0;31m",
+    "\033[0;37;42m",
+    "\033[0;37;41m",
+    "\033[0;37;44m",
+    "\033[0;30;43m"
+};
+
+/**
+ * @brief Struktura przechowująca bufor ekranu.
+ */
+struct screen {
+    uint32_t rows;         ///< Liczba wierszy.
+    uint32_t cols;         ///< Liczba kolumn.
+    char *chars;           ///< Znaki rysowanej klatki, wiersz po wierszu.
+    uint8_t *colors;       ///< Kolory rysowanej klatki.
+    char *shown_chars;     ///< Znaki wyświetlone na terminalu.
+    uint8_t *shown_colors; ///< Kolory wyświetlone na terminalu.
+    uint32_t cursor_row;   ///< Wiersz kursora terminala.
+    uint32_t cursor_col;   /**< Kolumna kursora terminala, równa @p cols,
+                            * jeśli pozycja kursora jest nieznana.
+                            */
+    uint8_t color;         ///< Bieżący kolor terminala.
+    char *out;             ///< Bufor wyjścia.
+    size_t out_len;        ///< Liczba bajtów w buforze wyjścia.
+    size_t out_size;       ///< Rozmiar bufora wyjścia.
+};
+
+/**
+ * @brief Dopisuje bajty do bufora wyjścia.
+ * Jeśli nie udało się powiększyć bufora, bajty są pomijane.
+ * @param[in,out] s – wskaźnik na bufor ekranu,
+ * @param[in] data  – dopisywane bajty,
+ * @param[in] len   – liczba bajtów.
+ */
+static void out_append(screen_t *s, const char *data, size_t len) {
+    if (s->out_len + len > s->out_size) {
+        size_t size = s->out_size;
+        while (s->out_len + len > size)
+            size *= 2;
+        char *out = realloc(s->out, size);
+        if (out == NULL)
+            return;
+        s->out = out;
+        s->out_size = size;
+    }
+    memcpy(s->out + s->out_len, data, len);
+    s->out_len += len;
+}
+
+/**
+ * @brief Dopisuje napis do bufora wyjścia.
+ * @param[in,out] s – wskaźnik na bufor ekranu,
+ * @param[in] str   – napis zakończony znakiem końca łańcucha.
+ */
+static void out_string(screen_t *s, const char *str) {
+    out_append(s, str, strlen(str));
+}
+
+/**
+ * @brief Dopisuje do bufora wyjścia kod przesuwający kursor.
+ * @param[in,out] s – wskaźnik na bufor ekranu,
+ * @param[in] row   – numer wiersza, licząc od @p 0,
+ * @param[in] col   – numer kolumny, licząc od @p 0.
+ */
+static void out_move(screen_t *s, uint32_t row, uint32_t col) {
+    char code[32];
+    int len = snprintf(code, sizeof(code), "\033[%u;%uH", row + 1, col + 1);
+    out_append(s, code, len);
+    s->cursor_row = row;
+    s->cursor_col = col;
+}
+
+/**
+ * @brief Wypisuje bufor wyjścia jednym wywołaniem @p write.
+ * Ponawia zapis, jeśli został przerwany lub zapisano tylko część bajtów.
+ * @param[in,out] s – wskaźnik na bufor ekranu.
+ * @return Wartość @p true, jeśli udało się wypisać cały bufor, @p false
+ * w przeciwnym przypadku.
+ */
+static bool out_write(screen_t *s) {
+    size_t done = 0;
+    while (done < s->out_len) {
+        ssize_t n = write(STDOUT_FILENO, s->out + done, s->out_len - done);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0) {
+            s->out_len = 0;
+            return false;
+        }
+        done += n;
+    }
+    s->out_len = 0;
+    return true;
+}
+
+screen_t *screen_new(uint32_t rows, uint32_t cols) {
+    screen_t *s = calloc(1, sizeof(screen_t));
+    if (s == NULL)
+        return NULL;
+    size_t cells = (size_t) rows * cols;
+    s->rows = rows;
+    s->cols = cols;
+    s->chars = malloc(cells);
+    s->colors = calloc(cells, sizeof(uint8_t));
+    s->shown_chars = malloc(cells);
+    s->shown_colors = calloc(cells, sizeof(uint8_t));
+    s->out = malloc(INITIAL_OUTPUT_SIZE);
+    s->out_size = INITIAL_OUTPUT_SIZE;
+    if (s->chars == NULL || s->colors == NULL || s->shown_chars == NULL
+        || s->shown_colors == NULL || s->out == NULL) {
+        screen_delete(s);
+        return NULL;
+    }
+    memset(s->chars, SPACE, cells);
+    memset(s->shown_chars, SPACE, cells);
+    s->color = SCREEN_DEFAULT;
+    fflush(stdout);
+    out_string(s, color_codes[SCREEN_DEFAULT]);
+    out_string(s, CLEAR_SCREEN);
+    out_string(s, HIDE_CURSOR);
+    out_move(s, 0, 0);
+    return s;
+}
+
+void screen_delete(screen_t *s) {
+    if (s == NULL)
+        return;
+    free(s->chars);
+    free(s->colors);
+    free(s->shown_chars);
+    free(s->shown_colors);
+    free(s->out);
+    free(s);
+}
+
+uint32_t screen_put(screen_t *s, uint32_t row, uint32_t col, const char *text,
+                    size_t len, screen_color_t color) {
+    if (row >= s->rows)
+        return col + len;
+    for (size_t i = 0; i < len && col + i < s->cols; i++) {
+        size_t cell = (size_t) row * s->cols + col + i;
+        s->chars[cell] = text[i];
+        s->colors[cell] = color;
+    }
+    return col + len;
+}
+
+void screen_clear_line(screen_t *s, uint32_t row, uint32_t col) {
+    if (row >= s->rows || col >= s->cols)
+        return;
+    size_t cell = (size_t) row * s->cols + col;
+    memset(s->chars + cell, SPACE, s->cols - col);
+    memset(s->colors + cell, SCREEN_DEFAULT, s->cols - col);
+}
+
+/**
+ * @brief Przesuwa wiersze tablicy komórek i czyści odsłonięte wiersze.
+ * @param[in,out] cells – tablica komórek ekranu,
+ * @param[in] size      – rozmiar jednej komórki w bajtach,
+ * @param[in] blank     – wartość bajtów pustej komórki,
+ * @param[in] cols      – liczba kolumn ekranu,
+ * @param[in] top       – numer pierwszego przewijanego wiersza,
+ * @param[in] bottom    – numer ostatniego przewijanego wiersza,
+ * @param[in] n         – przesunięcie, dodatnie w górę, ujemne w dół.
+ */
+static void shift_rows(void *cells, size_t size, int blank, uint32_t cols,
+                       uint32_t top, uint32_t bottom, int32_t n) {
+    char *base = (char *) cells + (size_t) top * cols * size;
+    size_t row = (size_t) cols * size;
+    size_t count = bottom - top + 1;
+    size_t shift = n > 0 ? (size_t) n : (size_t) -n;
+    if (n > 0) {
+        memmove(base, base + shift * row, (count - shift) * row);
+        memset(base + (count - shift) * row, blank, shift * row);
+    } else {
+        memmove(base + shift * row, base, (count - shift) * row);
+        memset(base, blank, shift * row);
+    }
+}
+
+void screen_scroll(screen_t *s, uint32_t top, uint32_t bottom, int32_t n) {
+    if (n == 0)
+        return;
+    shift_rows(s->chars, sizeof(char), SPACE, s->cols, top, bottom, n);
+    shift_rows(s->colors, sizeof(uint8_t), SCREEN_DEFAULT, s->cols, top, bottom, n);
+    shift_rows(s->shown_chars, sizeof(char), SPACE, s->cols, top, bottom, n);
+    shift_rows(s->shown_colors, sizeof(uint8_t), SCREEN_DEFAULT, s->cols, top,
+               bottom, n);
+    if (s->color != SCREEN_DEFAULT) {
+        s->color = SCREEN_DEFAULT;
+        out_string(s, color_codes[SCREEN_DEFAULT]);
+    }
+    char code[64];
+    int len = snprintf(code, sizeof(code), "\033[%u;%ur\033[%d%c\033[r",
+                       top + 1, bottom + 1, n > 0 ? n : -n, n > 0 ? 'S' : 'T');
+    out_append(s, code, len);
+    s->cursor_col = s->cols;
+}
+
+/**
+ * @brief Dopisuje do bufora wyjścia zmiany klatki względem ekranu.
+ * @param[in,out] s – wskaźnik na bufor ekranu.
+ */
+static void render_changes(screen_t *s) {
+    for (uint32_t row = 0; row < s->rows; row++) {
+        for (uint32_t col = 0; col < s->cols; col++) {
+            size_t cell = (size_t) row * s->cols + col;
+            if (s->chars[cell] == s->shown_chars[cell]
+                && s->colors[cell] == s->shown_colors[cell])
+                continue;
+            if (row != s->cursor_row || col != s->cursor_col)
+                out_move(s, row, col);
+            if (s->colors[cell] != s->color) {
+                s->color = s->colors[cell];
+                out_string(s, color_codes[s->color]);
+            }
+            out_append(s, &s->chars[cell], 1);
+            s->cursor_col++;
+            s->shown_chars[cell] = s->chars[cell];
+            s->shown_colors[cell] = s->colors[cell];
+        }
+    }
+}
+
+bool screen_flush(screen_t *s) {
+    render_changes(s);
+    return out_write(s);
+}
+
+bool screen_finish(screen_t *s, uint32_t row) {
+    render_changes(s);
+    if (s->color != SCREEN_DEFAULT) {
+        s->color = SCREEN_DEFAULT;
+        out_string(s, color_codes[SCREEN_DEFAULT]);
+    }
+    out_move(s, row, 0);
+    out_string(s, SHOW_CURSOR);
+    return out_write(s);
+}
@@ -0,0 +1,121 @@
+/** @file
+ * Interfejs bufora ekranu terminala używanego w trybie interaktywnym.
+ *
+ * Program rysuje klatkę w buforze przechowującym znak i kolor każdej
+ * komórki ekranu. Funkcja @ref screen_flush porównuje bufor z kopią tego,
+ * co jest już wyświetlone, i wysyła do terminala tylko zmienione komórki:
+ * przesuwa kursor tylko wtedy, gdy kolejna zmieniona komórka nie leży tuż za
+ * poprzednią, zmienia kolor tylko wtedy, gdy różni się od bieżącego, a całą
+ * klatkę wypisuje jednym wywołaniem @p write.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#ifndef GAMMA_SCREEN_H
+#define GAMMA_SCREEN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Kolory komórek ekranu.
+ */
+typedef enum screen_color {
+    SCREEN_DEFAULT, ///< Domyślny kolor terminala.
+    SCREEN_GREEN,   ///< Zielony tekst.
+    SCREEN_YELLOW,  ///< Żółty tekst.
+    SCREEN_RED,     ///< Czerwony tekst.
+    SCREEN_ON_GREEN, ///< Biały tekst na zielonym tle.
+    SCREEN_ON_RED,  ///< Biały tekst na czerwonym tle.
+    SCREEN_ON_BLUE, ///< Biały tekst na niebieskim tle.
+    SCREEN_ON_YELLOW, ///< Czarny tekst na żółtym tle.
+    SCREEN_COLORS   ///< Liczba kolorów.
+} screen_color_t;
+
+/**
+ * @brief Struktura przechowująca bufor ekranu.
+ */
+typedef struct screen screen_t;
+
+/**
+ * @brief Tworzy bufor ekranu.
+ * Pierwsza klatka czyści ekran i chowa kursor.
+ * @param[in] rows – liczba wierszy ekranu, dodatnia,
+ * @param[in] cols – liczba kolumn ekranu, dodatnia.
+ * @return Wskaźnik na bufor lub @p NULL, jeśli nie udało się zaalokować
+ * pamięci.
+ */
+screen_t *screen_new(uint32_t rows, uint32_t cols);
+
+/**
+ * @brief Usuwa bufor ekranu.
+ * Nic nie robi, jeśli @p s ma wartość @p NULL.
+ * @param[in,out] s – wskaźnik na bufor.
+ */
+void screen_delete(screen_t *s);
+
+/**
+ * @brief Zapisuje napis w buforze.
+ * Znaki wychodzące poza ekran są pomijane.
+ * @param[in,out] s – wskaźnik na bufor,
+ * @param[in] row   – numer wiersza, licząc od @p 0,
+ * @param[in] col   – numer kolumny pierwszego znaku, licząc od @p 0,
+ * @param[in] text  – napis,
+ * @param[in] len   – liczba znaków napisu,
+ * @param[in] color – kolor znaków.
+ * @return Numer kolumny tuż za zapisanym napisem.
+ */
+uint32_t screen_put(screen_t *s, uint32_t row, uint32_t col, const char *text,
+                    size_t len, screen_color_t color);
+
+/**
+ * @brief Czyści wiersz bufora od danej kolumny do końca.
+ * @param[in,out] s – wskaźnik na bufor,
+ * @param[in] row   – numer wiersza, licząc od @p 0,
+ * @param[in] col   – numer pierwszej czyszczonej kolumny, licząc od @p 0.
+ */
+void screen_clear_line(screen_t *s, uint32_t row, uint32_t col);
+
+/**
+ * @brief Przewija fragment ekranu o @p n wierszy.
+ * Przesuwa wiersze od @p top do @p bottom włącznie o @p n wierszy w górę
+ * (lub o @p -n wierszy w dół, jeśli @p n jest ujemne), zarówno w buforze,
+ * jak i na terminalu, za pomocą obszaru przewijania terminala. Odsłonięte
+ * wiersze są puste, więc po przewinięciu wystarczy narysować tylko je.
+ * Przewinięcie zostanie wysłane do terminala razem z następną klatką.
+ * @param[in,out] s – wskaźnik na bufor,
+ * @param[in] top    – numer pierwszego przewijanego wiersza,
+ * @param[in] bottom – numer ostatniego przewijanego wiersza, mniejszy od
+ *                     liczby wierszy ekranu i niemniejszy od @p top,
+ * @param[in] n      – liczba wierszy, o którą przesuwany jest fragment,
+ *                     co do wartości bezwzględnej mniejsza od liczby jego
+ *                     wierszy.
+ */
+void screen_scroll(screen_t *s, uint32_t top, uint32_t bottom, int32_t n);
+
+/**
+ * @brief Wyświetla klatkę.
+ * Wysyła do terminala zmiany względem poprzedniej klatki jednym wywołaniem
+ * @p write.
+ * @param[in,out] s – wskaźnik na bufor.
+ * @return Wartość @p true, jeśli udało się wypisać klatkę, @p false
+ * w przeciwnym przypadku.
+ */
+bool screen_flush(screen_t *s);
+
+/**
+ * @brief Wyświetla ostatnią klatkę i oddaje terminal.
+ * Po klatce przywraca domyślny kolor, przenosi kursor na początek wiersza
+ * @p row i pokazuje go, tak aby dalsze wypisywanie zaczynało się od tego
+ * wiersza.
+ * @param[in,out] s – wskaźnik na bufor,
+ * @param[in] row   – numer wiersza, licząc od @p 0.
+ * @return Wartość @p true, jeśli udało się wypisać klatkę, @p false
+ * w przeciwnym przypadku.
+ */
+bool screen_finish(screen_t *s, uint32_t row);
+
+#endif //GAMMA_SCREEN_H
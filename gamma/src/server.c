@@ -0,0 +1,599 @@
+/** @file
+ * Zawiera implementację interfejsu server.h
+ *
+ * Wątek główny przekazuje przyjęte deskryptory wątkom roboczym przez
+ * potoki (zapis liczby typu @p int do potoku jest atomowy), dzięki czemu
+ * sesja od początku do końca należy do jednego wątku i nie wymaga żadnej
+ * synchronizacji. Wartość @ref STOP_FD w potoku kończy pracę wątku.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#define _GNU_SOURCE ///< Makro potrzebne do prawidłowej kompilacji.
+
+#include "server.h"
+#include "command.h"
+#include "gamma.h"
+#include "gamma_pool.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define B 'B' ///< Pierwszy znak w poleceniu tworzącym grę sesji.
+#define STOP_FD -1 ///< Wartość przekazywana wątkowi roboczemu, by zakończył pracę.
+#define MAX_EVENTS 256 ///< Liczba zdarzeń odbieranych jednym wywołaniem @p epoll_wait.
+#define READ_SIZE 65536 ///< Maksymalna liczba bajtów czytanych naraz z gniazda.
+#define MAX_LINE_SIZE (1 << 20) /**< Maksymalna długość wiersza; dłuższy
+                                 * wiersz jest niepoprawny i pomijany.
+                                 */
+#define OUTPUT_HIGH_WATER (1 << 18) /**< Liczba niewysłanych bajtów, po której
+                                     * przekroczeniu sesja przestaje czytać
+                                     * polecenia, dopóki klient nie odbierze
+                                     * odpowiedzi.
+                                     */
+#define NUMBER_SIZE 32 ///< Rozmiar bufora na zapis dziesiętny liczby.
+#define ULL unsigned long long ///< Makro definiujące typ @p unsigned @p long @p long.
+
+/**
+ * @brief Struktura przechowująca stan sesji.
+ */
+typedef struct session {
+    int fd;            ///< Deskryptor gniazda.
+    gamma_t *g;        ///< Gra sesji lub @p NULL przed poleceniem @ref B.
+    gamma_pool_t *pool; ///< Pula gier wątku roboczego sesji.
+    ULL line_count;    ///< Numer kolejnego wiersza.
+    char *in;          ///< Bufor wczytanych, nieprzetworzonych danych.
+    size_t in_len;     ///< Liczba bajtów w buforze @p in.
+    size_t in_size;    ///< Rozmiar bufora @p in.
+    bool skip_line;    /**< Równe @p true, jeśli pomijana jest reszta zbyt
+                        * długiego wiersza.
+                        */
+    char *out;         ///< Bufor niewysłanych odpowiedzi.
+    size_t out_start;  ///< Indeks pierwszego niewysłanego bajtu w @p out.
+    size_t out_len;    ///< Indeks za ostatnim bajtem w @p out.
+    size_t out_size;   ///< Rozmiar bufora @p out.
+    bool eof;          ///< Równe @p true, jeśli klient zakończył wysyłanie.
+    bool broken;       /**< Równe @p true, jeśli sesję należy natychmiast
+                        * zamknąć (błąd gniazda lub brak pamięci).
+                        */
+    uint32_t events;   ///< Zdarzenia, na które sesja czeka w @p epoll.
+    struct session *prev; ///< Poprzednia sesja na liście sesji wątku.
+    struct session *next; ///< Następna sesja na liście sesji wątku.
+} session_t;
+
+/**
+ * @brief Struktura przechowująca stan wątku roboczego.
+ */
+typedef struct worker {
+    pthread_t thread; ///< Wątek.
+    int epoll_fd;     ///< Instancja @p epoll wątku.
+    int pipe_fd[2];   ///< Potok, którym przekazywane są nowe połączenia.
+    char *read_buf;   ///< Bufor, do którego czytane są dane z gniazd.
+    session_t *sessions; ///< Lista otwartych sesji wątku.
+    gamma_pool_t *pool; ///< Gry zamkniętych sesji do ponownego użycia.
+} worker_t;
+
+/**
+ * @brief Flaga ustawiana przez obsługę sygnału kończącego pracę serwera.
+ */
+static volatile sig_atomic_t stop_requested = 0;
+
+/**
+ * @brief Obsługuje sygnał kończący pracę serwera.
+ * @param[in] sig – numer sygnału.
+ */
+static void handle_stop_signal(int sig) {
+    (void) sig;
+    stop_requested = 1;
+}
+
+/**
+ * @brief Ustawia tryb nieblokujący deskryptora.
+ * @param[in] fd – deskryptor.
+ * @return Wartość @p true, jeśli się udało, @p false w przeciwnym przypadku.
+ */
+static bool set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+/**
+ * @brief Zapewnia, że bufor pomieści co najmniej @p needed bajtów.
+ * @param[in,out] buf  – wskaźnik na bufor,
+ * @param[in,out] size – wskaźnik na rozmiar bufora,
+ * @param[in] needed   – wymagany rozmiar.
+ * @return Wartość @p true, jeśli się udało, @p false, jeśli nie udało się
+ * zaalokować pamięci.
+ */
+static bool reserve(char **buf, size_t *size, size_t needed) {
+    if (needed <= *size)
+        return true;
+    size_t new_size = *size == 0 ? READ_SIZE : *size;
+    while (new_size < needed)
+        new_size *= 2;
+    char *new_buf = realloc(*buf, new_size);
+    if (new_buf == NULL)
+        return false;
+    *buf = new_buf;
+    *size = new_size;
+    return true;
+}
+
+/**
+ * @brief Dopisuje dane do bufora odpowiedzi sesji.
+ * Jeśli nie uda się zaalokować pamięci, oznacza sesję do zamknięcia.
+ * @param[in,out] s – sesja,
+ * @param[in] data  – dane,
+ * @param[in] len   – długość danych.
+ */
+static void session_append(session_t *s, const char *data, size_t len) {
+    if (s->out_start == s->out_len)
+        s->out_start = s->out_len = 0;
+    if (!reserve(&s->out, &s->out_size, s->out_len + len)) {
+        s->broken = true;
+        return;
+    }
+    memcpy(s->out + s->out_len, data, len);
+    s->out_len += len;
+}
+
+/**
+ * @brief Dopisuje do bufora odpowiedzi sesji planszę gry.
+ * Plansza jest zapisywana bezpośrednio w buforze, bez pośredniego napisu.
+ * Jeśli nie uda się zaalokować pamięci, oznacza sesję do zamknięcia.
+ * @param[in,out] s – sesja z utworzoną grą.
+ */
+static void session_append_board(session_t *s) {
+    if (s->out_start == s->out_len)
+        s->out_start = s->out_len = 0;
+    uint64_t len = gamma_board_buffer(s->g, NULL, 0);
+    if (!reserve(&s->out, &s->out_size, s->out_len + len + 1)) {
+        s->broken = true;
+        return;
+    }
+    gamma_board_buffer(s->g, s->out + s->out_len, len + 1);
+    s->out_len += len;
+}
+
+/**
+ * @brief Dopisuje do bufora odpowiedzi sesji komunikat i numer wiersza.
+ * @param[in,out] s      – sesja,
+ * @param[in] message    – komunikat (@p OK lub @p ERROR),
+ * @param[in] line_count – numer wiersza.
+ */
+static void session_append_line_message(session_t *s, const char *message,
+                                        ULL line_count) {
+    char buf[NUMBER_SIZE + 8];
+    int len = snprintf(buf, sizeof(buf), "%s %llu\n", message, line_count);
+    session_append(s, buf, len);
+}
+
+/**
+ * @brief Dopisuje do bufora odpowiedzi sesji wynik polecenia.
+ * Zapisuje wynik tak, jak wypisałby go tryb wsadowy.
+ * @param[in,out] s      – sesja,
+ * @param[in] cmd        – wykonane polecenie,
+ * @param[in] result     – wynik polecenia.
+ */
+static void session_append_result(session_t *s, const command_t *cmd,
+                                  command_result_t *result) {
+    char buf[NUMBER_SIZE];
+    int len;
+    if (!result->ok) {
+        session_append_line_message(s, "ERROR", s->line_count);
+        return;
+    }
+    switch (cmd->type) {
+        case P:
+        case STATS:
+        case MEMORY:
+            session_append(s, result->board, result->value);
+            free(result->board);
+            return;
+        case SMALL_B:
+        case F:
+            len = snprintf(buf, sizeof(buf), "%lu\n", result->value);
+            break;
+        default:
+            len = snprintf(buf, sizeof(buf), "%d\n", result->value != 0);
+    }
+    session_append(s, buf, len);
+}
+
+/**
+ * @brief Przetwarza wiersz przed utworzeniem gry sesji.
+ * Postępuje tak jak tryb wsadowy przed wyborem trybu, z tą różnicą,
+ * że jedynym akceptowanym poleceniem jest @ref B.
+ * @param[in,out] s – sesja,
+ * @param[in] line  – wiersz,
+ * @param[in] len   – długość wiersza, liczba dodatnia.
+ */
+static void session_start_line(session_t *s, const char *line, size_t len) {
+    uint32_t numbers[MAX_PARAMETER_COUNT];
+    char c = line[0];
+    if (c == IGNORE_LINE || c == END_LINE)
+        return;
+    if (c == B && line[len - 1] == END_LINE
+        && read_numbers(&line[1], MAX_PARAMETER_COUNT, numbers))
+        s->g = gamma_pool_get(s->pool, numbers[0], numbers[1], numbers[2],
+                              numbers[3]);
+    if (s->g != NULL)
+        session_append_line_message(s, "OK", s->line_count);
+    else
+        session_append_line_message(s, "ERROR", s->line_count);
+}
+
+/**
+ * @brief Przetwarza wiersz wejścia sesji.
+ * @param[in,out] s – sesja,
+ * @param[in] line  – wiersz wraz z kończącym go znakiem @ref END_LINE, o ile
+ *                    wystąpił,
+ * @param[in] len   – długość wiersza, liczba dodatnia.
+ */
+static void session_line(session_t *s, const char *line, size_t len) {
+    if (s->g == NULL) {
+        session_start_line(s, line, len);
+    } else {
+        command_t cmd;
+        line_status_t status = command_parse_line(line, len, &cmd);
+        if (status == LINE_OK && cmd.type == P) {
+            session_append_board(s);
+        } else if (status == LINE_OK) {
+            command_result_t result;
+            command_execute(s->g, &cmd, &result);
+            session_append_result(s, &cmd, &result);
+        } else if (status == LINE_ERROR) {
+            session_append_line_message(s, "ERROR", s->line_count);
+        }
+    }
+    s->line_count++;
+}
+
+/**
+ * @brief Przetwarza wszystkie pełne wiersze z bufora wejściowego sesji.
+ * Po zakończeniu wejścia przetwarza także ostatni, niepełny wiersz.
+ * @param[in,out] s – sesja.
+ */
+static void session_process_input(session_t *s) {
+    size_t pos = 0;
+    while (pos < s->in_len) {
+        char *nl = memchr(s->in + pos, END_LINE, s->in_len - pos);
+        if (nl == NULL)
+            break;
+        size_t len = nl - (s->in + pos) + 1;
+        if (s->skip_line) {
+            s->skip_line = false;
+            s->line_count++;
+        } else {
+            session_line(s, s->in + pos, len);
+        }
+        pos += len;
+    }
+    if (s->eof && pos < s->in_len) {
+        if (!s->skip_line)
+            session_line(s, s->in + pos, s->in_len - pos);
+        pos = s->in_len;
+    }
+    if (s->in_len - pos > MAX_LINE_SIZE && !s->skip_line) {
+        session_append_line_message(s, "ERROR", s->line_count);
+        s->skip_line = true;
+    }
+    if (s->skip_line)
+        pos = s->in_len;
+    memmove(s->in, s->in + pos, s->in_len - pos);
+    s->in_len -= pos;
+}
+
+/**
+ * @brief Czyta dostępne dane z gniazda sesji i przetwarza je.
+ * @param[in,out] s   – sesja,
+ * @param[in] buf     – bufor pomocniczy o rozmiarze @ref READ_SIZE.
+ */
+static void session_read(session_t *s, char *buf) {
+    ssize_t n = read(s->fd, buf, READ_SIZE);
+    if (n < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            s->broken = true;
+        return;
+    }
+    if (n == 0) {
+        s->eof = true;
+    } else {
+        if (!reserve(&s->in, &s->in_size, s->in_len + n)) {
+            s->broken = true;
+            return;
+        }
+        memcpy(s->in + s->in_len, buf, n);
+        s->in_len += n;
+    }
+    session_process_input(s);
+}
+
+/**
+ * @brief Wysyła jak najwięcej oczekujących odpowiedzi sesji.
+ * @param[in,out] s – sesja.
+ */
+static void session_flush(session_t *s) {
+    while (s->out_start < s->out_len) {
+        ssize_t n = send(s->fd, s->out + s->out_start,
+                         s->out_len - s->out_start, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                s->broken = true;
+            return;
+        }
+        s->out_start += n;
+    }
+}
+
+/**
+ * @brief Zamyka sesję i zwalnia jej zasoby, w tym grę.
+ * @param[in,out] w – wątek roboczy, do którego należy sesja,
+ * @param[in] s     – sesja.
+ */
+static void session_close(worker_t *w, session_t *s) {
+    if (s->prev != NULL)
+        s->prev->next = s->next;
+    else
+        w->sessions = s->next;
+    if (s->next != NULL)
+        s->next->prev = s->prev;
+    close(s->fd);
+    gamma_pool_put(w->pool, s->g);
+    free(s->in);
+    free(s->out);
+    free(s);
+}
+
+/**
+ * @brief Obsługuje zdarzenia gniazda sesji.
+ * Czyta i wykonuje polecenia, wysyła odpowiedzi i ustala, na jakie
+ * zdarzenia sesja ma dalej czekać. Zamyka sesję po wysłaniu wszystkich
+ * odpowiedzi na zakończone wejście lub po błędzie.
+ * @param[in] w      – wątek roboczy, do którego należy sesja,
+ * @param[in,out] s  – sesja,
+ * @param[in] events – zdarzenia zgłoszone przez @p epoll.
+ */
+static void session_handle(worker_t *w, session_t *s, uint32_t events) {
+    if (events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+        session_read(s, w->read_buf);
+    if (!s->broken)
+        session_flush(s);
+    bool pending = s->out_start < s->out_len;
+    if (s->broken || (s->eof && !pending)) {
+        session_close(w, s);
+        return;
+    }
+    uint32_t wanted = 0;
+    if (!s->eof && s->out_len - s->out_start < OUTPUT_HIGH_WATER)
+        wanted |= EPOLLIN;
+    if (pending)
+        wanted |= EPOLLOUT;
+    if (wanted != s->events) {
+        struct epoll_event ev = {.events = wanted, .data.ptr = s};
+        epoll_ctl(w->epoll_fd, EPOLL_CTL_MOD, s->fd, &ev);
+        s->events = wanted;
+    }
+}
+
+/**
+ * @brief Tworzy sesję dla przyjętego połączenia.
+ * Jeśli się nie uda, zamyka połączenie.
+ * @param[in] w  – wątek roboczy, który będzie obsługiwał sesję,
+ * @param[in] fd – deskryptor nieblokującego gniazda połączenia.
+ */
+static void session_open(worker_t *w, int fd) {
+    session_t *s = calloc(1, sizeof(session_t));
+    if (s == NULL) {
+        close(fd);
+        return;
+    }
+    s->fd = fd;
+    s->pool = w->pool;
+    s->line_count = 1;
+    s->events = EPOLLIN;
+    s->next = w->sessions;
+    if (w->sessions != NULL)
+        w->sessions->prev = s;
+    w->sessions = s;
+    struct epoll_event ev = {.events = EPOLLIN, .data.ptr = s};
+    if (epoll_ctl(w->epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0)
+        session_close(w, s);
+}
+
+/**
+ * @brief Główna pętla wątku roboczego.
+ * Zdarzenie z danymi równymi @p NULL oznacza potok z nowymi połączeniami.
+ * Po odebraniu @ref STOP_FD zamyka wszystkie swoje sesje i kończy pracę.
+ * @param[in] arg – wskaźnik na strukturę wątku roboczego.
+ * @return Wartość @p NULL.
+ */
+static void *worker_main(void *arg) {
+    worker_t *w = arg;
+    struct epoll_event events[MAX_EVENTS];
+    bool stop = false;
+    while (!stop) {
+        int n = epoll_wait(w->epoll_fd, events, MAX_EVENTS, -1);
+        if (n < 0 && errno != EINTR)
+            break;
+        for (int i = 0; i < n; i++) {
+            if (events[i].data.ptr != NULL) {
+                session_handle(w, events[i].data.ptr, events[i].events);
+                continue;
+            }
+            int fd;
+            while (!stop && read(w->pipe_fd[0], &fd, sizeof(int)) == sizeof(int)) {
+                if (fd == STOP_FD)
+                    stop = true;
+                else
+                    session_open(w, fd);
+            }
+        }
+    }
+    while (w->sessions != NULL)
+        session_close(w, w->sessions);
+    return NULL;
+}
+
+/**
+ * @brief Zwraca liczbę dostępnych rdzeni.
+ * @return Liczba dostępnych rdzeni, co najmniej @p 1.
+ */
+static uint32_t available_cores() {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores > 0 ? cores : 1;
+}
+
+/**
+ * @brief Podnosi limit otwartych deskryptorów do maksymalnej dozwolonej
+ * wartości, by serwer mógł obsługiwać tysiące połączeń.
+ */
+static void raise_file_limit() {
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+/**
+ * @brief Tworzy gniazdo nasłuchujące pod ścieżką @p path.
+ * @param[in] path – ścieżka gniazda.
+ * @return Deskryptor gniazda lub @p -1, jeśli nie udało się go utworzyć.
+ */
+static int listen_on(const char *path) {
+    struct sockaddr_un addr = {.sun_family = AF_UNIX};
+    if (strlen(path) >= sizeof(addr.sun_path))
+        return -1;
+    strcpy(addr.sun_path, path);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return -1;
+    unlink(path);
+    if (bind(fd, (struct sockaddr *) &addr, sizeof(addr)) != 0
+        || listen(fd, SOMAXCONN) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Przygotowuje i uruchamia wątek roboczy.
+ * @param[out] w – struktura wątku roboczego.
+ * @return Wartość @p true, jeśli się udało, @p false w przeciwnym przypadku
+ * (wtedy zasoby wątku zostały zwolnione).
+ */
+static bool worker_start(worker_t *w) {
+    memset(w, 0, sizeof(worker_t));
+    w->pipe_fd[0] = w->pipe_fd[1] = -1;
+    w->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    w->read_buf = malloc(READ_SIZE);
+    w->pool = gamma_pool_new(GAMMA_POOL_DEFAULT_IDLE);
+    bool ok = w->epoll_fd >= 0 && w->read_buf != NULL && w->pool != NULL
+              && pipe2(w->pipe_fd, O_CLOEXEC) == 0
+              && set_nonblocking(w->pipe_fd[0]);
+    if (ok) {
+        struct epoll_event ev = {.events = EPOLLIN, .data.ptr = NULL};
+        ok = epoll_ctl(w->epoll_fd, EPOLL_CTL_ADD, w->pipe_fd[0], &ev) == 0
+             && pthread_create(&w->thread, NULL, worker_main, w) == 0;
+    }
+    if (!ok) {
+        close(w->epoll_fd);
+        close(w->pipe_fd[0]);
+        close(w->pipe_fd[1]);
+        free(w->read_buf);
+        gamma_pool_delete(w->pool);
+    }
+    return ok;
+}
+
+/**
+ * @brief Kończy pracę wątku roboczego i zwalnia jego zasoby.
+ * @param[in,out] w – struktura uruchomionego wątku roboczego.
+ */
+static void worker_stop(worker_t *w) {
+    int fd = STOP_FD;
+    while (write(w->pipe_fd[1], &fd, sizeof(int)) < 0 && errno == EINTR);
+    pthread_join(w->thread, NULL);
+    close(w->epoll_fd);
+    close(w->pipe_fd[0]);
+    close(w->pipe_fd[1]);
+    free(w->read_buf);
+    gamma_pool_delete(w->pool);
+}
+
+/**
+ * @brief Przyjmuje połączenia i przekazuje je kolejnym wątkom roboczym.
+ * Kończy działanie po otrzymaniu sygnału kończącego pracę serwera.
+ * @param[in] listen_fd – deskryptor gniazda nasłuchującego,
+ * @param[in] workers   – tablica wątków roboczych,
+ * @param[in] count     – liczba wątków roboczych.
+ */
+static void accept_loop(int listen_fd, worker_t *workers, uint32_t count) {
+    uint32_t next = 0;
+    while (!stop_requested) {
+        int fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            // Przy braku deskryptorów czekamy, aż sesje się zakończą.
+            if (errno == EMFILE || errno == ENFILE)
+                usleep(1000);
+            continue;
+        }
+        if (write(workers[next].pipe_fd[1], &fd, sizeof(int)) != sizeof(int))
+            close(fd);
+        next = (next + 1) % count;
+    }
+}
+
+bool server_run(const char *path, uint32_t workers) {
+    if (workers == 0)
+        workers = available_cores();
+    raise_file_limit();
+
+    // Bez flagi SA_RESTART sygnał przerywa oczekiwanie w accept.
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = handle_stop_signal;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    int listen_fd = listen_on(path);
+    if (listen_fd < 0)
+        return false;
+    // Sygnały kończące pracę obsługuje tylko wątek główny, więc wątki
+    // robocze (dziedziczące maskę) uruchamiamy z zablokowanymi sygnałami.
+    sigset_t stop_signals, old_mask;
+    sigemptyset(&stop_signals);
+    sigaddset(&stop_signals, SIGINT);
+    sigaddset(&stop_signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stop_signals, &old_mask);
+    worker_t *w = malloc(workers * sizeof(worker_t));
+    uint32_t started = 0;
+    while (w != NULL && started < workers && worker_start(&w[started]))
+        started++;
+    pthread_sigmask(SIG_SETMASK, &old_mask, NULL);
+    bool ok = w != NULL && started == workers;
+    if (ok)
+        accept_loop(listen_fd, w, workers);
+    for (uint32_t i = 0; i < started; i++)
+        worker_stop(&w[i]);
+    free(w);
+    close(listen_fd);
+    unlink(path);
+    return ok;
+}
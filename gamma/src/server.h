@@ -0,0 +1,40 @@
+/** @file
+ * Interfejs serwera gier nasłuchującego na gnieździe domeny uniksowej.
+ *
+ * Każde połączenie to osobna sesja posługująca się językiem trybu
+ * wsadowego: pierwszym poprawnym poleceniem musi być @p B, które tworzy
+ * grę należącą do sesji, kolejne wiersze to polecenia wykonywane na tej
+ * grze. Odpowiedzi, w tym komunikaty @p ERROR @p n, odsyłane są tym samym
+ * gniazdem w kolejności wierszy. Gra jest usuwana po zamknięciu połączenia.
+ *
+ * Połączenia przyjmuje wątek główny i rozdziela je po kolei pomiędzy wątki
+ * robocze. Każdy wątek roboczy obsługuje swoje sesje za pomocą własnej
+ * instancji @p epoll, na gniazdach nieblokujących, więc jeden wątek może
+ * obsługiwać tysiące sesji jednocześnie.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#ifndef GAMMA_SERVER_H
+#define GAMMA_SERVER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Uruchamia serwer.
+ * Tworzy gniazdo pod ścieżką @p path (usuwając istniejący plik gniazda)
+ * i obsługuje połączenia do czasu otrzymania sygnału @p SIGINT lub
+ * @p SIGTERM. Przed zakończeniem zamyka wszystkie sesje i usuwa plik
+ * gniazda.
+ * @param[in] path    – ścieżka gniazda,
+ * @param[in] workers – liczba wątków roboczych, wartość @p 0 oznacza
+ *                      liczbę dostępnych rdzeni.
+ * @return Wartość @p true, jeśli serwer zakończył działanie po otrzymaniu
+ * sygnału, @p false, jeśli nie udało się go uruchomić.
+ */
+bool server_run(const char *path, uint32_t workers);
+
+#endif //GAMMA_SERVER_H
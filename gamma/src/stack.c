@@ -14,8 +14,10 @@
 #define RESIZE_MULTIPLIER 2     /**< Współczynnik, o jaki zwiększany jest
                                  * maksymalny rozmiar stosu, gdy stos się zapełni.
                                  */
-#define EXIT_CODE_MALLOC_FAIL 1 /**< Kod wyjściowy programu,
-                                 * gdy nie uda się zaalokować potrzebnej pamięci.
+#define SHRINK_RATIO 4          /**< Stos jest zmniejszany, gdy jego maksymalny
+                                 * rozmiar jest co najmniej tyle razy większy
+                                 * od największej liczby elementów od
+                                 * poprzedniego zmniejszenia.
                                  */
 /** @brief Struktura reprezentująca stos przechowujący
  * dane typu @ref field. 
@@ -27,19 +29,33 @@ struct m_stack {
     uint64_t count; ///< Reprezentuje liczbę elementów na stosie.
     field_t *arr;   ///< Dynamiczna tablica przechowująca elementy na stosie.
     uint64_t size;  ///< Maksymalny rozmiar stosu.
+    uint64_t peak;  /**< Największa liczba elementów na stosie od ostatniego
+                     * wywołania @ref stack_shrink.
+                     */
+    const gamma_allocator_t *allocator; ///< Alokator stosu lub @p NULL.
+#ifdef GAMMA_STATS
+    uint64_t resizes; ///< Liczba powiększeń stosu.
+    uint64_t shrinks; ///< Liczba zmniejszeń stosu.
+#endif
 };
 
-stack_t *init_stack(uint64_t size) {
+stack_t *init_stack(const gamma_allocator_t *a, uint64_t size) {
     stack_t *s = NULL;
-    s = malloc(sizeof(stack_t));
+    s = mem_alloc(a, sizeof(stack_t));
     if (s == NULL)
         return s;
-    if (!init_array_1D((void **) &(s->arr), FIELD_SIZE, size)) {
-        free(s);
+    if (!init_array_1D(a, (void **) &(s->arr), FIELD_SIZE, size)) {
+        mem_free(a, s, sizeof(stack_t));
         return NULL;
     }
+    s->allocator = a;
     s->size = size;
     s->count = 0;
+    s->peak = 0;
+#ifdef GAMMA_STATS
+    s->resizes = 0;
+    s->shrinks = 0;
+#endif
     return s;
 }
 
@@ -61,30 +77,77 @@ bool is_stack_empty(stack_t *s) {
     return s->count == 0;
 }
 
+/** @brief Zmienia maksymalny rozmiar stosu.
+ * Dokonuje realokacji pamięci przechowywanej przez dynamiczną tablicę
+ * @p s->arr tak, by mieściła @p size elementów. Jeśli nie uda się tego
+ * dokonać (zabraknie pamięci lub zostałby przekroczony limit z
+ * @ref mem_set_limit), stos pozostaje bez zmian.
+ * @param[in,out] s – wskaźnik na strukturę reprezentującą stos,
+ *                    różny od @p NULL,
+ * @param[in] size  – nowy maksymalny rozmiar, niemniejszy od liczby
+ *                    elementów na stosie.
+ * @return Wartość @p true, jeśli udało się zmienić rozmiar stosu, @p false
+ * w przeciwnym przypadku.
+ */
+static bool set_size(stack_t *s, uint64_t size) {
+    field_t *arr = mem_realloc(s->allocator, s->arr, FIELD_SIZE * s->size, FIELD_SIZE * size);
+    if (arr == NULL)
+        return false;
+    s->arr = arr;
+    s->size = size;
+    return true;
+}
+
 /** @brief Zwiększa maksymalny rozmiar stosu.
- * Zwiększa maksymalny rozmiar stosu reprezentowanego
- * przez strukturę wskazywaną przez @p s.
- * Rezerwuje pamięć dla stosu o takim
- * maksymalnym rozmiarze (dokonuje realokacji pamięci
- * przechowywanej przez dynamiczną tablicę @p s->arr).
- * Jeśli nie uda się tego dokonać (zabraknie pamięci),
- * terminuje program z kodem @p 1.
- * @param[in] s  – wskaźnik na strukturę reprezentującą stos,
- *                 różny od @p NULL.
+ * Zwiększa maksymalny rozmiar stosu reprezentowanego przez strukturę
+ * wskazywaną przez @p s co najmniej do @p size, ale nie mniej niż
+ * @ref RESIZE_MULTIPLIER razy, żeby ciąg powiększeń kosztował łącznie
+ * tyle, co jedna alokacja. Jeśli nie uda się tego dokonać, stos
+ * pozostaje bez zmian.
+ * @param[in,out] s – wskaźnik na strukturę reprezentującą stos,
+ *                    różny od @p NULL,
+ * @param[in] size  – potrzebny maksymalny rozmiar stosu.
+ * @return Wartość @p true, jeśli udało się powiększyć stos, @p false
+ * w przeciwnym przypadku.
  */
-static void resize(stack_t *s) {
-    s->size = RESIZE_MULTIPLIER * s->size + 1;
-    s->arr = realloc(s->arr, FIELD_SIZE * s->size);
-    if (s->arr == NULL)
-        exit(EXIT_CODE_MALLOC_FAIL);
+static bool resize(stack_t *s, uint64_t size) {
+    uint64_t grown = RESIZE_MULTIPLIER * s->size + 1;
+    if (!set_size(s, size > grown ? size : grown))
+        return false;
+#ifdef GAMMA_STATS
+    s->resizes++;
+#endif
+    return true;
+}
+
+bool stack_reserve(stack_t *s, uint64_t size) {
+    return size <= s->size || resize(s, size);
 }
 
-void stack_push(stack_t *s, uint32_t x, uint32_t y) {
-    if (is_full(s))
-        resize(s);
+void stack_shrink(stack_t *s, uint64_t min_size) {
+    if (s->count > 0)
+        return;
+    uint64_t peak = s->peak;
+    s->peak = 0;
+    if (s->size <= min_size || SHRINK_RATIO * peak > s->size)
+        return;
+    uint64_t size = RESIZE_MULTIPLIER * peak;
+    if (set_size(s, size > min_size ? size : min_size)) {
+#ifdef GAMMA_STATS
+        s->shrinks++;
+#endif
+    }
+}
+
+bool stack_push(stack_t *s, uint32_t x, uint32_t y) {
+    if (is_full(s) && !resize(s, s->size + 1))
+        return false;
     s->arr[s->count].x = x;
     s->arr[s->count].y = y;
     s->count++;
+    if (s->count > s->peak)
+        s->peak = s->count;
+    return true;
 }
 
 field_t stack_pop(stack_t *s) {
@@ -92,9 +155,24 @@ field_t stack_pop(stack_t *s) {
     return s->arr[s->count];
 }
 
+#ifdef GAMMA_STATS
+uint64_t stack_resizes(stack_t *s) {
+    return s->resizes;
+}
+
+uint64_t stack_shrinks(stack_t *s) {
+    return s->shrinks;
+}
+#endif
+
+uint64_t stack_memory(stack_t *s) {
+    return sizeof(stack_t) + FIELD_SIZE * s->size;
+}
+
 void stack_destruct(stack_t *s) {
     if (s == NULL)
         return;
-    free(s->arr);
-    free(s);
+    const gamma_allocator_t *a = s->allocator;
+    mem_free(a, s->arr, FIELD_SIZE * s->size);
+    mem_free(a, s, sizeof(stack_t));
 }
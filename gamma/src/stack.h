@@ -12,6 +12,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "field.h"
+#include "gamma_allocator.h"
 
 /** @brief Struktura reprezentująca stos przechowujący
  * dane typu @ref field. 
@@ -26,11 +27,13 @@ typedef struct m_stack stack_t;
  * zdolnej przechować @p size elementów typu @ref field). Zwraca
  * wskaźnik na strukturę reprezentującą ten stos, lub wartość @p
  * NULL, jeśli nie udało się zaalokować potrzebnej pamieci.
+ * Stos i jego powiększenia są alokowane alokatorem @p a.
+ * @param[in] a    – alokator lub @p NULL; musi istnieć do usunięcia stosu,
  * @param[in] size – początkowy maksymalny rozmiar stosu.
  * @return Wskaźnik na strukturę reprezentującą stos, lub
  * @p NULL, jeśli nie uda się zaalokować potrzebnej pamieci.
  */
-stack_t *init_stack(uint64_t size);
+stack_t *init_stack(const gamma_allocator_t *a, uint64_t size);
 
 /** @brief Sprawdza, czy stos jest pusty.
  * Sprawdza czy stos reprezentowany przez strukturę wskazywaną przez
@@ -48,14 +51,41 @@ bool is_stack_empty(stack_t *s);
  * ilość elementów na stosie byłaby większa od jego maksymalnego
  * rozmiaru, zwiększa jego maksymalny rozmiar.
  * Jeśli nie jest to możliwe (nie uda się zaalokować pamięci),
- * terminuje program z kodem @p 1.
+ * stos pozostaje bez zmian.
  * @param[in,out] s – wskaźnik na strukturę reprezentującą stos,
  *                    różny od @p NULL,
  * @param[in] x     – numer kolumny,
  * @param[in] y     – numer wiersza.
+ * @return Wartość @p true, jeśli element został dodany, @p false, jeśli nie
+ * udało się powiększyć stosu.
  */
+bool stack_push(stack_t *s, uint32_t x, uint32_t y);
 
-void stack_push(stack_t *s, uint32_t x, uint32_t y);
+/** @brief Zapewnia miejsce na elementy stosu.
+ * Powiększa stos reprezentowany przez strukturę wskazywaną przez @p s
+ * tak, by jego maksymalny rozmiar wynosił co najmniej @p size. Dopóki
+ * liczba elementów nie przekroczy @p size, @ref stack_push zawsze się
+ * udaje. Jeśli nie uda się zaalokować pamięci, stos
+ * pozostaje bez zmian.
+ * @param[in,out] s – wskaźnik na strukturę reprezentującą stos,
+ *                    różny od @p NULL,
+ * @param[in] size  – potrzebny maksymalny rozmiar stosu.
+ * @return Wartość @p true, jeśli maksymalny rozmiar stosu wynosi co
+ * najmniej @p size, @p false, jeśli nie udało się powiększyć stosu.
+ */
+bool stack_reserve(stack_t *s, uint64_t size);
+
+/** @brief Zmniejsza stos po chwilowym wzroście.
+ * Jeśli stos reprezentowany przez strukturę wskazywaną przez @p s jest
+ * pusty, a jego maksymalny rozmiar jest wielokrotnie większy od
+ * największej liczby elementów od poprzedniego wywołania tej funkcji,
+ * zmniejsza go do dwukrotności tej liczby, ale nie poniżej @p min_size.
+ * Jeśli realokacja się nie uda, stos pozostaje bez zmian.
+ * @param[in,out] s    – wskaźnik na strukturę reprezentującą stos,
+ *                       różny od @p NULL,
+ * @param[in] min_size – najmniejszy maksymalny rozmiar stosu.
+ */
+void stack_shrink(stack_t *s, uint64_t min_size);
 
 /** @brief Usuwa i zwraca pierwszy element ze stosu.
  * Zdejmuje i zwraca pierwszy element na niepustym stosie
@@ -68,6 +98,13 @@ void stack_push(stack_t *s, uint32_t x, uint32_t y);
  */
 field_t stack_pop(stack_t *s);
 
+/** @brief Zwraca liczbę bajtów zajmowanych przez stos.
+ * @param[in] s – wskaźnik na strukturę reprezentującą stos,
+ *                różny od @p NULL.
+ * @return Liczba bajtów zajmowanych przez strukturę stosu i jego tablicę.
+ */
+uint64_t stack_memory(stack_t *s);
+
 /** Zwalnia pamięć zarezerwowaną dla stosu.
  * Zwalnia pamięć zarezerwowaną dla struktury wskazywanej
  * przez @p s. Jeżeli @p s jest równe @p NULL, funkcja nic nie robi.
@@ -75,4 +112,23 @@ field_t stack_pop(stack_t *s);
  */
 void stack_destruct(stack_t *s);
 
+#ifdef GAMMA_STATS
+/** @brief Zwraca liczbę powiększeń stosu.
+ * Dostępna tylko, gdy zdefiniowano makro @p GAMMA_STATS.
+ * @param[in] s – wskaźnik na strukturę reprezentującą stos,
+ *                różny od @p NULL.
+ * @return Liczba powiększeń stosu od jego utworzenia.
+ */
+uint64_t stack_resizes(stack_t *s);
+
+/** @brief Zwraca liczbę zmniejszeń stosu.
+ * Dostępna tylko, gdy zdefiniowano makro @p GAMMA_STATS.
+ * @param[in] s – wskaźnik na strukturę reprezentującą stos,
+ *                różny od @p NULL.
+ * @return Liczba zmniejszeń stosu przez @ref stack_shrink od jego
+ * utworzenia.
+ */
+uint64_t stack_shrinks(stack_t *s);
+#endif
+
 #endif //GAMMA_STACK_H
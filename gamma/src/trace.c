@@ -0,0 +1,221 @@
+/** @file
+ * Zawiera implementację interfejsu trace.h
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#define _GNU_SOURCE ///< Makro potrzebne do prawidłowej kompilacji.
+
+#include "trace.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @brief Struktura przechowująca jeden przedział.
+ * Pola odczytywane są przez @ref trace_dump w trakcie zapisu kolejnych
+ * przedziałów, dlatego są atomowe, a numer @p seq pozwala wykryć odczyt
+ * pozycji nadpisywanej w tym samym czasie.
+ */
+typedef struct trace_event {
+    _Atomic uint64_t seq;          /**< Równy @p 2i+1 w trakcie zapisu
+                                    * przedziału numer @p i i @p 2i+2
+                                    * po jego zakończeniu.
+                                    */
+    _Atomic(const char *) name;    ///< Nazwa przedziału.
+    _Atomic uint64_t start;        ///< Początek w jednostkach zegara śledzenia.
+    _Atomic uint64_t end;          ///< Koniec w jednostkach zegara śledzenia.
+    _Atomic uint64_t arg;          ///< Liczba opisująca przedział.
+} trace_event_t;
+
+/**
+ * @brief Struktura przechowująca cykliczny bufor przedziałów jednego wątku.
+ */
+typedef struct trace_buffer {
+    struct trace_buffer *next; ///< Bufor następnego wątku na liście.
+    uint32_t tid;              ///< Numer wątku w śladzie.
+    _Atomic uint64_t count;    /**< Liczba przedziałów zapisanych od
+                                * początku; przedział numer @p i leży na
+                                * pozycji @p i modulo @ref TRACE_BUFFER_SIZE.
+                                */
+    trace_event_t events[];    ///< Przedziały.
+} trace_buffer_t;
+
+/**
+ * @brief Lista buforów wszystkich wątków.
+ */
+static _Atomic(trace_buffer_t *) buffers = NULL;
+
+/**
+ * @brief Liczba utworzonych buforów, służy do numerowania wątków.
+ */
+static _Atomic uint32_t threads = 0;
+
+/**
+ * @brief Czas zegara śledzenia i czas zegara @p CLOCK_MONOTONIC
+ * w nanosekundach zapisane przy utworzeniu pierwszego bufora (lub przy
+ * pierwszym zapisie do pliku); służą do przeliczania czasu zegara
+ * śledzenia na mikrosekundy.
+ */
+static uint64_t base_ticks, base_ns;
+
+/**
+ * @brief Zapewnia, że @p base_ticks i @p base_ns zostaną zapisane raz,
+ * zanim którykolwiek wątek je odczyta.
+ */
+static pthread_once_t base_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Bufor bieżącego wątku lub @p NULL, jeśli jeszcze nie powstał.
+ */
+static _Thread_local trace_buffer_t *local = NULL;
+
+/**
+ * @brief Odczytuje czas zegara @p CLOCK_MONOTONIC.
+ * @return Czas w nanosekundach.
+ */
+static uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+}
+
+/**
+ * @brief Zapisuje czasy, od których liczony jest czas w śladzie.
+ */
+static void set_base() {
+    base_ticks = trace_now();
+    base_ns = now_ns();
+}
+
+bool trace_enabled() {
+#ifdef GAMMA_TRACE
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint64_t trace_now() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return now_ns();
+#endif
+}
+
+/**
+ * @brief Tworzy bufor bieżącego wątku i dołącza go do listy buforów.
+ * @return Wskaźnik na bufor lub @p NULL, jeśli nie udało się zaalokować
+ * pamięci.
+ */
+static trace_buffer_t *buffer_new() {
+    trace_buffer_t *b = malloc(sizeof(trace_buffer_t)
+                               + TRACE_BUFFER_SIZE * sizeof(trace_event_t));
+    if (b == NULL)
+        return NULL;
+    pthread_once(&base_once, set_base);
+    b->tid = atomic_fetch_add(&threads, 1) + 1;
+    atomic_init(&b->count, 0);
+    for (uint32_t i = 0; i < TRACE_BUFFER_SIZE; i++)
+        atomic_init(&b->events[i].seq, 0);
+    b->next = atomic_load(&buffers);
+    while (!atomic_compare_exchange_weak(&buffers, &b->next, b))
+        ;
+    return b;
+}
+
+void trace_span(const char *name, uint64_t start, uint64_t arg) {
+    uint64_t end = trace_now();
+    if (local == NULL && (local = buffer_new()) == NULL)
+        return;
+    uint64_t i = atomic_load_explicit(&local->count, memory_order_relaxed);
+    trace_event_t *e = &local->events[i % TRACE_BUFFER_SIZE];
+    atomic_store_explicit(&e->seq, 2 * i + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&e->name, name, memory_order_relaxed);
+    atomic_store_explicit(&e->start, start, memory_order_relaxed);
+    atomic_store_explicit(&e->end, end, memory_order_relaxed);
+    atomic_store_explicit(&e->arg, arg, memory_order_relaxed);
+    atomic_store_explicit(&e->seq, 2 * i + 2, memory_order_release);
+    atomic_store_explicit(&local->count, i + 1, memory_order_release);
+}
+
+/**
+ * @brief Kopiuje przedział z bufora, jeśli w trakcie kopiowania nie został
+ * nadpisany.
+ * @param[in] e      – pozycja bufora,
+ * @param[in] i      – numer przedziału, który powinien leżeć na pozycji
+ *                     @p e,
+ * @param[out] name  – nazwa przedziału,
+ * @param[out] start – początek przedziału,
+ * @param[out] end   – koniec przedziału,
+ * @param[out] arg   – liczba opisująca przedział.
+ * @return Wartość @p true, jeśli skopiowano przedział numer @p i, @p false,
+ * jeśli pozycja była w tym czasie zapisywana lub zawiera już inny
+ * przedział.
+ */
+static bool event_read(trace_event_t *e, uint64_t i, const char **name,
+                       uint64_t *start, uint64_t *end, uint64_t *arg) {
+    uint64_t seq = atomic_load_explicit(&e->seq, memory_order_acquire);
+    if (seq != 2 * i + 2)
+        return false;
+    *name = atomic_load_explicit(&e->name, memory_order_relaxed);
+    *start = atomic_load_explicit(&e->start, memory_order_relaxed);
+    *end = atomic_load_explicit(&e->end, memory_order_relaxed);
+    *arg = atomic_load_explicit(&e->arg, memory_order_relaxed);
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&e->seq, memory_order_relaxed) == seq;
+}
+
+bool trace_dump(const char *path) {
+    FILE *f = fopen(path, "w");
+    if (f == NULL)
+        return false;
+    pthread_once(&base_once, set_base);
+    uint64_t ticks = trace_now() - base_ticks;
+    double us_per_tick = ticks > 0 ? (now_ns() - base_ns) / 1000.0 / ticks : 0;
+    int pid = getpid();
+    bool first = true;
+    fprintf(f, "{\"traceEvents\":[");
+    for (trace_buffer_t *b = atomic_load(&buffers); b != NULL; b = b->next) {
+        uint64_t count = atomic_load_explicit(&b->count, memory_order_acquire);
+        uint64_t i = count > TRACE_BUFFER_SIZE ? count - TRACE_BUFFER_SIZE : 0;
+        for (; i < count; i++) {
+            const char *name;
+            uint64_t start, end, arg;
+            if (!event_read(&b->events[i % TRACE_BUFFER_SIZE], i, &name,
+                            &start, &end, &arg))
+                continue;
+            fprintf(f, "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,"
+                       "\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,"
+                       "\"args\":{\"arg\":%lu}}",
+                    first ? "" : ",", name, pid, b->tid,
+                    ((double) start - base_ticks) * us_per_tick,
+                    (double) (end - start) * us_per_tick, arg);
+            first = false;
+        }
+    }
+    fprintf(f, "\n],\"displayTimeUnit\":\"ns\"}\n");
+    bool ok = !ferror(f);
+    return fclose(f) == 0 && ok;
+}
+
+void trace_free() {
+    trace_buffer_t *b = atomic_exchange(&buffers, NULL);
+    while (b != NULL) {
+        trace_buffer_t *next = b->next;
+        free(b);
+        b = next;
+    }
+    atomic_store(&threads, 0);
+    local = NULL;
+}
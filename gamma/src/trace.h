@@ -0,0 +1,89 @@
+/** @file
+ * Interfejs śledzenia przedziałów czasu wykonania wybranych fragmentów
+ * programu.
+ *
+ * Przedział (nazwa, początek, koniec i jedna liczba opisująca go, np. numer
+ * wiersza polecenia) zapisywany jest w cyklicznym buforze wątku, który go
+ * zmierzył; bufor przechowuje @ref TRACE_BUFFER_SIZE ostatnich przedziałów.
+ * Zapis nie wymaga blokad, a czas odczytywany jest z licznika @p TSC
+ * procesora (na innych architekturach z zegara @p CLOCK_MONOTONIC).
+ * Zebrane przedziały wszystkich wątków można zapisać w formacie JSON
+ * przeglądarek śladów Chrome (@p chrome://tracing) i Perfetto.
+ *
+ * Makra @ref TRACE_BEGIN i @ref TRACE_END mierzą przedziały tylko
+ * w programie skompilowanym z makrem @p GAMMA_TRACE, w przeciwnym przypadku
+ * nic nie robią.
+ *
+ * @author Mateusz Nowakowski <mn418323@mimuw.edu.pl>
+ * @copyright Uniwersytet Warszawski
+ * @date 18.10.2026
+ */
+
+#ifndef GAMMA_TRACE_H
+#define GAMMA_TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TRACE_BUFFER_SIZE (1u << 17) ///< Liczba przedziałów w buforze wątku.
+
+#ifdef GAMMA_TRACE
+/** @brief Rozpoczyna przedział, zapisując jego początek w zmiennej @p span.
+ * Bez makra @p GAMMA_TRACE nie robi nic.
+ */
+#define TRACE_BEGIN(span) uint64_t span = trace_now()
+/** @brief Kończy przedział rozpoczęty przez @ref TRACE_BEGIN i zapisuje go
+ * w buforze wątku pod nazwą @p name (stałym napisem) z liczbą @p arg.
+ * Bez makra @p GAMMA_TRACE nie robi nic.
+ */
+#define TRACE_END(span, name, arg) trace_span((name), span, (arg))
+#else
+#define TRACE_BEGIN(span) ((void) 0) ///< Pusta wersja makra rozpoczynającego przedział.
+#define TRACE_END(span, name, arg) ((void) 0) ///< Pusta wersja makra kończącego przedział.
+#endif
+
+/**
+ * @brief Sprawdza, czy program mierzy przedziały.
+ * @return Wartość @p true, jeśli program skompilowano z makrem
+ * @p GAMMA_TRACE, @p false w przeciwnym przypadku.
+ */
+bool trace_enabled();
+
+/**
+ * @brief Odczytuje bieżący czas w jednostkach zegara śledzenia.
+ * @return Bieżący czas.
+ */
+uint64_t trace_now();
+
+/**
+ * @brief Zapisuje przedział w buforze bieżącego wątku.
+ * Koniec przedziału to bieżący czas. Jeśli bufor jest pełny, nadpisywany
+ * jest najstarszy przedział. Jeśli nie udało się zaalokować bufora,
+ * przedział jest pomijany.
+ * @param[in] name  – nazwa przedziału, napis istniejący do końca programu,
+ * @param[in] start – początek przedziału, wynik @ref trace_now,
+ * @param[in] arg   – liczba opisująca przedział.
+ */
+void trace_span(const char *name, uint64_t start, uint64_t arg);
+
+/**
+ * @brief Zapisuje przedziały ze wszystkich buforów do pliku JSON w formacie
+ * śladów Chrome.
+ * Może zostać wywołana, gdy inne wątki wciąż zapisują przedziały: każdy
+ * przedział jest kopiowany z bufora i pomijany, jeśli w trakcie kopiowania
+ * został nadpisany, więc plik nie zawiera rozerwanych przedziałów.
+ * Przedziały zapisywane w trakcie zapisu do pliku mogą zostać pominięte.
+ * @param[in] path – ścieżka do pliku, który zostanie nadpisany.
+ * @return Wartość @p true, jeśli udało się zapisać plik, @p false
+ * w przeciwnym przypadku (wtedy @p errno opisuje błąd).
+ */
+bool trace_dump(const char *path);
+
+/**
+ * @brief Zwalnia bufory wszystkich wątków.
+ * Może zostać wywołana tylko wtedy, gdy żaden wątek nie zapisuje już
+ * przedziałów.
+ */
+void trace_free();
+
+#endif //GAMMA_TRACE_H